@@ -13,16 +13,40 @@
 #define USE_ESP32_WITH_ESP_IDF
 
 
+/**
+ * Bus statistics:
+ * --------------
+ * Uncomment to count resets, clocked bytes and bits, presence and CRC failures,
+ * bus busy time and time spent in critical sections. They are read with
+ * One_wire_temp_sensor::get_bus_stats(). When commented there is no overhead.
+ * 
+ * **/
 
+// #define USE_ONE_WIRE_BUS_STATS
 
 
+/**
+ * Bus trace:
+ * ---------
+ * Uncomment to let One_wire_temp_sensor::set_trace() record every reset, byte and bit
+ * on the bus, with its timestamp, in a One_wire_trace. Play it back on the host with
+ * Replay_transport. When commented there is no overhead.
+ * 
+ * **/
 
+// #define USE_ONE_WIRE_TRACE
 
 
+/**
+ * Both backends:
+ * -------------
+ * Only with the Arduino framework, which is built over ESP-IDF. Uncomment to build the
+ * ESP-IDF backend too, so Arduino_one_wire_temp_sensor and Esp_idf_one_wire_temp_sensor can
+ * be instanced in one program, e.g. to benchmark them. One_wire_temp_sensor stays the Arduino one.
+ * 
+ * **/
 
-
-
-
+// #define USE_BOTH_BACKENDS
 
 
 
@@ -90,9 +114,20 @@
 /**DO NOT CHANGE THIS *******/
 #if defined(USE_ESP32_WITH_ARDUINO)
     #define ESP32_WITH_ARDUINO
+    #if defined(USE_BOTH_BACKENDS)
+        #define ESP32_WITH_ESP_IDF
+    #endif
 #elif defined(USE_ESP32_WITH_ESP_IDF)
     #define ESP32_WITH_ESP_IDF
 #endif
+
+#if defined(USE_ONE_WIRE_BUS_STATS)
+    #define ONE_WIRE_BUS_STATS
+#endif
+
+#if defined(USE_ONE_WIRE_TRACE)
+    #define ONE_WIRE_TRACE
+#endif
 /**DO NOT CHANGE THIS *******/
 /////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////
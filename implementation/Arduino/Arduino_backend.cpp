@@ -0,0 +1,19 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ARDUINO) || defined(IS_RUNNING_TESTS)
+
+#include "Arduino_backend.h"
+#if defined(IS_RUNNING_TESTS)
+    #include <mocks/Arduino_driver/Arduino.h>
+#else
+    #include <Arduino.h>
+#endif
+
+uint32_t Arduino_clock::get_micros() {
+    return micros();
+}
+
+void Arduino_clock::delay_ms(uint32_t millis) {
+    delay(millis);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include "../common/Transport_backend.h"
+#include "Arduino_gpio_transport.h"
+#include <stdint.h>
+
+// Time of the Arduino core, for Transport_backend
+struct Arduino_clock {
+    static uint32_t get_micros();
+    static void delay_ms(uint32_t millis);
+};
+
+// The transport is a base declared before Transport_backend, so it is built before the backend uses it
+struct Arduino_gpio_bus {
+    explicit Arduino_gpio_bus(uint8_t pin) : gpio_transport(pin) {
+    }
+
+    Arduino_gpio_transport gpio_transport;
+};
+
+// Backend of Basic_one_wire_temp_sensor over the OneWire library on a GPIO. The library is a member,
+// so an instance costs no heap allocation and can live in static memory
+class Arduino_backend : private Arduino_gpio_bus, public Transport_backend<Arduino_gpio_transport, Arduino_clock> {
+public:
+    typedef uint8_t Bus;
+
+    explicit Arduino_backend(uint8_t pin, Bus_snapshot_store* snapshot_store = nullptr)
+        : Arduino_gpio_bus(pin), Transport_backend(gpio_transport, snapshot_store) {
+    }
+
+    Arduino_backend(uint8_t pin, const Known_bus& known_bus)
+        : Arduino_gpio_bus(pin), Transport_backend(gpio_transport, known_bus) {
+    }
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ARDUINO) || defined(IS_RUNNING_TESTS)
+
+#include "../common/One_wire_transport.h"
+#if defined(ONE_WIRE_BUS_STATS)
+    #include "../common/One_wire_bus_stats.h"
+#endif
+#if defined(ONE_WIRE_TRACE)
+    #include "../common/One_wire_trace.h"
+#endif
+#if defined(IS_RUNNING_TESTS)
+    #include <mocks/Arduino_driver/OneWire.h>
+#else
+    #include "driver/OneWire.h"
+#endif
+
+/**
+ * Bit-banged 1-Wire on a GPIO, through the vendored OneWire library. The
+ * library is a member, so the transport costs no heap allocation and can
+ * live in static memory. Every bus has its own slot timing, stats and trace.
+ **/
+class Arduino_gpio_transport : public One_wire_transport<Arduino_gpio_transport> {
+public:
+    explicit Arduino_gpio_transport(uint8_t pin) : one_wire(pin) {
+    }
+
+    bool reset() {
+        return one_wire.reset() == 1;
+    }
+
+    bool write_bytes(const uint8_t* bytes, size_t count) {
+        one_wire.write_bytes(bytes, count);
+        return true;
+    }
+
+    bool read_bytes(uint8_t* bytes, size_t count) {
+        one_wire.read_bytes(bytes, count);
+        return true;
+    }
+
+    bool write_bit(bool bit) {
+        one_wire.write_bit(bit);
+        return true;
+    }
+
+    bool read_bit(bool* bit) {
+        *bit = one_wire.read_bit() != 0;
+        return true;
+    }
+
+    bool strong_pullup(bool enable) {
+        if (enable)
+            one_wire.power();
+        else
+            one_wire.depower();
+        return true;
+    }
+
+    // The library leaves the bus driven high after the last slot of the byte
+    bool write_byte_and_strong_pullup(uint8_t byte) {
+        one_wire.write(byte, 1);
+        return true;
+    }
+
+    bool measure_bus(One_wire_bus_measurement* measurement) {
+        return one_wire.measure_bus(measurement);
+    }
+
+    One_wire_slot_timing get_slot_timing() {
+        return one_wire.get_timing();
+    }
+
+    One_wire_slot_timing get_slow_slot_timing() {
+        return OneWire::SLOW_TIMING;
+    }
+
+    void set_slot_timing(const One_wire_slot_timing& timing) {
+        one_wire.set_timing(timing);
+    }
+
+#if defined(ONE_WIRE_BUS_STATS)
+    void count_crc_failure() {
+        one_wire.count_crc_failure();
+    }
+
+    One_wire_bus_stats get_bus_stats() {
+        One_wire_bus_stats stats;
+        one_wire.get_stats(&stats);
+        return stats;
+    }
+
+    void clear_bus_stats() {
+        one_wire.clear_stats();
+    }
+#endif
+
+#if defined(ONE_WIRE_TRACE)
+    void set_trace(One_wire_trace* trace) {
+        one_wire.set_trace_hook(trace != nullptr ? One_wire_trace::record_to : nullptr, trace);
+    }
+#endif
+
+private:
+    OneWire one_wire;
+};
+
+#endif
\ No newline at end of file
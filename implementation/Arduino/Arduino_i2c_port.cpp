@@ -0,0 +1,24 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ARDUINO) && !defined(IS_RUNNING_TESTS)
+
+#include "Arduino_i2c_port.h"
+
+Arduino_i2c_port::Arduino_i2c_port(TwoWire& wire, uint8_t device_address)
+    : wire(wire), device_address(device_address) {
+}
+
+bool Arduino_i2c_port::write(const uint8_t* bytes, size_t length) {
+    wire.beginTransmission(device_address);
+    wire.write(bytes, length);
+    return wire.endTransmission() == 0;
+}
+
+bool Arduino_i2c_port::read(uint8_t* bytes, size_t length) {
+    if (wire.requestFrom(device_address, (uint8_t)length) != length)
+        return false;
+    for (size_t i = 0; i < length; ++i)
+        bytes[i] = wire.read();
+    return true;
+}
+
+#endif
\ No newline at end of file
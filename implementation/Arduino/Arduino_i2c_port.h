@@ -0,0 +1,24 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ARDUINO) && !defined(IS_RUNNING_TESTS)
+
+#include "../common/Ds2482_transport.h"
+#include <Wire.h>
+
+/**
+ * I2C master driven through an Arduino TwoWire, talking to one bridge address.
+ * Wire.begin() must already have been called.
+ **/
+class Arduino_i2c_port : public I2c_port {
+public:
+    Arduino_i2c_port(TwoWire& wire, uint8_t device_address);
+
+    bool write(const uint8_t* bytes, size_t length) override;
+    bool read(uint8_t* bytes, size_t length) override;
+
+private:
+    TwoWire& wire;
+    uint8_t device_address;
+};
+
+#endif
\ No newline at end of file
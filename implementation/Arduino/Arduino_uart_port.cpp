@@ -0,0 +1,32 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ARDUINO) && !defined(IS_RUNNING_TESTS)
+
+#include "Arduino_uart_port.h"
+#include <driver/gpio.h>
+
+#define ECHO_TIMEOUT_MS 20
+
+Arduino_uart_port::Arduino_uart_port(HardwareSerial& serial, int8_t tx_pin, int8_t rx_pin) : serial(serial) {
+    serial.begin(UART_TRANSPORT_DATA_BAUD_RATE, SERIAL_8N1, rx_pin, tx_pin);
+    // After begin(), which routes the UART to the pins and leaves TX push-pull
+    gpio_set_direction((gpio_num_t)tx_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    serial.setTimeout(ECHO_TIMEOUT_MS);
+}
+
+Arduino_uart_port::~Arduino_uart_port() {
+    serial.end();
+}
+
+void Arduino_uart_port::set_baud_rate(uint32_t baud_rate) {
+    serial.flush();
+    serial.updateBaudRate(baud_rate);
+}
+
+bool Arduino_uart_port::transfer(const uint8_t* to_write, uint8_t* echo, size_t length) {
+    while (serial.available() > 0)
+        serial.read();
+    serial.write(to_write, length);
+    return serial.readBytes(echo, length) == length;
+}
+
+#endif
\ No newline at end of file
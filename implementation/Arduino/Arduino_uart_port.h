@@ -0,0 +1,24 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ARDUINO) && !defined(IS_RUNNING_TESTS)
+
+#include "../common/Uart_transport.h"
+#include <HardwareSerial.h>
+
+/**
+ * UART driven through an ESP32 Arduino HardwareSerial. TX is set to open drain,
+ * it can be routed to the same GPIO as RX or to the bus through an external buffer.
+ **/
+class Arduino_uart_port : public Uart_port {
+public:
+    Arduino_uart_port(HardwareSerial& serial, int8_t tx_pin, int8_t rx_pin);
+    ~Arduino_uart_port();
+
+    void set_baud_rate(uint32_t baud_rate) override;
+    bool transfer(const uint8_t* to_write, uint8_t* echo, size_t length) override;
+
+private:
+    HardwareSerial& serial;
+};
+
+#endif
\ No newline at end of file
@@ -145,6 +145,52 @@ sample code bearing this copyright.
 #include <Arduino.h>
 #include "util/OneWire_direct_gpio.h"
 
+#if defined(ONE_WIRE_BUS_STATS)
+#define STATS_ADD(counter, value) (stats.counter += (value))
+#define ENTER_CRITICAL() do { noInterrupts(); critical_section_start_us = micros(); } while (0)
+#define EXIT_CRITICAL() do { count_critical_section(micros() - critical_section_start_us); interrupts(); } while (0)
+#define STATS_BUS_BUSY_BEGIN uint32_t bus_busy_start_us = micros()
+#define STATS_BUS_BUSY_END STATS_ADD(bus_busy_us, micros() - bus_busy_start_us)
+#else
+#define STATS_ADD(counter, value) do {} while (0)
+#define ENTER_CRITICAL() noInterrupts()
+#define EXIT_CRITICAL() interrupts()
+#define STATS_BUS_BUSY_BEGIN
+#define STATS_BUS_BUSY_END do {} while (0)
+#endif
+
+#if defined(ONE_WIRE_TRACE)
+#define TRACE(event, flags, data) do { if (trace_hook) trace_hook(trace_context, (event), (flags), (data)); } while (0)
+#else
+#define TRACE(event, flags, data) do {} while (0)
+#endif
+#define TRACE_FLAGS(value) ((value) ? ONE_WIRE_TRACE_VALUE : 0)
+
+// The slots of the original driver: a write 1 takes 65uS, a write 0 70uS
+// and a read 66uS, recovery included
+const One_wire_slot_timing OneWire::STANDARD_TIMING = {
+	480, 70, 410,	// reset low, presence sample, reset recovery
+	10, 65, 60,	// write 1 low, write 0 low, write slot
+	3, 10, 61,	// read low, read sample, read slot
+	5,		// recovery
+};
+
+const One_wire_slot_timing OneWire::SLOW_TIMING = {
+	480, 70, 410,
+	10, 65, 60,
+	3, 10, 61,
+	30,
+};
+
+void OneWire::set_timing(const One_wire_slot_timing &new_timing)
+{
+	timing = new_timing;
+}
+
+const One_wire_slot_timing &OneWire::get_timing() const
+{
+	return timing;
+}
 
 void OneWire::begin(uint8_t pin)
 {
@@ -170,26 +216,115 @@ uint8_t OneWire::reset(void)
 	uint8_t r;
 	uint8_t retries = 125;
 
-	noInterrupts();
+	STATS_ADD(resets, 1);
+	STATS_BUS_BUSY_BEGIN;
+	ENTER_CRITICAL();
 	DIRECT_MODE_INPUT(reg, mask);
-	interrupts();
+	EXIT_CRITICAL();
 	// wait until the wire is high... just in case
 	do {
-		if (--retries == 0) return 0;
+		if (--retries == 0) {
+			STATS_ADD(presence_failures, 1);
+			TRACE(ONE_WIRE_TRACE_RESET, ONE_WIRE_TRACE_FAILED, 0);
+			return 0;
+		}
 		delayMicroseconds(2);
 	} while ( !DIRECT_READ(reg, mask));
 
-	noInterrupts();
+	ENTER_CRITICAL();
 	DIRECT_WRITE_LOW(reg, mask);
 	DIRECT_MODE_OUTPUT(reg, mask);	// drive output low
-	interrupts();
-	delayMicroseconds(480);
-	noInterrupts();
+	EXIT_CRITICAL();
+	delayMicroseconds(timing.reset_low_us);
+	ENTER_CRITICAL();
 	DIRECT_MODE_INPUT(reg, mask);	// allow it to float
-	delayMicroseconds(70);
+	delayMicroseconds(timing.presence_sample_us);
 	r = !DIRECT_READ(reg, mask);
-	interrupts();
-	delayMicroseconds(410);
+	EXIT_CRITICAL();
+	delayMicroseconds(timing.reset_recovery_us);
+	STATS_BUS_BUSY_END;
+	if (!r) STATS_ADD(presence_failures, 1);
+	TRACE(ONE_WIRE_TRACE_RESET, TRACE_FLAGS(r), 0);
+	return r;
+}
+
+//
+// Poll the bus every microsecond until it reads 'level', for up to max_us
+// polls. Returns the polls. The time of each read is not counted, so the
+// result falls short of the real time, see SLOT_TIMING_MARGIN_US.
+//
+static uint16_t count_until(IO_REG_TYPE mask, __attribute__((unused)) volatile IO_REG_TYPE *reg, uint8_t level, uint16_t max_us)
+{
+	uint16_t elapsed_us = 0;
+	while ((DIRECT_READ(reg, mask) ? 1 : 0) != level && elapsed_us < max_us) {
+		delayMicroseconds(1);
+		elapsed_us++;
+	}
+	return elapsed_us;
+}
+
+//
+// Measure the rise time after a write 1 slot and the presence pulse of a
+// reset. The bus is polled with interrupts off from the release of the reset
+// pulse to the end of the presence pulse, up to 480uS.
+//
+bool OneWire::measure_bus(One_wire_bus_measurement *measurement)
+{
+	IO_REG_TYPE mask IO_REG_MASK_ATTR = bitmask;
+	__attribute__((unused)) volatile IO_REG_TYPE *reg IO_REG_BASE_ATTR = baseReg;
+	uint8_t retries = 125;
+
+	STATS_ADD(resets, 1);
+	STATS_BUS_BUSY_BEGIN;
+	ENTER_CRITICAL();
+	DIRECT_MODE_INPUT(reg, mask);
+	EXIT_CRITICAL();
+	do {
+		if (--retries == 0) {
+			STATS_ADD(presence_failures, 1);
+			return false;
+		}
+		delayMicroseconds(2);
+	} while ( !DIRECT_READ(reg, mask));
+
+	ENTER_CRITICAL();
+	DIRECT_WRITE_LOW(reg, mask);
+	DIRECT_MODE_OUTPUT(reg, mask);
+	delayMicroseconds(timing.write_1_low_us);
+	DIRECT_MODE_INPUT(reg, mask);
+	measurement->rise_us = count_until(mask, reg, 1, timing.write_slot_us);
+	EXIT_CRITICAL();
+	delayMicroseconds(timing.write_slot_us);
+
+	uint16_t reset_release_us = timing.presence_sample_us + timing.reset_recovery_us;
+	ENTER_CRITICAL();
+	DIRECT_WRITE_LOW(reg, mask);
+	DIRECT_MODE_OUTPUT(reg, mask);	// drive output low
+	EXIT_CRITICAL();
+	delayMicroseconds(timing.reset_low_us);
+	ENTER_CRITICAL();
+	DIRECT_MODE_INPUT(reg, mask);	// allow it to float
+	measurement->presence_delay_us = count_until(mask, reg, 0, reset_release_us);
+	measurement->presence_low_us = count_until(mask, reg, 1, reset_release_us - measurement->presence_delay_us);
+	EXIT_CRITICAL();
+	delayMicroseconds(reset_release_us - measurement->presence_delay_us - measurement->presence_low_us);
+	STATS_BUS_BUSY_END;
+
+	bool r = measurement->presence_low_us != 0 && DIRECT_READ(reg, mask);
+	if (!r) STATS_ADD(presence_failures, 1);
+	return r;
+}
+
+void OneWire::write_bit(uint8_t v)
+{
+	write_slot(v);
+	TRACE(ONE_WIRE_TRACE_WRITE_BIT, TRACE_FLAGS(v & 1), 0);
+}
+
+uint8_t OneWire::read_bit(void)
+{
+	uint8_t r = read_slot();
+	TRACE(ONE_WIRE_TRACE_READ_BIT, TRACE_FLAGS(r), 0);
 	return r;
 }
 
@@ -197,49 +332,56 @@ uint8_t OneWire::reset(void)
 // Write a bit. Port and bit is used to cut lookup time and provide
 // more certain timing.
 //
-void OneWire::write_bit(uint8_t v)
+void OneWire::write_slot(uint8_t v)
 {
 	IO_REG_TYPE mask IO_REG_MASK_ATTR = bitmask;
 	__attribute__((unused)) volatile IO_REG_TYPE *reg IO_REG_BASE_ATTR = baseReg;
 
+	STATS_BUS_BUSY_BEGIN;
 	if (v & 1) {
-		noInterrupts();
+		ENTER_CRITICAL();
 		DIRECT_WRITE_LOW(reg, mask);
 		DIRECT_MODE_OUTPUT(reg, mask);	// drive output low
-		delayMicroseconds(10);
+		delayMicroseconds(timing.write_1_low_us);
 		DIRECT_WRITE_HIGH(reg, mask);	// drive output high
-		interrupts();
-		delayMicroseconds(55);
+		EXIT_CRITICAL();
+		delayMicroseconds(timing.write_slot_us - timing.write_1_low_us + timing.recovery_us);
 	} else {
-		noInterrupts();
+		ENTER_CRITICAL();
 		DIRECT_WRITE_LOW(reg, mask);
 		DIRECT_MODE_OUTPUT(reg, mask);	// drive output low
-		delayMicroseconds(65);
+		delayMicroseconds(timing.write_0_low_us);
 		DIRECT_WRITE_HIGH(reg, mask);	// drive output high
-		interrupts();
-		delayMicroseconds(5);
+		EXIT_CRITICAL();
+		// The write 0 low time may fill the slot
+		delayMicroseconds((timing.write_slot_us > timing.write_0_low_us ? timing.write_slot_us - timing.write_0_low_us : 0) + timing.recovery_us);
 	}
+	STATS_BUS_BUSY_END;
+	STATS_ADD(bits_clocked, 1);
 }
 
 //
 // Read a bit. Port and bit is used to cut lookup time and provide
 // more certain timing.
 //
-uint8_t OneWire::read_bit(void)
+uint8_t OneWire::read_slot(void)
 {
 	IO_REG_TYPE mask IO_REG_MASK_ATTR = bitmask;
 	__attribute__((unused)) volatile IO_REG_TYPE *reg IO_REG_BASE_ATTR = baseReg;
 	uint8_t r;
 
-	noInterrupts();
+	STATS_BUS_BUSY_BEGIN;
+	ENTER_CRITICAL();
 	DIRECT_MODE_OUTPUT(reg, mask);
 	DIRECT_WRITE_LOW(reg, mask);
-	delayMicroseconds(3);
+	delayMicroseconds(timing.read_low_us);
 	DIRECT_MODE_INPUT(reg, mask);	// let pin float, pull up will raise
-	delayMicroseconds(10);
+	delayMicroseconds(timing.read_sample_us);
 	r = DIRECT_READ(reg, mask);
-	interrupts();
-	delayMicroseconds(53);
+	EXIT_CRITICAL();
+	delayMicroseconds(timing.read_slot_us - timing.read_low_us - timing.read_sample_us + timing.recovery_us);
+	STATS_BUS_BUSY_END;
+	STATS_ADD(bits_clocked, 1);
 	return r;
 }
 
@@ -254,13 +396,17 @@ void OneWire::write(uint8_t v, uint8_t power /* = 0 */) {
     uint8_t bitMask;
 
     for (bitMask = 0x01; bitMask; bitMask <<= 1) {
-	OneWire::write_bit( (bitMask & v)?1:0);
+	OneWire::write_slot( (bitMask & v)?1:0);
     }
+    STATS_ADD(bytes_clocked, 1);
+    TRACE(ONE_WIRE_TRACE_WRITE_BYTE, 0, v);
     if ( !power) {
-	noInterrupts();
+	ENTER_CRITICAL();
 	DIRECT_MODE_INPUT(baseReg, bitmask);
 	DIRECT_WRITE_LOW(baseReg, bitmask);
-	interrupts();
+	EXIT_CRITICAL();
+    } else {
+	TRACE(ONE_WIRE_TRACE_STRONG_PULLUP, ONE_WIRE_TRACE_VALUE, 0);
     }
 }
 
@@ -268,10 +414,10 @@ void OneWire::write_bytes(const uint8_t *buf, uint16_t count, bool power /* = 0
   for (uint16_t i = 0 ; i < count ; i++)
     write(buf[i]);
   if (!power) {
-    noInterrupts();
+    ENTER_CRITICAL();
     DIRECT_MODE_INPUT(baseReg, bitmask);
     DIRECT_WRITE_LOW(baseReg, bitmask);
-    interrupts();
+    EXIT_CRITICAL();
   }
 }
 
@@ -283,8 +429,10 @@ uint8_t OneWire::read() {
     uint8_t r = 0;
 
     for (bitMask = 0x01; bitMask; bitMask <<= 1) {
-	if ( OneWire::read_bit()) r |= bitMask;
+	if ( OneWire::read_slot()) r |= bitMask;
     }
+    STATS_ADD(bytes_clocked, 1);
+    TRACE(ONE_WIRE_TRACE_READ_BYTE, 0, r);
     return r;
 }
 
@@ -313,13 +461,66 @@ void OneWire::skip()
     write(0xCC);           // Skip ROM
 }
 
+void OneWire::power()
+{
+	ENTER_CRITICAL();
+	DIRECT_WRITE_HIGH(baseReg, bitmask);
+	DIRECT_MODE_OUTPUT(baseReg, bitmask);
+	EXIT_CRITICAL();
+	TRACE(ONE_WIRE_TRACE_STRONG_PULLUP, ONE_WIRE_TRACE_VALUE, 0);
+}
+
 void OneWire::depower()
 {
-	noInterrupts();
+	ENTER_CRITICAL();
 	DIRECT_MODE_INPUT(baseReg, bitmask);
+	EXIT_CRITICAL();
+	TRACE(ONE_WIRE_TRACE_STRONG_PULLUP, 0, 0);
+}
+
+#if defined(ONE_WIRE_TRACE)
+
+void OneWire::set_trace_hook(One_wire_trace_hook hook, void *context)
+{
+	noInterrupts();
+	trace_hook = hook;
+	trace_context = context;
+	interrupts();
+}
+
+#endif
+
+#if defined(ONE_WIRE_BUS_STATS)
+
+void OneWire::get_stats(One_wire_bus_stats *stats_to_get) const
+{
+	noInterrupts();
+	*stats_to_get = stats;
 	interrupts();
 }
 
+void OneWire::clear_stats()
+{
+	noInterrupts();
+	memset(&stats, 0, sizeof(stats));
+	interrupts();
+}
+
+void OneWire::count_crc_failure()
+{
+	STATS_ADD(crc_failures, 1);
+}
+
+void OneWire::count_critical_section(uint32_t elapsed_us)
+{
+	stats.critical_sections++;
+	stats.critical_section_total_us += elapsed_us;
+	if (elapsed_us > stats.critical_section_max_us)
+		stats.critical_section_max_us = elapsed_us;
+}
+
+#endif
+
 #if ONEWIRE_SEARCH
 
 //
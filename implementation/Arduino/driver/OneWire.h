@@ -14,6 +14,15 @@
 #endif
 
 #include <Arduino.h>       // for delayMicroseconds, digitalPinToBitMask, etc
+#include "../../common/One_wire_slot_timing.h"
+
+#if defined(ONE_WIRE_BUS_STATS)
+#include "../../common/One_wire_bus_stats.h"
+#endif
+
+#if defined(ONE_WIRE_TRACE)
+#include "../../common/One_wire_trace_events.h"
+#endif
 
 // You can exclude certain features from OneWire.  In theory, this
 // might save some space.  In practice, the compiler automatically
@@ -58,6 +67,16 @@ class OneWire
   private:
     IO_REG_TYPE bitmask;
     volatile IO_REG_TYPE *baseReg;
+    One_wire_slot_timing timing = STANDARD_TIMING;
+
+    // Bit slots of the bytes and of the public bit calls
+    void write_slot(uint8_t v);
+    uint8_t read_slot(void);
+
+#if defined(ONE_WIRE_TRACE)
+    One_wire_trace_hook trace_hook = nullptr;
+    void *trace_context = nullptr;
+#endif
 
 #if ONEWIRE_SEARCH
     // global search state
@@ -67,7 +86,17 @@ class OneWire
     bool LastDeviceFlag;
 #endif
 
+#if defined(ONE_WIRE_BUS_STATS)
+    One_wire_bus_stats stats = {};
+    uint32_t critical_section_start_us;
+    void count_critical_section(uint32_t elapsed_us);
+#endif
+
   public:
+    // Slot timing presets, the slow one has a longer recovery between slots for long buses
+    static const One_wire_slot_timing STANDARD_TIMING;
+    static const One_wire_slot_timing SLOW_TIMING;
+
     OneWire() { }
     OneWire(uint8_t pin) { begin(pin); }
     void begin(uint8_t pin);
@@ -77,6 +106,11 @@ class OneWire
     // bus is shorted or otherwise held low for more than 250uS
     uint8_t reset(void);
 
+    // Measure the rise time after a write 1 slot and the presence pulse
+    // of a reset, with the slot timing in use. The devices are left reset.
+    // Returns false if there is no device or the bus is shorted.
+    bool measure_bus(One_wire_bus_measurement *measurement);
+
     // Issue a 1-Wire rom select command, you do the reset first.
     void select(const uint8_t rom[8]);
 
@@ -103,6 +137,11 @@ class OneWire
     // Read a bit.
     uint8_t read_bit(void);
 
+    // Actively drive the bus high, e.g. for a parasite powered conversion
+    // started with a write() without the 'power' flag. Call depower() or
+    // start another read or write to release it.
+    void power(void);
+
     // Stop forcing power onto the bus. You only need to do this if
     // you used the 'power' flag to write() or used a write_bit() call
     // and aren't about to do another read or write. You would rather
@@ -110,6 +149,28 @@ class OneWire
     // someone shorts your bus.
     void depower(void);
 
+    // Set the reset and read/write slot timing of this bus.
+    void set_timing(const One_wire_slot_timing &new_timing);
+    const One_wire_slot_timing &get_timing() const;
+
+#if defined(ONE_WIRE_TRACE)
+    // Report every reset, byte, bit and strong pullup change of this bus
+    // to a trace hook, called after the event with interrupts enabled.
+    // The search is reported as its bits. nullptr stops the trace.
+    void set_trace_hook(One_wire_trace_hook hook, void *context);
+#endif
+
+#if defined(ONE_WIRE_BUS_STATS)
+    // Copy the counters of this bus.
+    void get_stats(One_wire_bus_stats *stats_to_get) const;
+
+    // Set every counter of this bus to zero.
+    void clear_stats();
+
+    // Count a CRC failure detected by a device driver.
+    void count_crc_failure();
+#endif
+
 #if ONEWIRE_SEARCH
     // Clear the search state so that if will start from the beginning again.
     void reset_search();
@@ -0,0 +1,28 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) || defined(IS_RUNNING_TESTS)
+
+#include "Esp_idf_backend.h"
+
+#if defined(IS_RUNNING_TESTS)
+    #include <mocks/ESP_IDF_driver/esp_idf.h>
+#else
+    #include <esp_timer.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+#endif
+
+uint32_t Esp_idf_clock::get_micros() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+// vTaskDelay() counts tick interrupts and the first one can come right away, so the time is rounded up
+// to whole ticks plus one. pdMS_TO_TICKS() rounds down, 94 ms at 100 Hz would be 9 ticks, 81 ms or more
+static TickType_t get_ticks_to_wait_at_least(uint32_t millis) {
+    return (millis + portTICK_PERIOD_MS - 1)/portTICK_PERIOD_MS + 1;
+}
+
+void Esp_idf_clock::delay_ms(uint32_t millis) {
+    vTaskDelay(get_ticks_to_wait_at_least(millis));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include "../common/Transport_backend.h"
+#include "Esp_idf_gpio_transport.h"
+#include <stdint.h>
+
+// Time of the ESP-IDF timer and FreeRTOS delays, for Transport_backend
+struct Esp_idf_clock {
+    static uint32_t get_micros();
+    static void delay_ms(uint32_t millis);
+};
+
+// The transport is a base declared before Transport_backend, so it is built before the backend uses it
+struct Esp_idf_gpio_bus {
+    explicit Esp_idf_gpio_bus(uint8_t pin) : gpio_transport((gpio_num_t)pin) {
+    }
+
+    Esp_idf_gpio_transport gpio_transport;
+};
+
+// Backend of Basic_one_wire_temp_sensor over the onewire driver on a GPIO. The onewire driver has one
+// slot timing for every bus
+class Esp_idf_backend : private Esp_idf_gpio_bus, public Transport_backend<Esp_idf_gpio_transport, Esp_idf_clock> {
+public:
+    typedef uint8_t Bus;
+
+    explicit Esp_idf_backend(uint8_t pin, Bus_snapshot_store* snapshot_store = nullptr)
+        : Esp_idf_gpio_bus(pin), Transport_backend(gpio_transport, snapshot_store) {
+    }
+
+    Esp_idf_backend(uint8_t pin, const Known_bus& known_bus)
+        : Esp_idf_gpio_bus(pin), Transport_backend(gpio_transport, known_bus) {
+    }
+};
\ No newline at end of file
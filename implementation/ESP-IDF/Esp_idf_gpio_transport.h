@@ -0,0 +1,111 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) || defined(IS_RUNNING_TESTS)
+
+#include "../common/One_wire_transport.h"
+#if defined(ONE_WIRE_BUS_STATS)
+    #include "../common/One_wire_bus_stats.h"
+#endif
+#if defined(ONE_WIRE_TRACE)
+    #include "../common/One_wire_trace.h"
+#endif
+#if defined(IS_RUNNING_TESTS)
+    #include <mocks/ESP_IDF_driver/onewire.h>
+#else
+    #include "driver/onewire.h"
+#endif
+
+/**
+ * Bit-banged 1-Wire on a GPIO, through the onewire driver. The slot timing,
+ * the stats and the trace of the driver are shared by every bus.
+ **/
+class Esp_idf_gpio_transport : public One_wire_transport<Esp_idf_gpio_transport> {
+public:
+    explicit Esp_idf_gpio_transport(gpio_num_t pin) : pin(pin) {
+    }
+
+    bool reset() {
+        return onewire_reset(pin);
+    }
+
+    bool write_bytes(const uint8_t* bytes, size_t count) {
+        return onewire_write_bytes(pin, bytes, count);
+    }
+
+    bool read_bytes(uint8_t* bytes, size_t count) {
+        return onewire_read_bytes(pin, bytes, count);
+    }
+
+    bool write_bit(bool bit) {
+        return onewire_write_bit(pin, bit);
+    }
+
+    bool read_bit(bool* bit) {
+        int value = onewire_read_bit(pin);
+        *bit = value > 0;
+        return value >= 0;
+    }
+
+    // Fused search step, the three slots share one critical section
+    bool triplet(bool* id_bit, bool* complement_bit, bool* direction) {
+        return onewire_triplet(pin, id_bit, complement_bit, direction);
+    }
+
+    bool strong_pullup(bool enable) {
+        if (!enable) {
+            onewire_depower(pin);
+            return true;
+        }
+        return onewire_power(pin);
+    }
+
+    // The byte and the strong pullup share one critical section
+    bool write_byte_and_strong_pullup(uint8_t byte) {
+        return onewire_write_power(pin, byte);
+    }
+
+    bool measure_bus(One_wire_bus_measurement* measurement) {
+        return onewire_measure(pin, measurement);
+    }
+
+    One_wire_slot_timing get_slot_timing() {
+        One_wire_slot_timing timing;
+        onewire_get_timing(&timing);
+        return timing;
+    }
+
+    One_wire_slot_timing get_slow_slot_timing() {
+        return ONEWIRE_SLOW_TIMING;
+    }
+
+    void set_slot_timing(const One_wire_slot_timing& timing) {
+        onewire_set_timing(&timing);
+    }
+
+#if defined(ONE_WIRE_BUS_STATS)
+    void count_crc_failure() {
+        onewire_stats_count_crc_failure();
+    }
+
+    One_wire_bus_stats get_bus_stats() {
+        One_wire_bus_stats stats;
+        onewire_get_stats(&stats);
+        return stats;
+    }
+
+    void clear_bus_stats() {
+        onewire_clear_stats();
+    }
+#endif
+
+#if defined(ONE_WIRE_TRACE)
+    void set_trace(One_wire_trace* trace) {
+        onewire_set_trace_hook(trace != nullptr ? One_wire_trace::record_to : nullptr, trace);
+    }
+#endif
+
+private:
+    gpio_num_t pin;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) && !defined(IS_RUNNING_TESTS)
+
+#include "Esp_idf_i2c_port.h"
+#include <freertos/FreeRTOS.h>
+
+#define I2C_TIMEOUT_MS 10
+
+Esp_idf_i2c_port::Esp_idf_i2c_port(i2c_port_t i2c_num, uint8_t device_address)
+    : i2c_num(i2c_num), device_address(device_address) {
+}
+
+bool Esp_idf_i2c_port::write(const uint8_t* bytes, size_t length) {
+    return i2c_master_write_to_device(i2c_num, device_address, bytes, length, pdMS_TO_TICKS(I2C_TIMEOUT_MS)) == ESP_OK;
+}
+
+bool Esp_idf_i2c_port::read(uint8_t* bytes, size_t length) {
+    return i2c_master_read_from_device(i2c_num, device_address, bytes, length, pdMS_TO_TICKS(I2C_TIMEOUT_MS)) == ESP_OK;
+}
+
+#endif
\ No newline at end of file
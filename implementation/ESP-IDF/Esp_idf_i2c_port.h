@@ -0,0 +1,24 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) && !defined(IS_RUNNING_TESTS)
+
+#include "../common/Ds2482_transport.h"
+#include <driver/i2c.h>
+
+/**
+ * I2C master driven through the ESP-IDF driver, talking to one bridge address.
+ * The I2C driver must already be installed on the port.
+ **/
+class Esp_idf_i2c_port : public I2c_port {
+public:
+    Esp_idf_i2c_port(i2c_port_t i2c_num, uint8_t device_address);
+
+    bool write(const uint8_t* bytes, size_t length) override;
+    bool read(uint8_t* bytes, size_t length) override;
+
+private:
+    i2c_port_t i2c_num;
+    uint8_t device_address;
+};
+
+#endif
\ No newline at end of file
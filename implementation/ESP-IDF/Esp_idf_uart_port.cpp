@@ -0,0 +1,41 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) && !defined(IS_RUNNING_TESTS)
+
+#include "Esp_idf_uart_port.h"
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+
+#define RX_BUFFER_SIZE 256
+#define ECHO_TIMEOUT_MS 20
+
+Esp_idf_uart_port::Esp_idf_uart_port(uart_port_t uart_num, int tx_pin, int rx_pin) : uart_num(uart_num) {
+    uart_config_t config = {};
+    config.baud_rate = UART_TRANSPORT_DATA_BAUD_RATE;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+
+    uart_driver_install(uart_num, RX_BUFFER_SIZE, 0, 0, NULL, 0);
+    uart_param_config(uart_num, &config);
+    uart_set_pin(uart_num, tx_pin, rx_pin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    gpio_set_direction((gpio_num_t)tx_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+}
+
+Esp_idf_uart_port::~Esp_idf_uart_port() {
+    uart_driver_delete(uart_num);
+}
+
+void Esp_idf_uart_port::set_baud_rate(uint32_t baud_rate) {
+    uart_wait_tx_done(uart_num, pdMS_TO_TICKS(ECHO_TIMEOUT_MS));
+    uart_set_baudrate(uart_num, baud_rate);
+}
+
+bool Esp_idf_uart_port::transfer(const uint8_t* to_write, uint8_t* echo, size_t length) {
+    uart_flush_input(uart_num);
+    uart_write_bytes(uart_num, (const char*)to_write, length);
+    int bytes_read = uart_read_bytes(uart_num, echo, length, pdMS_TO_TICKS(ECHO_TIMEOUT_MS));
+    return bytes_read == (int)length;
+}
+
+#endif
\ No newline at end of file
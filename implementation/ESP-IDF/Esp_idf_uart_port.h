@@ -0,0 +1,24 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) && !defined(IS_RUNNING_TESTS)
+
+#include "../common/Uart_transport.h"
+#include <driver/uart.h>
+
+/**
+ * UART driven through the ESP-IDF driver. TX is set to open drain, it can be
+ * routed to the same GPIO as RX or to the bus through an external buffer.
+ **/
+class Esp_idf_uart_port : public Uart_port {
+public:
+    Esp_idf_uart_port(uart_port_t uart_num, int tx_pin, int rx_pin);
+    ~Esp_idf_uart_port();
+
+    void set_baud_rate(uint32_t baud_rate) override;
+    bool transfer(const uint8_t* to_write, uint8_t* echo, size_t length) override;
+
+private:
+    uart_port_t uart_num;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include "../../config.h"
+#if (defined(ESP32_WITH_ESP_IDF) || defined(ESP32_WITH_ARDUINO)) && !defined(IS_RUNNING_TESTS)
+
+#include "Esp_light_sleeper.h"
+#include <esp_sleep.h>
+
+// The timer wakeup stays enabled, the next sleep programs it again
+void Esp_light_sleeper::sleep_us(uint32_t microseconds) {
+    esp_sleep_enable_timer_wakeup(microseconds);
+    esp_light_sleep_start();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+#include "../../config.h"
+#if (defined(ESP32_WITH_ESP_IDF) || defined(ESP32_WITH_ARDUINO)) && !defined(IS_RUNNING_TESTS)
+
+#include "../common/Light_sleeper.h"
+
+/**
+ * Light sleep with the timer wakeup of the ESP32, the esp_sleep API is also
+ * available with the Arduino core. The GPIOs and RAM are kept and esp_timer
+ * and millis() keep counting, so the sensor finds the conversion time over
+ * when it wakes up. Other enabled wakeup sources can end the sleep early.
+ **/
+class Esp_light_sleeper : public Light_sleeper {
+public:
+    void sleep_us(uint32_t microseconds) override;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) && !defined(IS_RUNNING_TESTS)
+
+#include "Nvs_bus_snapshot_store.h"
+#include <nvs.h>
+
+#define NVS_NAMESPACE "one_wire"
+
+Nvs_bus_snapshot_store::Nvs_bus_snapshot_store(const char* key) : key(key) {
+}
+
+bool Nvs_bus_snapshot_store::load(Bus_snapshot* snapshot) {
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+        return false;
+    uint8_t buffer[BUS_SNAPSHOT_MAX_SIZE];
+    size_t length = sizeof(buffer);
+    esp_err_t result = nvs_get_blob(handle, key, buffer, &length);
+    nvs_close(handle);
+    return result == ESP_OK && decode_bus_snapshot(buffer, length, snapshot);
+}
+
+bool Nvs_bus_snapshot_store::save(const Bus_snapshot& snapshot) {
+    uint8_t buffer[BUS_SNAPSHOT_MAX_SIZE];
+    size_t length = encode_bus_snapshot(snapshot, buffer, sizeof(buffer));
+    nvs_handle_t handle;
+    if (length == 0 || nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK)
+        return false;
+    esp_err_t result = nvs_set_blob(handle, key, buffer, length);
+    if (result == ESP_OK)
+        result = nvs_commit(handle);
+    nvs_close(handle);
+    return result == ESP_OK;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include "../../config.h"
+#if defined(ESP32_WITH_ESP_IDF) && !defined(IS_RUNNING_TESTS)
+
+#include "../common/Bus_snapshot.h"
+
+/**
+ * Keeps the snapshot as a blob in the NVS namespace "one_wire", one key per bus.
+ * nvs_flash_init() must already have been called. The sensor only saves the
+ * snapshot when it changes, so reboots do not wear the flash.
+ **/
+class Nvs_bus_snapshot_store : public Bus_snapshot_store {
+public:
+    // The key must outlive the store and have at most 15 characters
+    explicit Nvs_bus_snapshot_store(const char* key);
+
+    bool load(Bus_snapshot* snapshot) override;
+    bool save(const Bus_snapshot& snapshot) override;
+
+private:
+    const char* key;
+};
+
+#endif
\ No newline at end of file
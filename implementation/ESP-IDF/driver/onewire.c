@@ -62,6 +62,26 @@
 #define ONEWIRE_SKIP_ROM   0xcc
 #define ONEWIRE_SEARCH     0xf0
 
+#if defined(ONE_WIRE_BUS_STATS)
+#include <esp_timer.h>
+
+static One_wire_bus_stats stats;
+static uint8_t critical_section_depth;
+static int64_t critical_section_start_us;
+
+#define STATS_ADD(counter, value) (stats.counter += (value))
+#define STATS_ENTER_CRITICAL onewire_stats_enter_critical()
+#define STATS_EXIT_CRITICAL onewire_stats_exit_critical()
+#define STATS_BUS_BUSY_BEGIN int64_t bus_busy_start_us = esp_timer_get_time()
+#define STATS_BUS_BUSY_END STATS_ADD(bus_busy_us, esp_timer_get_time() - bus_busy_start_us)
+#else
+#define STATS_ADD(counter, value) do {} while (0)
+#define STATS_ENTER_CRITICAL do {} while (0)
+#define STATS_EXIT_CRITICAL do {} while (0)
+#define STATS_BUS_BUSY_BEGIN
+#define STATS_BUS_BUSY_END do {} while (0)
+#endif
+
 #if HELPER_TARGET_IS_ESP8266
 #define PORT_ENTER_CRITICAL portENTER_CRITICAL()
 #define PORT_EXIT_CRITICAL portEXIT_CRITICAL()
@@ -76,6 +96,71 @@ static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
 #error BUG: Unknown target
 #endif
 
+#define STANDARD_TIMING { \
+    .reset_low_us = 480, .presence_sample_us = 70, .reset_recovery_us = 410, \
+    .write_1_low_us = 10, .write_0_low_us = 65, .write_slot_us = 65, \
+    .read_low_us = 2, .read_sample_us = 11, .read_slot_us = 61, \
+    .recovery_us = 1, \
+}
+
+const One_wire_slot_timing ONEWIRE_STANDARD_TIMING = STANDARD_TIMING;
+
+const One_wire_slot_timing ONEWIRE_SLOW_TIMING = {
+    .reset_low_us = 480, .presence_sample_us = 70, .reset_recovery_us = 410,
+    .write_1_low_us = 10, .write_0_low_us = 65, .write_slot_us = 65,
+    .read_low_us = 2, .read_sample_us = 11, .read_slot_us = 61,
+    .recovery_us = 30,
+};
+
+static One_wire_slot_timing timing = STANDARD_TIMING;
+
+#if defined(ONE_WIRE_TRACE)
+static One_wire_trace_hook trace_hook;
+static void *trace_context;
+
+// Events of the calls made in a critical section of the caller, see onewire_defer_trace()
+#define DEFERRED_TRACE_EVENTS 4
+static struct {
+    uint8_t event;
+    uint8_t flags;
+    uint8_t data;
+} deferred_events[DEFERRED_TRACE_EVENTS];
+static uint8_t deferred_event_count;
+static bool is_trace_deferred;
+
+static void _onewire_trace(uint8_t event, uint8_t flags, uint8_t data)
+{
+    if (!trace_hook)
+        return;
+    if (!is_trace_deferred)
+    {
+        trace_hook(trace_context, event, flags, data);
+        return;
+    }
+    if (deferred_event_count < DEFERRED_TRACE_EVENTS)
+    {
+        deferred_events[deferred_event_count].event = event;
+        deferred_events[deferred_event_count].flags = flags;
+        deferred_events[deferred_event_count].data = data;
+        deferred_event_count++;
+    }
+}
+
+// Bus events, reported outside the critical sections
+#define TRACE(event, flags, data) _onewire_trace((event), (flags), (data))
+#define TRACE_DEFER onewire_defer_trace()
+#define TRACE_FLUSH onewire_flush_trace()
+#else
+#define TRACE(event, flags, data) do {} while (0)
+#define TRACE_DEFER do {} while (0)
+#define TRACE_FLUSH do {} while (0)
+#endif
+#define TRACE_FLAGS(is_done, value) (((is_done) ? 0 : ONE_WIRE_TRACE_FAILED) | ((value) ? ONE_WIRE_TRACE_VALUE : 0))
+
+// Critical sections of the bus timing, measured when ONE_WIRE_BUS_STATS is enabled
+#define ENTER_CRITICAL do { PORT_ENTER_CRITICAL; STATS_ENTER_CRITICAL; } while (0)
+#define EXIT_CRITICAL do { STATS_EXIT_CRITICAL; PORT_EXIT_CRITICAL; } while (0)
+
 // Waits up to `max_wait` microseconds for the specified pin to go high.
 // Returns true if successful, false if the bus never comes high (likely
 // shorted).
@@ -109,26 +194,98 @@ static void setup_pin(gpio_num_t pin, bool open_drain)
 //
 bool onewire_reset(gpio_num_t pin)
 {
+    STATS_ADD(resets, 1);
+    STATS_BUS_BUSY_BEGIN;
     setup_pin(pin, true);
 
     gpio_set_level(pin, 1);
     // wait until the wire is high... just in case
     if (!_onewire_wait_for_bus(pin, 250))
+    {
+        STATS_ADD(presence_failures, 1);
+        TRACE(ONE_WIRE_TRACE_RESET, ONE_WIRE_TRACE_FAILED, 0);
         return false;
+    }
 
     gpio_set_level(pin, 0);
-    ets_delay_us(480);
+    ets_delay_us(timing.reset_low_us);
 
-    PORT_ENTER_CRITICAL;
+    ENTER_CRITICAL;
     gpio_set_level(pin, 1); // allow it to float
-    ets_delay_us(70);
+    ets_delay_us(timing.presence_sample_us);
     bool r = !gpio_get_level(pin);
-    PORT_EXIT_CRITICAL;
+    EXIT_CRITICAL;
 
     // Wait for all devices to finish pulling the bus low before returning
-    if (!_onewire_wait_for_bus(pin, 410))
+    if (!_onewire_wait_for_bus(pin, timing.reset_recovery_us))
+        r = false;
+
+    STATS_BUS_BUSY_END;
+    if (!r)
+        STATS_ADD(presence_failures, 1);
+    TRACE(ONE_WIRE_TRACE_RESET, TRACE_FLAGS(true, r), 0);
+    return r;
+}
+
+// Polls the pin until it reads `level`, for up to `max_us` polls of 1us.
+// Returns the polls. The time of each read is not counted, so the result
+// falls short of the real time, see SLOT_TIMING_MARGIN_US.
+static uint16_t _onewire_count_until(gpio_num_t pin, int level, uint16_t max_us)
+{
+    uint16_t elapsed_us = 0;
+    while (gpio_get_level(pin) != level && elapsed_us < max_us)
+    {
+        ets_delay_us(1);
+        elapsed_us++;
+    }
+    return elapsed_us;
+}
+
+// Measure the rise time after a write 1 slot and the presence pulse of a
+// reset. The reset is timed like onewire_reset(), but the bus is polled in a
+// critical section from the release of the reset pulse to the end of the
+// presence pulse, up to 480us.
+//
+// Returns true if a device asserted a presence pulse, false otherwise.
+//
+bool onewire_measure(gpio_num_t pin, One_wire_bus_measurement *measurement)
+{
+    STATS_ADD(resets, 1);
+    STATS_BUS_BUSY_BEGIN;
+    setup_pin(pin, true);
+
+    gpio_set_level(pin, 1);
+    if (!_onewire_wait_for_bus(pin, 250))
+    {
+        STATS_ADD(presence_failures, 1);
         return false;
+    }
+
+    ENTER_CRITICAL;
+    gpio_set_level(pin, 0);
+    ets_delay_us(timing.write_1_low_us);
+    gpio_set_level(pin, 1);
+    measurement->rise_us = _onewire_count_until(pin, 1, timing.write_slot_us);
+    EXIT_CRITICAL;
+    ets_delay_us(timing.write_slot_us);
 
+    uint16_t reset_release_us = timing.presence_sample_us + timing.reset_recovery_us;
+    gpio_set_level(pin, 0);
+    ets_delay_us(timing.reset_low_us);
+
+    ENTER_CRITICAL;
+    gpio_set_level(pin, 1); // allow it to float
+    measurement->presence_delay_us = _onewire_count_until(pin, 0, reset_release_us);
+    measurement->presence_low_us = _onewire_count_until(pin, 1, reset_release_us - measurement->presence_delay_us);
+    EXIT_CRITICAL;
+
+    bool r = measurement->presence_low_us != 0;
+    if (!_onewire_wait_for_bus(pin, reset_release_us - measurement->presence_delay_us - measurement->presence_low_us))
+        r = false;
+
+    STATS_BUS_BUSY_END;
+    if (!r)
+        STATS_ADD(presence_failures, 1);
     return r;
 }
 
@@ -136,22 +293,27 @@ static bool _onewire_write_bit(gpio_num_t pin, bool v)
 {
     if (!_onewire_wait_for_bus(pin, 10))
         return false;
-    PORT_ENTER_CRITICAL;
+    STATS_BUS_BUSY_BEGIN;
+    ENTER_CRITICAL;
     if (v)
     {
         gpio_set_level(pin, 0);  // drive output low
-        ets_delay_us(10);
+        ets_delay_us(timing.write_1_low_us);
         gpio_set_level(pin, 1);  // allow output high
-        ets_delay_us(55);
+        ets_delay_us(timing.write_slot_us - timing.write_1_low_us);
     }
     else
     {
         gpio_set_level(pin, 0);  // drive output low
-        ets_delay_us(65);
+        ets_delay_us(timing.write_0_low_us);
         gpio_set_level(pin, 1); // allow output high
+        if (timing.write_slot_us > timing.write_0_low_us)
+            ets_delay_us(timing.write_slot_us - timing.write_0_low_us);
     }
-    ets_delay_us(1);
-    PORT_EXIT_CRITICAL;
+    ets_delay_us(timing.recovery_us);
+    EXIT_CRITICAL;
+    STATS_BUS_BUSY_END;
+    STATS_ADD(bits_clocked, 1);
 
     return true;
 }
@@ -161,18 +323,75 @@ static int _onewire_read_bit(gpio_num_t pin)
     if (!_onewire_wait_for_bus(pin, 10))
         return -1;
 
-    PORT_ENTER_CRITICAL;
+    STATS_BUS_BUSY_BEGIN;
+    ENTER_CRITICAL;
     gpio_set_level(pin, 0);
-    ets_delay_us(2);
+    ets_delay_us(timing.read_low_us);
     gpio_set_level(pin, 1);  // let pin float, pull up will raise
-    ets_delay_us(11);
+    ets_delay_us(timing.read_sample_us);
     int r = gpio_get_level(pin);  // Must sample within 15us of start
-    ets_delay_us(48);
-    PORT_EXIT_CRITICAL;
+    ets_delay_us(timing.read_slot_us - timing.read_low_us - timing.read_sample_us);
+    ets_delay_us(timing.recovery_us);
+    EXIT_CRITICAL;
+    STATS_BUS_BUSY_END;
+    STATS_ADD(bits_clocked, 1);
 
     return r;
 }
 
+// Read a ROM bit, read its complement and write the search direction, all in
+// one critical section. When both bits differ the direction is the bit read,
+// otherwise the one passed in is written. The slot delays are computed before
+// interrupts are masked, so the three slots are back to back.
+//
+static bool _onewire_triplet(gpio_num_t pin, bool *id_bit, bool *cmp_id_bit, bool *direction)
+{
+    if (!_onewire_wait_for_bus(pin, 10))
+    {
+        TRACE(ONE_WIRE_TRACE_TRIPLET, ONE_WIRE_TRACE_FAILED, 0);
+        return false;
+    }
+
+    uint32_t read_rest_us = timing.read_slot_us - timing.read_low_us - timing.read_sample_us + timing.recovery_us;
+    uint32_t write_1_rest_us = timing.write_slot_us - timing.write_1_low_us + timing.recovery_us;
+    uint32_t write_0_rest_us = (timing.write_slot_us > timing.write_0_low_us ? timing.write_slot_us - timing.write_0_low_us : 0) + timing.recovery_us;
+
+    STATS_BUS_BUSY_BEGIN;
+    ENTER_CRITICAL;
+    gpio_set_level(pin, 0);
+    ets_delay_us(timing.read_low_us);
+    gpio_set_level(pin, 1);
+    ets_delay_us(timing.read_sample_us);
+    *id_bit = gpio_get_level(pin);
+    ets_delay_us(read_rest_us);
+
+    gpio_set_level(pin, 0);
+    ets_delay_us(timing.read_low_us);
+    gpio_set_level(pin, 1);
+    ets_delay_us(timing.read_sample_us);
+    *cmp_id_bit = gpio_get_level(pin);
+    ets_delay_us(read_rest_us);
+
+    // No device answered, do not write the direction slot
+    bool is_bus_answering = !(*id_bit && *cmp_id_bit);
+    if (is_bus_answering)
+    {
+        if (*id_bit != *cmp_id_bit)
+            *direction = *id_bit;
+        gpio_set_level(pin, 0);
+        ets_delay_us(*direction ? timing.write_1_low_us : timing.write_0_low_us);
+        gpio_set_level(pin, 1);
+        ets_delay_us(*direction ? write_1_rest_us : write_0_rest_us);
+    }
+    EXIT_CRITICAL;
+    STATS_BUS_BUSY_END;
+    STATS_ADD(bits_clocked, is_bus_answering ? 3 : 2);
+    TRACE(ONE_WIRE_TRACE_TRIPLET, TRACE_FLAGS(true, *id_bit) |
+          (*cmp_id_bit ? ONE_WIRE_TRACE_COMPLEMENT_BIT : 0) | (*direction ? ONE_WIRE_TRACE_DIRECTION : 0), 0);
+
+    return true;
+}
+
 // Write a byte. The writing code uses open-drain mode and expects the pullup
 // resistor to pull the line high when not driven low.  If you need strong
 // power after the write (e.g. DS18B20 in parasite power mode) then call
@@ -182,8 +401,13 @@ bool onewire_write(gpio_num_t pin, uint8_t v)
 {
     for (uint8_t bitMask = 0x01; bitMask; bitMask <<= 1)
         if (!_onewire_write_bit(pin, (bitMask & v)))
+        {
+            TRACE(ONE_WIRE_TRACE_WRITE_BYTE, ONE_WIRE_TRACE_FAILED, v);
             return false;
+        }
 
+    STATS_ADD(bytes_clocked, 1);
+    TRACE(ONE_WIRE_TRACE_WRITE_BYTE, 0, v);
     return true;
 }
 
@@ -206,10 +430,15 @@ int onewire_read(gpio_num_t pin)
     {
         int bit = _onewire_read_bit(pin);
         if (bit < 0)
+        {
+            TRACE(ONE_WIRE_TRACE_READ_BYTE, ONE_WIRE_TRACE_FAILED, 0);
             return -1;
+        }
         else if (bit)
             r |= bitMask;
     }
+    STATS_ADD(bytes_clocked, 1);
+    TRACE(ONE_WIRE_TRACE_READ_BYTE, 0, r);
     return r;
 }
 
@@ -228,6 +457,25 @@ bool onewire_read_bytes(gpio_num_t pin, uint8_t *buf, size_t count)
     return true;
 }
 
+bool onewire_write_bit(gpio_num_t pin, bool v)
+{
+    bool r = _onewire_write_bit(pin, v);
+    TRACE(ONE_WIRE_TRACE_WRITE_BIT, TRACE_FLAGS(r, v), 0);
+    return r;
+}
+
+int onewire_read_bit(gpio_num_t pin)
+{
+    int r = _onewire_read_bit(pin);
+    TRACE(ONE_WIRE_TRACE_READ_BIT, TRACE_FLAGS(r >= 0, r > 0), 0);
+    return r;
+}
+
+bool onewire_triplet(gpio_num_t pin, bool *id_bit, bool *cmp_id_bit, bool *direction)
+{
+    return _onewire_triplet(pin, id_bit, cmp_id_bit, direction);
+}
+
 bool onewire_select(gpio_num_t pin, onewire_addr_t addr)
 {
     uint8_t i;
@@ -255,17 +503,33 @@ bool onewire_power(gpio_num_t pin)
     // Make sure the bus is not being held low before driving it high, or we
     // may end up shorting ourselves out.
     if (!_onewire_wait_for_bus(pin, 10))
+    {
+        TRACE(ONE_WIRE_TRACE_STRONG_PULLUP, TRACE_FLAGS(false, true), 0);
         return false;
+    }
 
     setup_pin(pin, false);
     gpio_set_level(pin, 1);
+    TRACE(ONE_WIRE_TRACE_STRONG_PULLUP, TRACE_FLAGS(true, true), 0);
 
     return true;
 }
 
+bool onewire_write_power(gpio_num_t pin, uint8_t v)
+{
+    TRACE_DEFER;
+    ENTER_CRITICAL;
+    bool r = onewire_write(pin, v) && onewire_power(pin);
+    EXIT_CRITICAL;
+    TRACE_FLUSH;
+
+    return r;
+}
+
 void onewire_depower(gpio_num_t pin)
 {
     setup_pin(pin, true);
+    TRACE(ONE_WIRE_TRACE_STRONG_PULLUP, TRACE_FLAGS(true, false), 0);
 }
 
 void onewire_search_start(onewire_search_t *search)
@@ -306,7 +570,7 @@ onewire_addr_t onewire_search_next(onewire_search_t *search, gpio_num_t pin)
     uint8_t id_bit_number;
     uint8_t last_zero, search_result;
     int rom_byte_number;
-    int8_t id_bit, cmp_id_bit;
+    bool id_bit, cmp_id_bit;
     onewire_addr_t addr;
     unsigned char rom_byte_mask;
     bool search_direction;
@@ -336,53 +600,43 @@ onewire_addr_t onewire_search_next(onewire_search_t *search, gpio_num_t pin)
         // loop to do the search
         do
         {
-            // read a bit and its complement
-            id_bit = _onewire_read_bit(pin);
-            cmp_id_bit = _onewire_read_bit(pin);
+            // if this discrepancy if before the Last Discrepancy
+            // on a previous next then pick the same as last time,
+            // if equal to last pick 1, if not then pick 0.
+            // The triplet overrides it when all devices coupled have 0 or 1
+            if (id_bit_number < search->last_discrepancy)
+                search_direction = ((search->rom_no[rom_byte_number] & rom_byte_mask) > 0);
+            else
+                search_direction = (id_bit_number == search->last_discrepancy);
+
+            // read a bit and its complement, then write the direction
+            if (!_onewire_triplet(pin, &id_bit, &cmp_id_bit, &search_direction))
+                break;
 
-            if ((id_bit == 1) && (cmp_id_bit == 1))
+            if (id_bit && cmp_id_bit)
                 break;
+
+            // if 0 was picked on a discrepancy then record its position in LastZero
+            if (!id_bit && !cmp_id_bit && !search_direction)
+                last_zero = id_bit_number;
+
+            // set or clear the bit in the ROM byte rom_byte_number
+            // with mask rom_byte_mask
+            if (search_direction)
+                search->rom_no[rom_byte_number] |= rom_byte_mask;
             else
+                search->rom_no[rom_byte_number] &= ~rom_byte_mask;
+
+            // increment the byte counter id_bit_number
+            // and shift the mask rom_byte_mask
+            id_bit_number++;
+            rom_byte_mask <<= 1;
+
+            // if the mask is 0 then go to new SerialNum byte rom_byte_number and reset mask
+            if (rom_byte_mask == 0)
             {
-                // all devices coupled have 0 or 1
-                if (id_bit != cmp_id_bit)
-                    search_direction = id_bit;  // bit write value for search
-                else
-                {
-                    // if this discrepancy if before the Last Discrepancy
-                    // on a previous next then pick the same as last time
-                    if (id_bit_number < search->last_discrepancy)
-                        search_direction = ((search->rom_no[rom_byte_number] & rom_byte_mask) > 0);
-                    else
-                        // if equal to last pick 1, if not then pick 0
-                        search_direction = (id_bit_number == search->last_discrepancy);
-
-                    // if 0 was picked then record its position in LastZero
-                    if (!search_direction)
-                        last_zero = id_bit_number;
-                }
-
-                // set or clear the bit in the ROM byte rom_byte_number
-                // with mask rom_byte_mask
-                if (search_direction)
-                    search->rom_no[rom_byte_number] |= rom_byte_mask;
-                else
-                    search->rom_no[rom_byte_number] &= ~rom_byte_mask;
-
-                // serial number search direction write bit
-                _onewire_write_bit(pin, search_direction);
-
-                // increment the byte counter id_bit_number
-                // and shift the mask rom_byte_mask
-                id_bit_number++;
-                rom_byte_mask <<= 1;
-
-                // if the mask is 0 then go to new SerialNum byte rom_byte_number and reset mask
-                if (rom_byte_mask == 0)
-                {
-                    rom_byte_number++;
-                    rom_byte_mask = 1;
-                }
+                rom_byte_number++;
+                rom_byte_mask = 1;
             }
         } while (rom_byte_number < 8);  // loop until through all ROM bytes 0-7
 
@@ -549,5 +803,85 @@ uint16_t onewire_crc16(const uint8_t* input, size_t len, uint16_t crc_iv)
     return crc;
 }
 
+void onewire_set_timing(const One_wire_slot_timing *new_timing)
+{
+    PORT_ENTER_CRITICAL;
+    timing = *new_timing;
+    PORT_EXIT_CRITICAL;
+}
+
+void onewire_get_timing(One_wire_slot_timing *timing_to_get)
+{
+    PORT_ENTER_CRITICAL;
+    *timing_to_get = timing;
+    PORT_EXIT_CRITICAL;
+}
+
+#if defined(ONE_WIRE_TRACE)
+
+void onewire_set_trace_hook(One_wire_trace_hook hook, void *context)
+{
+    PORT_ENTER_CRITICAL;
+    trace_hook = hook;
+    trace_context = context;
+    PORT_EXIT_CRITICAL;
+}
+
+void onewire_defer_trace(void)
+{
+    is_trace_deferred = true;
+}
+
+void onewire_flush_trace(void)
+{
+    is_trace_deferred = false;
+    for (uint8_t i = 0; i < deferred_event_count; i++)
+        if (trace_hook)
+            trace_hook(trace_context, deferred_events[i].event, deferred_events[i].flags, deferred_events[i].data);
+    deferred_event_count = 0;
+}
+
+#endif
+
+#if defined(ONE_WIRE_BUS_STATS)
+
+void onewire_get_stats(One_wire_bus_stats *stats_to_get)
+{
+    PORT_ENTER_CRITICAL;
+    *stats_to_get = stats;
+    PORT_EXIT_CRITICAL;
+}
+
+void onewire_clear_stats(void)
+{
+    PORT_ENTER_CRITICAL;
+    memset(&stats, 0, sizeof(stats));
+    PORT_EXIT_CRITICAL;
+}
+
+void onewire_stats_count_crc_failure(void)
+{
+    STATS_ADD(crc_failures, 1);
+}
+
+void onewire_stats_enter_critical(void)
+{
+    if (critical_section_depth++ == 0)
+        critical_section_start_us = esp_timer_get_time();
+}
+
+void onewire_stats_exit_critical(void)
+{
+    if (critical_section_depth == 0 || --critical_section_depth != 0)
+        return;
+
+    uint32_t elapsed_us = esp_timer_get_time() - critical_section_start_us;
+    stats.critical_sections++;
+    stats.critical_section_total_us += elapsed_us;
+    if (elapsed_us > stats.critical_section_max_us)
+        stats.critical_section_max_us = elapsed_us;
+}
+
+#endif //ONE_WIRE_BUS_STATS
 
 #endif //ESP32_WITH_ESP_IDF
\ No newline at end of file
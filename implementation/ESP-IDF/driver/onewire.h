@@ -60,6 +60,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <driver/gpio.h>
+#include "../../common/One_wire_bus_stats.h"
+#include "../../common/One_wire_slot_timing.h"
+#include "../../common/One_wire_trace_events.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -170,6 +173,25 @@ int onewire_read(gpio_num_t pin);
  */
 bool onewire_read_bytes(gpio_num_t pin, uint8_t *buf, size_t count);
 
+/**
+ * @brief Write a single bit on the 1-Wire bus.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ * @param v    The bit value to write
+ *
+ * @return `true` if the bit was written, `false` if the bus is held low.
+ */
+bool onewire_write_bit(gpio_num_t pin, bool v);
+
+/**
+ * @brief Read a single bit from the 1-Wire bus.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ *
+ * @return the read bit on success, negative value if the bus is held low.
+ */
+int onewire_read_bit(gpio_num_t pin);
+
 /**
  * @brief Actively drive the bus high to provide extra power for certain
  *        operations of parasitically-powered devices.
@@ -201,6 +223,20 @@ bool onewire_read_bytes(gpio_num_t pin, uint8_t *buf, size_t count);
  */
 bool onewire_power(gpio_num_t pin);
 
+/**
+ * @brief Write a byte and actively drive the bus high right after it.
+ *
+ * Parasite powered devices need the strong pullup within 10us of the end of
+ * CONVERT T or COPY SCRATCHPAD, so the byte and ::onewire_power() share one
+ * critical section. Call ::onewire_depower() once the operation is over.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ * @param v    The byte to write
+ *
+ * @return `true` on success, `false` on error.
+ */
+bool onewire_write_power(gpio_num_t pin, uint8_t v);
+
 /**
  * @brief Stop forcing power onto the bus.
  *
@@ -213,6 +249,25 @@ bool onewire_power(gpio_num_t pin);
  */
 void onewire_depower(gpio_num_t pin);
 
+/**
+ * @brief Run one step of the ROM search: read a bit, read its complement
+ *        and write the direction taken.
+ *
+ * The three time slots are clocked in a single critical section. Search
+ * routines built on this primitive can swap it for the native triplet
+ * command of a bridge chip (e.g. DS2482).
+ *
+ * @param pin             The GPIO pin connected to the 1-Wire bus.
+ * @param[out] id_bit     The bit read
+ * @param[out] cmp_id_bit The complement read
+ * @param[in,out] direction  Direction to take when both bits are 0, the
+ *                           direction written on return. Nothing is written
+ *                           when both bits are 1 (no device answered).
+ *
+ * @return `true` on success, `false` if the bus is held low.
+ */
+bool onewire_triplet(gpio_num_t pin, bool *id_bit, bool *cmp_id_bit, bool *direction);
+
 /**
  * @brief Clear the search state so that it will start from the beginning on
  *        the next call to ::onewire_search_next().
@@ -302,6 +357,115 @@ bool onewire_check_crc16(const uint8_t* input, size_t len, const uint8_t* invert
  */
 uint16_t onewire_crc16(const uint8_t* input, size_t len, uint16_t crc_iv);
 
+/**
+ * @brief Standard slot timing, used until ::onewire_set_timing() is called.
+ */
+extern const One_wire_slot_timing ONEWIRE_STANDARD_TIMING;
+
+/**
+ * @brief Standard slots with a longer recovery between them, for long or
+ *        heavily loaded buses.
+ */
+extern const One_wire_slot_timing ONEWIRE_SLOW_TIMING;
+
+/**
+ * @brief Set the reset and read/write slot timing.
+ *
+ * The timing is shared by every bus driven by this driver.
+ *
+ * @param timing  New slot timing
+ */
+void onewire_set_timing(const One_wire_slot_timing *timing);
+
+/**
+ * @brief Copy the reset and read/write slot timing in use.
+ *
+ * @param timing  Destination of the slot timing
+ */
+void onewire_get_timing(One_wire_slot_timing *timing);
+
+/**
+ * @brief Measure how the bus rises after a write slot and the presence pulse
+ *        after a reset.
+ *
+ * Input for calibrate_slot_timing(). The bus is measured with the slot timing
+ * in use, in a critical section of up to 480us, and the devices are left
+ * reset.
+ *
+ * @param pin          The GPIO pin connected to the 1-Wire bus.
+ * @param measurement  Destination of the times measured
+ *
+ * @return `true` if a device asserted a presence pulse, `false` otherwise.
+ */
+bool onewire_measure(gpio_num_t pin, One_wire_bus_measurement *measurement);
+
+#if defined(ONE_WIRE_TRACE)
+
+/**
+ * @brief Report every reset, byte, bit, search triplet and strong pullup
+ *        change to a trace hook, e.g. One_wire_trace::record_to().
+ *
+ * The hook is shared by every bus driven by this driver and is called after
+ * the event, outside the critical sections of the slots. onewire_measure() is
+ * not reported.
+ *
+ * @param hook     Trace hook, NULL stops the trace
+ * @param context  Passed to the hook
+ */
+void onewire_set_trace_hook(One_wire_trace_hook hook, void *context);
+
+/**
+ * @brief Hold the trace events until onewire_flush_trace(), so the hook is not
+ *        called in a critical section of the caller.
+ *
+ * E.g. onewire_write_power() writes a byte and turns the strong pullup on
+ * with interrupts masked. Up to 4 events are held, the rest are dropped.
+ */
+void onewire_defer_trace(void);
+
+/**
+ * @brief Report the events held since onewire_defer_trace(), in order, and
+ *        report the next ones as they happen.
+ */
+void onewire_flush_trace(void);
+
+#endif //ONE_WIRE_TRACE
+
+#if defined(ONE_WIRE_BUS_STATS)
+
+/**
+ * @brief Copy the bus counters.
+ *
+ * The counters are shared by every bus driven by this driver. Critical
+ * sections are timed from the outermost enter to the matching exit, so the
+ * whole byte of onewire_write_power() counts as one section.
+ *
+ * @param stats  Destination of the counters
+ */
+void onewire_get_stats(One_wire_bus_stats *stats);
+
+/**
+ * @brief Set every bus counter to zero.
+ */
+void onewire_clear_stats(void);
+
+/**
+ * @brief Count a CRC failure detected by a device driver.
+ */
+void onewire_stats_count_crc_failure(void);
+
+/**
+ * @brief Mark the start of a critical section entered by a device driver.
+ */
+void onewire_stats_enter_critical(void);
+
+/**
+ * @brief Mark the end of a critical section entered by a device driver.
+ */
+void onewire_stats_exit_critical(void);
+
+#endif //ONE_WIRE_BUS_STATS
+
 #ifdef __cplusplus
 }
 #endif
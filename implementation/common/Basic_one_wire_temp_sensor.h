@@ -0,0 +1,397 @@
+#pragma once
+#include "One_wire_types.h"
+#include "Conversion_time.h"
+#include "Bus_snapshot.h"
+#include "Known_bus.h"
+#include "Light_sleeper.h"
+#include "Rom_channel_map.h"
+#include "Slot_timing_calibration.h"
+#if defined(ONE_WIRE_BUS_STATS)
+    #include "One_wire_bus_stats.h"
+#endif
+#if defined(ONE_WIRE_TRACE)
+    #include "One_wire_trace.h"
+#endif
+#include <stdint.h>
+
+// The sensor over a backend policy. An instance only holds the members of its backend, so
+// sensors of both backends can live in one program.
+//
+// Not thread safe, even the const methods drive the bus. Let one task own the sensor and share
+// its readings with other tasks through Latest_readings.
+//
+// A backend provides:
+//   typedef ... Bus;                             what the sensor is built from, e.g. the GPIO or a transport
+//   Backend(Bus bus, Bus_snapshot_store* snapshot_store);       warm start if the snapshot loads and a device is present
+//   Backend(Bus bus, const Known_bus& known_bus);               the known devices if a device is present, never searched
+//   bool is_search_deferred() const;             true after a warm start, until the bus is searched
+//   void search_devices();                       searches the bus and reads the power mode and resolution of each device
+//   void rescan_devices();                       searches the bus again, as search_devices()
+//   bool get_snapshot(Bus_snapshot* snapshot) const;     false if it does not hold every device found
+//   uint8_t get_device_count() const;            the devices of the last search, the bus is not searched
+//   void get_device_address_on_index(Device_address address_to_get, uint8_t index) const;
+//   uint8_t scan_devices_of_family(uint8_t family_id, Device_address* addresses_found, uint8_t max_addresses);
+//   uint8_t get_resolution() const;
+//   bool set_resolution(uint8_t new_resolution);          false if a device was not set, the resolution is kept then
+//   uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const;    datasheet time of the devices found
+//   bool is_parasite_powered() const;
+//   void start_conversion();                              Convert T, with the strong pullup on parasite buses
+//   bool start_conversion_of(const Device_address address);   Convert T on one device, without strong pullup,
+//                                                             false for a parasite powered device
+//   void convert_BLOCKING(uint16_t millis_to_wait);       returns with the conversion done and the bus released
+//   bool is_conversion_time_over(uint16_t millis_to_wait);
+//   bool poll_conversion();                               read slot, not allowed while the bus is held high
+//   void depower();
+//   bool read_celsius(const Device_address address, float* temperature_in_celsius, const Read_retry_policy& policy) const;
+//   bool measure_bus(One_wire_bus_measurement* measurement);  rise time and presence pulse, resets the devices
+//   One_wire_slot_timing get_slot_timing() const;
+//   void set_slot_timing(const One_wire_slot_timing& timing);
+//   uint32_t get_micros() const;
+//   uint32_t get_micros_at_conversion_request() const;    0 if the conversion was not requested with start_conversion
+//   One_wire_bus_stats get_bus_stats() const;             with ONE_WIRE_BUS_STATS
+//   void clear_bus_stats();                               with ONE_WIRE_BUS_STATS
+//   void set_trace(One_wire_trace* trace);                with ONE_WIRE_TRACE, nullptr stops the trace
+template <class Backend>
+class Basic_one_wire_temp_sensor {
+public:
+    // With a snapshot store the devices, resolution and power mode of the last search are loaded at boot
+    // and the bus is only checked for presence. Complete the deferred search when the bus is idle
+    explicit Basic_one_wire_temp_sensor(typename Backend::Bus bus, Bus_snapshot_store* snapshot_store = nullptr)
+        : backend(bus, snapshot_store), snapshot_store(snapshot_store) {
+        if (!backend.is_search_deferred())
+            save_snapshot();
+    }
+
+    // The devices, resolution and power mode are taken from a table built with the firmware, and the bus
+    // is only checked for presence at boot. Without a presence pulse the bus is searched as usual
+    Basic_one_wire_temp_sensor(typename Backend::Bus bus, const Known_bus& known_bus)
+        : backend(bus, known_bus), snapshot_store(nullptr) {}
+
+    Basic_one_wire_temp_sensor(const Basic_one_wire_temp_sensor&) = delete;
+    Basic_one_wire_temp_sensor& operator=(const Basic_one_wire_temp_sensor&) = delete;
+
+    bool is_search_deferred() const {
+        return backend.is_search_deferred();
+    }
+
+    // Searches the bus and saves the snapshot if it changed. Returns true if it changed, e.g. a device was replaced
+    bool complete_deferred_search() {
+        backend.search_devices();
+        return save_snapshot();
+    }
+
+    // Searches the bus again, e.g. after a device was hot plugged, and saves the snapshot if it changed.
+    // Returns true if the snapshot changed
+    bool rescan_devices() {
+        backend.rescan_devices();
+        return save_snapshot();
+    }
+
+    // The devices found by the last search, see rescan_devices()
+    uint8_t get_device_count() const {
+        return backend.get_device_count();
+    }
+
+    void get_device_address_on_index(Device_address address_to_get, uint8_t index) const {
+        backend.get_device_address_on_index(address_to_get, index);
+    }
+
+    // Names the devices by the channels of a map generated at build time, see Rom_channel_map. nullptr removes it
+    void set_rom_channel_map(const Rom_channel_map* map) {
+        rom_channel_map = map;
+    }
+
+    // The channel of the device found at index, ROM_CHANNEL_NONE if it is out of the map or there is no map
+    uint16_t get_channel_on_index(uint8_t index) const {
+        if (rom_channel_map == nullptr)
+            return ROM_CHANNEL_NONE;
+        Device_address address;
+        backend.get_device_address_on_index(address, index);
+        return get_rom_channel(*rom_channel_map, address);
+    }
+
+    // Finds up to max_addresses devices of one family, e.g. DS2408 or DS2438 sharing the bus.
+    // Other families are pruned during the search. Returns the number of addresses written
+    uint8_t scan_devices_of_family(uint8_t family_id, Device_address* addresses_found, uint8_t max_addresses) {
+        return backend.scan_devices_of_family(family_id, addresses_found, max_addresses);
+    }
+
+    uint8_t get_resolution() const {
+        return backend.get_resolution();
+    }
+
+    // Returns false if the resolution is out of 9 to 12 bits or a device was not set
+    bool set_resolution(uint8_t new_resolution) {
+        bool is_set = backend.set_resolution(new_resolution);
+        save_snapshot();
+        return is_set;
+    }
+
+    void request_temperatures() {
+        backend.start_conversion();
+        is_waiting_sample = true;
+    }
+
+    // Convert T with Match ROM on each device, the others keep their scratchpads and can be read meanwhile,
+    // see Pipelined_sampler. Wait the conversion time before reading them, is_sample_available() tracks
+    // request_temperatures() only. Returns false if Convert T was not sent to a device, parasite powered
+    // devices are never started, they need the strong pullup of request_temperatures()
+    bool request_temperatures_of(const Device_address* addresses, uint8_t device_count) {
+        bool is_every_conversion_started = true;
+        for (uint8_t i = 0; i < device_count; ++i)
+            if (!backend.start_conversion_of(addresses[i]))
+                is_every_conversion_started = false;
+        return is_every_conversion_started;
+    }
+
+    void request_temperature_BLOCKING() {
+        is_waiting_sample = false;
+        _is_sample_available = true;
+        backend.convert_BLOCKING(get_millis_to_wait_for_conversion(backend.get_resolution()));
+    }
+
+    // Requests the temperatures, sleeps through the conversion time and reads every address in one burst, so
+    // the CPU is only awake for the request and the reads. If the sleep ends early, it sleeps LIGHT_SLEEP_POLL_US
+    // at a time until the sample is available, for up to another conversion time. A failed read leaves
+    // TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS in temperatures. Returns the number of temperatures read
+    uint8_t acquire_temperatures(const Device_address* addresses, uint8_t device_count, float* temperatures, Light_sleeper& sleeper) {
+        request_temperatures();
+        uint32_t conversion_us = 1000*(uint32_t)get_millis_to_wait_for_conversion(backend.get_resolution());
+        sleeper.sleep_us(conversion_us);
+        uint32_t woken_us = backend.get_micros();
+        bool is_available = is_sample_available();
+        while (!is_available && backend.get_micros() - woken_us < conversion_us) {
+            sleeper.sleep_us(LIGHT_SLEEP_POLL_US);
+            is_available = is_sample_available();
+        }
+
+        uint8_t temperatures_read = 0;
+        for (uint8_t i = 0; i < device_count; ++i) {
+            temperatures[i] = TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS;
+            if (is_available && read_temperature_in_celsius(addresses[i], &temperatures[i]))
+                ++temperatures_read;
+        }
+        return temperatures_read;
+    }
+
+    // Returns TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS if the read fails
+    float get_temperature_in_celsius(const Device_address address) const {
+        float temperature;
+        if (!read_temperature_in_celsius(address, &temperature))
+            return TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS;
+        return temperature;
+    }
+
+    // Returns false if the sensor did not answer with a valid scratchpad on any attempt of the retry policy
+    bool read_temperature_in_celsius(const Device_address address, float* temperature_in_celsius) const {
+        uint32_t read_start_us = read_latency_listener != nullptr ? backend.get_micros() : 0;
+        float temperature;
+        if (!backend.read_celsius(address, &temperature, read_retry_policy))
+            return false;
+
+        if (read_latency_listener != nullptr) {
+            uint32_t read_end_us = backend.get_micros();
+            uint32_t request_us = backend.get_micros_at_conversion_request();
+            uint32_t request_to_data_us = request_us != 0 ? read_end_us - request_us : READ_LATENCY_UNKNOWN;
+            read_latency_listener->on_read_latency(address, request_to_data_us, read_end_us - read_start_us);
+        }
+        if (reading_listener != nullptr)
+            reading_listener->on_reading(address, temperature);
+
+        *temperature_in_celsius = temperature;
+        return true;
+    }
+
+    // Returns false if there is no map, the channel is out of it or the read fails
+    bool read_temperature_of_channel(uint16_t channel, float* temperature_in_celsius) const {
+        if (rom_channel_map == nullptr || channel >= rom_channel_map->channel_count)
+            return false;
+        return read_temperature_in_celsius(rom_channel_map->roms[channel], temperature_in_celsius);
+    }
+
+    // Reads the devices found by the last search into temperatures by channel, the bus is not searched again,
+    // call rescan_devices() for devices added since. Devices out of the map are not read, and channels of devices on other buses are not written, so the
+    // sensors of every bus can fill one array. A failed read leaves its channel as it was. Returns the number
+    // of temperatures read
+    uint16_t read_temperatures_by_channel(float* temperatures, uint16_t channel_count) {
+        if (rom_channel_map == nullptr)
+            return 0;
+        uint16_t temperatures_read = 0;
+        uint8_t device_count = backend.get_device_count();
+        for (uint8_t i = 0; i < device_count; ++i) {
+            Device_address address;
+            backend.get_device_address_on_index(address, i);
+            uint16_t channel = get_rom_channel(*rom_channel_map, address);
+            if (channel < channel_count && read_temperature_in_celsius(address, &temperatures[channel]))
+                ++temperatures_read;
+        }
+        return temperatures_read;
+    }
+
+    // Only the failing sensor is read again, the conversion is not requested again
+    void set_read_retry_policy(const Read_retry_policy& policy) {
+        if (policy.max_attempts == 0)
+            return;
+        read_retry_policy = policy;
+    }
+
+    // The calibrated time at the resolution of the last calibration, the datasheet time otherwise
+    uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const {
+        if (calibrated_millis_to_wait != 0 && resolution == calibrated_resolution)
+            return calibrated_millis_to_wait;
+        return backend.get_millis_to_wait_for_conversion(resolution);
+    }
+
+    // Converts on every device alone, polling with read slots, and records in table how long it took.
+    // Afterwards the sensor waits for the slowest device plus the table margin instead of the datasheet time.
+    // Blocks up to the datasheet time per device. Returns false on parasite powered buses, which can not
+    // be polled while converting, and if a device did not finish or did not fit in the table.
+    // Calibrate again if devices are replaced
+    bool calibrate_conversion_time(Conversion_time_table* table) {
+        calibrated_millis_to_wait = 0;
+        if (backend.is_parasite_powered())
+            return false;
+
+        uint8_t resolution = backend.get_resolution();
+        uint32_t max_us = 1000*(uint32_t)backend.get_millis_to_wait_for_conversion(resolution);
+        uint16_t millis_to_wait = 0;
+        uint8_t device_count = backend.get_device_count();
+        for (uint8_t i = 0; i < device_count; ++i) {
+            Device_address address;
+            backend.get_device_address_on_index(address, i);
+            if (!backend.start_conversion_of(address))
+                return false;
+            uint32_t start_us = backend.get_micros();
+            uint32_t elapsed_us = 0;
+            bool is_done = false;
+            while (!is_done && elapsed_us <= max_us) {
+                is_done = backend.poll_conversion();
+                elapsed_us = backend.get_micros() - start_us;
+            }
+            if (!is_done || !table->record(address, resolution, elapsed_us))
+                return false;
+            uint16_t device_millis_to_wait = table->get_millis_to_wait(address, resolution);
+            if (device_millis_to_wait > millis_to_wait)
+                millis_to_wait = device_millis_to_wait;
+        }
+        calibrated_resolution = resolution;
+        calibrated_millis_to_wait = millis_to_wait;
+        return device_count > 0;
+    }
+
+    // Measures how fast the bus rises and when the devices answer the reset, and switches to the tightest
+    // safe slot timing for it. Then every device is read verify_reads times with the CRC checked and
+    // without retries. Keeps the previous timing if the bus is out of spec, no device is found or a read
+    // fails. On the ESP-IDF backend the timing is shared by every bus, calibrate on the slowest one
+    bool calibrate_slot_timing(uint8_t verify_reads = 8) {
+        One_wire_slot_timing previous_timing = backend.get_slot_timing();
+        One_wire_bus_measurement measurement;
+        One_wire_slot_timing calibrated_timing;
+        if (!backend.measure_bus(&measurement) || !::calibrate_slot_timing(measurement, previous_timing, &calibrated_timing))
+            return false;
+        uint8_t device_count = backend.get_device_count();
+        if (device_count == 0)
+            return false;
+
+        backend.set_slot_timing(calibrated_timing);
+        const Read_retry_policy SINGLE_ATTEMPT = {1, 0, 0, false};
+        for (uint8_t read = 0; read < verify_reads; ++read) {
+            for (uint8_t i = 0; i < device_count; ++i) {
+                Device_address address;
+                float temperature;
+                backend.get_device_address_on_index(address, i);
+                if (!backend.read_celsius(address, &temperature, SINGLE_ATTEMPT)) {
+                    backend.set_slot_timing(previous_timing);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Without parasite powered devices the conversion is polled and the sample can be available
+    // before the conversion time. With them the bus is held high until the conversion time is over
+    bool is_sample_available() {
+        if (is_waiting_sample)
+            return is_time_to_enable_sample();
+        else
+            return _is_sample_available;
+    }
+
+    // True if any device needs the strong pullup, detected when the bus is scanned
+    bool is_parasite_powered() const {
+        return backend.is_parasite_powered();
+    }
+
+    void set_reading_listener(Reading_listener* listener) {
+        reading_listener = listener;
+    }
+
+    // Reports the request-to-data and scratchpad read time of every successful read
+    void set_read_latency_listener(Read_latency_listener* listener) {
+        read_latency_listener = listener;
+    }
+
+#if defined(ONE_WIRE_BUS_STATS)
+    One_wire_bus_stats get_bus_stats() const {
+        return backend.get_bus_stats();
+    }
+
+    void clear_bus_stats() {
+        backend.clear_bus_stats();
+    }
+#endif
+
+#if defined(ONE_WIRE_TRACE)
+    // Records every reset, byte and bit on the bus in trace, nullptr stops it.
+    // On the ESP-IDF backend one trace records every bus
+    void set_trace(One_wire_trace* trace) {
+        backend.set_trace(trace);
+    }
+#endif
+
+private:
+    Backend backend;
+    Bus_snapshot_store* snapshot_store;
+
+    Reading_listener* reading_listener = nullptr;
+    Read_latency_listener* read_latency_listener = nullptr;
+    Read_retry_policy read_retry_policy = {1, 0, 0, false};
+    const Rom_channel_map* rom_channel_map = nullptr;
+
+    bool is_waiting_sample = false;
+    bool _is_sample_available = false;
+
+    uint8_t calibrated_resolution = 0;
+    uint16_t calibrated_millis_to_wait = 0;
+
+    // Saves only when the snapshot differs from the stored one, so the flash is not worn
+    bool save_snapshot() {
+        if (snapshot_store == nullptr)
+            return false;
+        Bus_snapshot snapshot;
+        Bus_snapshot stored_snapshot;
+        // A snapshot missing devices would hide them after a warm start, the next boot searches the bus instead
+        if (!backend.get_snapshot(&snapshot))
+            return false;
+        if (snapshot_store->load(&stored_snapshot) && stored_snapshot == snapshot)
+            return false;
+        snapshot_store->save(snapshot);
+        return true;
+    }
+
+    bool is_time_to_enable_sample() {
+        bool has_parasite_devices = backend.is_parasite_powered();
+        bool is_conversion_done = backend.is_conversion_time_over(get_millis_to_wait_for_conversion(backend.get_resolution()));
+        if (!is_conversion_done && !has_parasite_devices)
+            is_conversion_done = backend.poll_conversion();
+        if (!is_conversion_done)
+            return false;
+
+        if (has_parasite_devices)
+            backend.depower();
+        is_waiting_sample = false;
+        _is_sample_available = true;
+        return true;
+    }
+};
\ No newline at end of file
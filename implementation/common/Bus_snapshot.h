@@ -0,0 +1,95 @@
+#pragma once
+#include "One_wire_types.h"
+#include "One_wire_crc.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * BUS SNAPSHOT (version 1)
+ *
+ *  byte 0          : version
+ *  byte 1          : resolution
+ *  byte 2          : 1 if any device is parasite powered
+ *  byte 3          : device count
+ *  8 bytes/device  : ROM code
+ *  last 2 bytes    : CRC16 of all the previous bytes, little endian
+ *
+ * What the sensor learns when it scans the bus at boot. With a stored snapshot the bus is only
+ * checked for presence at boot and the full search is deferred.
+ **/
+
+#define BUS_SNAPSHOT_VERSION 1
+#define BUS_SNAPSHOT_MAX_DEVICES ONE_WIRE_MAX_DEVICES
+#define BUS_SNAPSHOT_HEADER_SIZE 4
+#define BUS_SNAPSHOT_CRC_SIZE 2
+#define BUS_SNAPSHOT_SIZE(device_count) (BUS_SNAPSHOT_HEADER_SIZE + sizeof(Device_address)*(device_count) + BUS_SNAPSHOT_CRC_SIZE)
+#define BUS_SNAPSHOT_MAX_SIZE BUS_SNAPSHOT_SIZE(BUS_SNAPSHOT_MAX_DEVICES)
+
+struct Bus_snapshot {
+    uint8_t resolution;
+    bool has_parasite_devices;
+    uint8_t device_count;
+    Device_address addresses[BUS_SNAPSHOT_MAX_DEVICES];
+};
+
+inline bool operator==(const Bus_snapshot& a, const Bus_snapshot& b) {
+    return a.resolution == b.resolution && a.has_parasite_devices == b.has_parasite_devices &&
+           a.device_count == b.device_count && memcmp(a.addresses, b.addresses, sizeof(Device_address)*a.device_count) == 0;
+}
+
+inline bool operator!=(const Bus_snapshot& a, const Bus_snapshot& b) {
+    return !(a == b);
+}
+
+// Returns the snapshot length, 0 if it does not fit in the buffer
+inline size_t encode_bus_snapshot(const Bus_snapshot& snapshot, uint8_t* buffer, size_t buffer_size) {
+    if (snapshot.device_count > BUS_SNAPSHOT_MAX_DEVICES || buffer_size < BUS_SNAPSHOT_SIZE(snapshot.device_count))
+        return 0;
+    buffer[0] = BUS_SNAPSHOT_VERSION;
+    buffer[1] = snapshot.resolution;
+    buffer[2] = snapshot.has_parasite_devices ? 1 : 0;
+    buffer[3] = snapshot.device_count;
+    size_t length = BUS_SNAPSHOT_HEADER_SIZE;
+    for (uint8_t i = 0; i < snapshot.device_count; ++i) {
+        memcpy(&buffer[length], snapshot.addresses[i], sizeof(Device_address));
+        length += sizeof(Device_address);
+    }
+    uint16_t crc = one_wire_crc16(buffer, length);
+    buffer[length++] = crc & 0xFF;
+    buffer[length++] = crc >> 8;
+    return length;
+}
+
+// Rejects other versions, a wrong length or CRC and ROM codes with a wrong CRC8
+inline bool decode_bus_snapshot(const uint8_t* buffer, size_t length, Bus_snapshot* snapshot) {
+    if (length < BUS_SNAPSHOT_SIZE(0) || buffer[0] != BUS_SNAPSHOT_VERSION)
+        return false;
+    uint8_t device_count = buffer[3];
+    if (device_count > BUS_SNAPSHOT_MAX_DEVICES || length != BUS_SNAPSHOT_SIZE(device_count))
+        return false;
+    size_t crc_index = length - BUS_SNAPSHOT_CRC_SIZE;
+    uint16_t crc = buffer[crc_index] | (uint16_t)buffer[crc_index + 1] << 8;
+    if (one_wire_crc16(buffer, crc_index) != crc)
+        return false;
+    for (uint8_t i = 0; i < device_count; ++i) {
+        const uint8_t* address = &buffer[BUS_SNAPSHOT_HEADER_SIZE + sizeof(Device_address)*i];
+        if (one_wire_crc8(address, 7) != address[7])
+            return false;
+    }
+
+    snapshot->resolution = buffer[1];
+    snapshot->has_parasite_devices = buffer[2] != 0;
+    snapshot->device_count = device_count;
+    memcpy(snapshot->addresses, &buffer[BUS_SNAPSHOT_HEADER_SIZE], sizeof(Device_address)*device_count);
+    return true;
+}
+
+// Where a sensor keeps its snapshot across reboots, one store per bus
+class Bus_snapshot_store {
+public:
+    virtual ~Bus_snapshot_store() {}
+    // Returns false if there is no valid snapshot
+    virtual bool load(Bus_snapshot* snapshot) = 0;
+    virtual bool save(const Bus_snapshot& snapshot) = 0;
+};
\ No newline at end of file
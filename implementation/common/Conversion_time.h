@@ -0,0 +1,95 @@
+#pragma once
+#include "One_wire_types.h"
+#include <stdint.h>
+#include <string.h>
+
+#define MIN_RESOLUTION_BITS 9
+#define MAX_RESOLUTION_BITS 12
+
+// Datasheet worst case in milliseconds, by resolution from 9 to 12 bits
+static constexpr uint16_t DS18B20_CONVERSION_MILLIS[] = {94, 188, 375, 750};
+// The DS18S20 always converts at full resolution and extends it from the count registers
+static constexpr uint16_t DS18S20_CONVERSION_MILLIS[] = {750, 750, 750, 750};
+
+// Datasheet worst case conversion time. Resolutions out of range take the 12 bits time and
+// families without a row, like the DS1822, DS1825 and DS28EA00, convert like the DS18B20
+constexpr uint16_t get_max_conversion_millis(uint8_t family_id, uint8_t resolution) {
+    return resolution < MIN_RESOLUTION_BITS || resolution > MAX_RESOLUTION_BITS ? get_max_conversion_millis(family_id, MAX_RESOLUTION_BITS)
+         : family_id == DS18S20_FAMILY_ID ? DS18S20_CONVERSION_MILLIS[resolution - MIN_RESOLUTION_BITS]
+         : DS18B20_CONVERSION_MILLIS[resolution - MIN_RESOLUTION_BITS];
+}
+
+static_assert(get_max_conversion_millis(DS18B20_FAMILY_ID, 9) == 94, "DS18B20 converts 9 bits in 93.75 ms");
+static_assert(get_max_conversion_millis(DS18S20_FAMILY_ID, 9) == 750, "DS18S20 always takes 750 ms");
+
+// Conversion times learned by polling every device with read slots. Real devices are usually
+// much faster than the datasheet, so waiting the learned time plus a margin shortens every sample
+class Conversion_time_table {
+public:
+    static const uint8_t MAX_DEVICES = ONE_WIRE_MAX_DEVICES;
+
+    explicit Conversion_time_table(uint8_t margin_percent = 10) : margin_percent(margin_percent) {
+    }
+
+    // Keeps the slowest time seen for the device. A time learned at other resolution is replaced.
+    // Returns false if the table is full
+    bool record(const Device_address address, uint8_t resolution, uint32_t observed_us) {
+        Entry* entry = find(address);
+        if (entry == nullptr) {
+            if (entry_count == MAX_DEVICES)
+                return false;
+            entry = &entries[entry_count++];
+            memcpy(entry->address, address, sizeof(Device_address));
+            entry->resolution = resolution;
+            entry->observed_us = 0;
+        }
+        if (entry->resolution != resolution) {
+            entry->resolution = resolution;
+            entry->observed_us = 0;
+        }
+        if (observed_us > entry->observed_us)
+            entry->observed_us = observed_us;
+        return true;
+    }
+
+    // The learned time plus the margin, never longer than the datasheet. The datasheet time if
+    // the device was not learned at that resolution
+    uint16_t get_millis_to_wait(const Device_address address, uint8_t resolution) const {
+        uint16_t max_millis = get_max_conversion_millis(address[0], resolution);
+        const Entry* entry = find(address);
+        if (entry == nullptr || entry->resolution != resolution)
+            return max_millis;
+        uint32_t millis = (entry->observed_us*(100 + margin_percent)/100 + 999)/1000;
+        return millis < max_millis ? (uint16_t)millis : max_millis;
+    }
+
+    uint8_t get_device_count() const {
+        return entry_count;
+    }
+
+    void clear() {
+        entry_count = 0;
+    }
+
+private:
+    struct Entry {
+        Device_address address;
+        uint8_t resolution;
+        uint32_t observed_us;
+    };
+
+    Entry entries[MAX_DEVICES];
+    uint8_t entry_count = 0;
+    uint8_t margin_percent;
+
+    Entry* find(const Device_address address) {
+        return const_cast<Entry*>(static_cast<const Conversion_time_table*>(this)->find(address));
+    }
+
+    const Entry* find(const Device_address address) const {
+        for (uint8_t i = 0; i < entry_count; ++i)
+            if (memcmp(entries[i].address, address, sizeof(Device_address)) == 0)
+                return &entries[i];
+        return nullptr;
+    }
+};
\ No newline at end of file
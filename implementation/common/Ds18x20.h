@@ -0,0 +1,152 @@
+#pragma once
+#include "One_wire_transport.h"
+
+#define DS18X20_CONVERT_T 0x44
+#define DS18X20_WRITE_SCRATCHPAD 0x4E
+#define DS18X20_READ_SCRATCHPAD 0xBE
+#define DS18X20_COPY_SCRATCHPAD 0x48
+#define DS18X20_RECALL_E2 0xB8
+#define DS18X20_READ_POWER_SUPPLY 0xB4
+
+#define DS18X20_SCRATCHPAD_SIZE 9
+#define DS18X20_SCRATCHPAD_TH 2
+#define DS18X20_SCRATCHPAD_TL 3
+#define DS18X20_SCRATCHPAD_CONFIG 4
+#define DS18X20_SCRATCHPAD_CRC 8
+
+#define DS18X20_MIN_RESOLUTION 9
+#define DS18X20_MAX_RESOLUTION 12
+#define DS18X20_CONFIG_RESOLUTION_SHIFT 5
+#define DS18X20_CONFIG_RESOLUTION_MASK 0x60
+#define DS18X20_COPY_SCRATCHPAD_MS 10
+
+// Searched by Ds18x20::scan_devices(), in this order
+static constexpr uint8_t DS18X20_FAMILY_IDS[] = {
+    DS18B20_FAMILY_ID, DS18S20_FAMILY_ID, DS1822_FAMILY_ID, DS1825_FAMILY_ID, DS28EA00_FAMILY_ID
+};
+
+/**
+ * DS18x20 device logic over any One_wire_transport. A null address
+ * addresses every device on the bus with SKIP ROM.
+ **/
+template <typename Transport>
+class Ds18x20 {
+public:
+    explicit Ds18x20(Transport& bus) : bus(bus) {
+    }
+
+    // Starts a conversion. With the strong pullup the bus is driven high right after Convert T, as
+    // parasite powered devices need, call depower() once the conversion time has elapsed
+    One_wire_status measure(const Device_address address, bool use_strong_pullup) {
+        One_wire_status status = address_device(address);
+        if (status != ONE_WIRE_OK)
+            return status;
+        bool is_written = use_strong_pullup ? bus.write_byte_and_strong_pullup(DS18X20_CONVERT_T) : bus.write_byte(DS18X20_CONVERT_T);
+        return is_written ? ONE_WIRE_OK : ONE_WIRE_BUS_ERROR;
+    }
+
+    // A read slot after measure() without the strong pullup. Externally powered devices hold it low
+    // while they convert
+    One_wire_status poll_measure(bool* is_done) {
+        return bus.read_bit(is_done) ? ONE_WIRE_OK : ONE_WIRE_BUS_ERROR;
+    }
+
+    void depower() {
+        bus.strong_pullup(false);
+    }
+
+    One_wire_status read_scratchpad(const Device_address address, uint8_t* scratchpad) {
+        One_wire_status status = address_device(address);
+        if (status != ONE_WIRE_OK)
+            return status;
+        if (!bus.write_byte(DS18X20_READ_SCRATCHPAD) || !bus.read_bytes(scratchpad, DS18X20_SCRATCHPAD_SIZE))
+            return ONE_WIRE_BUS_ERROR;
+        if (one_wire_crc8(scratchpad, DS18X20_SCRATCHPAD_CRC) != scratchpad[DS18X20_SCRATCHPAD_CRC])
+            return ONE_WIRE_CRC_ERROR;
+        return ONE_WIRE_OK;
+    }
+
+    // Writes TH, TL and the configuration register
+    One_wire_status write_scratchpad(const Device_address address, const uint8_t* th_tl_config) {
+        One_wire_status status = address_device(address);
+        if (status != ONE_WIRE_OK)
+            return status;
+        uint8_t command[4] = {DS18X20_WRITE_SCRATCHPAD, th_tl_config[0], th_tl_config[1], th_tl_config[2]};
+        if (!bus.write_bytes(command, sizeof(command)))
+            return ONE_WIRE_BUS_ERROR;
+        return ONE_WIRE_OK;
+    }
+
+    // Drives the bus high for the EEPROM write. Call depower() after DS18X20_COPY_SCRATCHPAD_MS
+    One_wire_status copy_scratchpad(const Device_address address) {
+        One_wire_status status = address_device(address);
+        if (status != ONE_WIRE_OK)
+            return status;
+        if (!bus.write_byte_and_strong_pullup(DS18X20_COPY_SCRATCHPAD))
+            return ONE_WIRE_BUS_ERROR;
+        return ONE_WIRE_OK;
+    }
+
+    // Parasite powered devices pull the read slot low, with a null address it tells if any does
+    One_wire_status read_power_supply(const Device_address address, bool* is_parasite_powered) {
+        One_wire_status status = address_device(address);
+        if (status != ONE_WIRE_OK)
+            return status;
+        bool bit;
+        if (!bus.write_byte(DS18X20_READ_POWER_SUPPLY) || !bus.read_bit(&bit))
+            return ONE_WIRE_BUS_ERROR;
+        *is_parasite_powered = !bit;
+        return ONE_WIRE_OK;
+    }
+
+    One_wire_status read_temperature(const Device_address address, float* temperature_in_celsius) {
+        uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+        One_wire_status status = read_scratchpad(address, scratchpad);
+        if (status != ONE_WIRE_OK)
+            return status;
+        bool is_ds18s20 = address != nullptr && address[0] == DS18S20_FAMILY_ID;
+        *temperature_in_celsius = get_celsius_FROM_scratchpad(scratchpad, is_ds18s20);
+        return ONE_WIRE_OK;
+    }
+
+    // Returns the number of DS18x20 devices found, at most max_addresses, grouped by family. Every family
+    // is searched alone, so the ROM codes of other devices sharing the bus, e.g. DS2408, are never clocked
+    // in full. A family without devices costs at most 8 search steps, a bus without presence one reset
+    size_t scan_devices(Device_address* addresses, size_t max_addresses) {
+        if (!bus.reset())
+            return 0;
+        size_t devices_found = 0;
+        for (uint8_t family_id : DS18X20_FAMILY_IDS)
+            devices_found += scan_devices_of_family(family_id, &addresses[devices_found], max_addresses - devices_found);
+        return devices_found;
+    }
+
+    // Only devices of the family are found, e.g. DS2408 or DS2438 sharing the bus
+    size_t scan_devices_of_family(uint8_t family_id, Device_address* addresses, size_t max_addresses) {
+        One_wire_search_state state;
+        bus.search_family(&state, family_id);
+        size_t devices_found = 0;
+        while (devices_found < max_addresses && bus.search_next(&state, addresses[devices_found]))
+            ++devices_found;
+        return devices_found;
+    }
+
+    static float get_celsius_FROM_scratchpad(const uint8_t* scratchpad, bool is_ds18s20) {
+        int16_t raw = (int16_t)(scratchpad[1] << 8 | scratchpad[0]);
+        if (!is_ds18s20)
+            return raw / 16.0f;
+        // Extended resolution from COUNT_REMAIN, COUNT_PER_C is 16
+        raw = ((raw & 0xFFFE) << 3) + (16 - scratchpad[6]) - 4;
+        return raw / 16.0f;
+    }
+
+private:
+    Transport& bus;
+
+    One_wire_status address_device(const Device_address address) {
+        if (!bus.reset())
+            return ONE_WIRE_NO_PRESENCE;
+        bool is_addressed = address == nullptr ? bus.skip_rom() : bus.select(address);
+        return is_addressed ? ONE_WIRE_OK : ONE_WIRE_BUS_ERROR;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "Ds2482_transport.h"
+
+Ds2482_transport::Ds2482_transport(I2c_port& port) : port(port) {
+}
+
+bool Ds2482_transport::begin() {
+    uint8_t status;
+    if (!send_command(DS2482_DEVICE_RESET, nullptr) || !wait_while_busy(&status))
+        return false;
+    // The upper nibble is the complement of the configuration
+    uint8_t config = DS2482_CONFIG_ACTIVE_PULLUP | (uint8_t)((~DS2482_CONFIG_ACTIVE_PULLUP & 0x0F) << 4);
+    return send_command(DS2482_WRITE_CONFIG, &config);
+}
+
+bool Ds2482_transport::reset() {
+    uint8_t status;
+    if (!send_command(DS2482_ONE_WIRE_RESET, nullptr) || !wait_while_busy(&status))
+        return false;
+    return (status & DS2482_STATUS_PRESENCE) && !(status & DS2482_STATUS_SHORT);
+}
+
+bool Ds2482_transport::write_bytes(const uint8_t* bytes, size_t count) {
+    uint8_t status;
+    for (size_t i = 0; i < count; ++i)
+        if (!send_command(DS2482_ONE_WIRE_WRITE_BYTE, &bytes[i]) || !wait_while_busy(&status))
+            return false;
+    return true;
+}
+
+bool Ds2482_transport::read_bytes(uint8_t* bytes, size_t count) {
+    uint8_t status;
+    const uint8_t data_register = DS2482_DATA_REGISTER;
+    for (size_t i = 0; i < count; ++i) {
+        if (!send_command(DS2482_ONE_WIRE_READ_BYTE, nullptr) || !wait_while_busy(&status))
+            return false;
+        if (!send_command(DS2482_SET_READ_POINTER, &data_register) || !port.read(&bytes[i], 1))
+            return false;
+    }
+    return true;
+}
+
+bool Ds2482_transport::write_bit(bool bit) {
+    uint8_t status;
+    const uint8_t bit_parameter = bit ? 0x80 : 0x00;
+    return send_command(DS2482_ONE_WIRE_SINGLE_BIT, &bit_parameter) && wait_while_busy(&status);
+}
+
+bool Ds2482_transport::read_bit(bool* bit) {
+    uint8_t status;
+    const uint8_t read_slot = 0x80;
+    if (!send_command(DS2482_ONE_WIRE_SINGLE_BIT, &read_slot) || !wait_while_busy(&status))
+        return false;
+    *bit = (status & DS2482_STATUS_SINGLE_BIT) != 0;
+    return true;
+}
+
+bool Ds2482_transport::triplet(bool* id_bit, bool* complement_bit, bool* direction) {
+    uint8_t status;
+    const uint8_t direction_parameter = *direction ? 0x80 : 0x00;
+    if (!send_command(DS2482_ONE_WIRE_TRIPLET, &direction_parameter) || !wait_while_busy(&status))
+        return false;
+    *id_bit = (status & DS2482_STATUS_SINGLE_BIT) != 0;
+    *complement_bit = (status & DS2482_STATUS_TRIPLET_SECOND_BIT) != 0;
+    *direction = (status & DS2482_STATUS_DIRECTION) != 0;
+    return true;
+}
+
+bool Ds2482_transport::strong_pullup(bool enable) {
+    return !enable;
+}
+
+bool Ds2482_transport::send_command(uint8_t command, const uint8_t* parameter) {
+    uint8_t bytes[2] = {command, parameter ? *parameter : (uint8_t)0};
+    return port.write(bytes, parameter ? 2 : 1);
+}
+
+// After a command the read pointer is on the status register
+bool Ds2482_transport::wait_while_busy(uint8_t* status) {
+    for (uint8_t i = 0; i < MAX_BUSY_POLLS; ++i) {
+        if (!port.read(status, 1))
+            return false;
+        if (!(*status & DS2482_STATUS_BUSY))
+            return true;
+    }
+    return false;
+}
\ No newline at end of file
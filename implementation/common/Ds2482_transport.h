@@ -0,0 +1,74 @@
+#pragma once
+#include "One_wire_transport.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * 1-Wire through a DS2482-100 I2C bridge. The bridge clocks the time slots
+ * itself, and its 1-Wire Triplet command runs a whole search step in one
+ * I2C transaction, so the search costs 64 commands per ROM instead of 192
+ * bit transfers.
+ **/
+
+#define DS2482_DEVICE_RESET 0xF0
+#define DS2482_SET_READ_POINTER 0xE1
+#define DS2482_WRITE_CONFIG 0xD2
+#define DS2482_ONE_WIRE_RESET 0xB4
+#define DS2482_ONE_WIRE_SINGLE_BIT 0x87
+#define DS2482_ONE_WIRE_WRITE_BYTE 0xA5
+#define DS2482_ONE_WIRE_READ_BYTE 0x96
+#define DS2482_ONE_WIRE_TRIPLET 0x78
+
+#define DS2482_STATUS_REGISTER 0xF0
+#define DS2482_DATA_REGISTER 0xE1
+
+#define DS2482_STATUS_BUSY 0x01
+#define DS2482_STATUS_PRESENCE 0x02
+#define DS2482_STATUS_SHORT 0x04
+#define DS2482_STATUS_SINGLE_BIT 0x20
+#define DS2482_STATUS_TRIPLET_SECOND_BIT 0x40
+#define DS2482_STATUS_DIRECTION 0x80
+
+#define DS2482_CONFIG_ACTIVE_PULLUP 0x01
+
+class I2c_port {
+public:
+    virtual ~I2c_port() {}
+
+    // Both return false if the bridge did not acknowledge
+    virtual bool write(const uint8_t* bytes, size_t length) = 0;
+    virtual bool read(uint8_t* bytes, size_t length) = 0;
+};
+
+class Ds2482_transport : public One_wire_transport<Ds2482_transport> {
+public:
+    explicit Ds2482_transport(I2c_port& port);
+
+    // Resets the bridge and enables its active pullup. Returns false if it does not answer
+    bool begin();
+
+    // Returns true if a device answered with a presence pulse
+    bool reset();
+
+    // Every function below returns false if the bridge did not answer or stayed busy
+    bool write_bytes(const uint8_t* bytes, size_t count);
+    bool read_bytes(uint8_t* bytes, size_t count);
+    bool write_bit(bool bit);
+    bool read_bit(bool* bit);
+
+    // Native search step, replaces the one of One_wire_transport
+    bool triplet(bool* id_bit, bool* complement_bit, bool* direction);
+
+    // The bridge arms its strong pullup before the byte that needs it, so it
+    // can not be turned on after a write. Parasite buses need an external one
+    bool strong_pullup(bool enable);
+
+private:
+    // A 1-Wire reset takes about 1.2 ms, more than 40 status reads at 400 kHz
+    static const uint8_t MAX_BUSY_POLLS = 100;
+
+    I2c_port& port;
+
+    bool send_command(uint8_t command, const uint8_t* parameter);
+    bool wait_while_busy(uint8_t* status);
+};
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include "Bus_snapshot.h"
+#include <stdio.h>
+
+// Keeps the snapshot in a file, for host builds or a mounted file system
+class File_bus_snapshot_store : public Bus_snapshot_store {
+public:
+    // The path must outlive the store
+    explicit File_bus_snapshot_store(const char* path) : path(path) {}
+
+    bool load(Bus_snapshot* snapshot) override {
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr)
+            return false;
+        uint8_t buffer[BUS_SNAPSHOT_MAX_SIZE + 1];
+        size_t length = fread(buffer, 1, sizeof(buffer), file);
+        fclose(file);
+        return decode_bus_snapshot(buffer, length, snapshot);
+    }
+
+    bool save(const Bus_snapshot& snapshot) override {
+        uint8_t buffer[BUS_SNAPSHOT_MAX_SIZE];
+        size_t length = encode_bus_snapshot(snapshot, buffer, sizeof(buffer));
+        if (length == 0)
+            return false;
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr)
+            return false;
+        bool is_written = fwrite(buffer, 1, length, file) == length;
+        return fclose(file) == 0 && is_written;
+    }
+
+private:
+    const char* path;
+};
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include "One_wire_types.h"
+#include "One_wire_crc.h"
+#include <stdint.h>
+#include <stddef.h>
+
+constexpr bool are_known_roms_valid(const Device_address* addresses, size_t count) {
+    return count == 0 || (constexpr_one_wire_crc8(addresses[0], 7) == addresses[0][7] &&
+                          are_known_roms_valid(addresses + 1, count - 1));
+}
+
+// The devices of a fixed installation, known when the firmware is built. The sensor takes them instead
+// of searching the bus and only checks for a presence pulse at boot. The sensor keeps a pointer to the
+// ROM codes, declare them and the bus constexpr, so they stay in flash and are checked by the compiler:
+//
+//   static constexpr Device_address ROMS[] = {{0x28, 0xFF, 0x4C, 0x6B, 0x71, 0x16, 0x05, 0x3A}, ...};
+//   static constexpr Known_bus KNOWN_BUS(ROMS, 12, false);
+//   static_assert(KNOWN_BUS.is_valid, "Known bus with a wrong ROM code");
+//   One_wire_temp_sensor sensor(PIN, KNOWN_BUS);
+//
+// Every ROM code must pass its CRC8, there can be up to ONE_WIRE_MAX_DEVICES and the resolution
+// must be the one the devices are configured with, from 9 to 12 bits. The sensor searches the bus
+// instead of taking an invalid one
+struct Known_bus {
+    template <size_t DEVICE_COUNT>
+    constexpr Known_bus(const Device_address (&addresses)[DEVICE_COUNT], uint8_t resolution, bool has_parasite_devices)
+        : addresses(addresses), device_count((uint8_t)DEVICE_COUNT), resolution(resolution),
+          has_parasite_devices(has_parasite_devices),
+          is_valid(DEVICE_COUNT <= ONE_WIRE_MAX_DEVICES && are_known_roms_valid(addresses, DEVICE_COUNT) &&
+                   resolution >= 9 && resolution <= 12) {}
+
+    const Device_address* addresses;
+    uint8_t device_count;
+    uint8_t resolution;
+    bool has_parasite_devices;
+    bool is_valid;
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "Latency_histogram.h"
+
+#define MAX_COUNT UINT16_MAX
+
+void Latency_histogram::add(uint32_t latency_us) {
+    uint8_t bucket = get_bucket_FROM_latency(latency_us);
+    if (counts[bucket] < MAX_COUNT)
+        ++counts[bucket];
+}
+
+uint16_t Latency_histogram::get_count(uint8_t bucket) const {
+    if (bucket >= BUCKETS)
+        return 0;
+    return counts[bucket];
+}
+
+uint32_t Latency_histogram::get_sample_count() const {
+    uint32_t sample_count = 0;
+    for (uint8_t i = 0; i < BUCKETS; ++i)
+        sample_count += counts[i];
+    return sample_count;
+}
+
+void Latency_histogram::reset() {
+    memset(counts, 0, sizeof(counts));
+}
+
+uint8_t Latency_histogram::get_bucket_FROM_latency(uint32_t latency_us) {
+    uint8_t bucket = 0;
+    while (latency_us > 1 && bucket < BUCKETS - 1) {
+        latency_us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint32_t Latency_histogram::get_bucket_lower_bound_us(uint8_t bucket) {
+    if (bucket == 0)
+        return 0;
+    return (uint32_t)1 << bucket;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include "One_wire_types.h"
+#include <string.h>
+
+/**
+ * Log-scale histogram of latencies in microseconds: bucket i counts the
+ * latencies in [2^i, 2^(i+1)) us. The first bucket also counts 0 us and the
+ * last one every latency above its lower bound. Counters saturate.
+ **/
+class Latency_histogram {
+public:
+    static const uint8_t BUCKETS = 24;
+
+    void add(uint32_t latency_us);
+    uint16_t get_count(uint8_t bucket) const;
+    uint32_t get_sample_count() const;
+    void reset();
+
+    static uint8_t get_bucket_FROM_latency(uint32_t latency_us);
+    static uint32_t get_bucket_lower_bound_us(uint8_t bucket);
+
+private:
+    uint16_t counts[BUCKETS] = {};
+};
+
+struct Read_latency_histograms {
+    Latency_histogram request_to_data;
+    Latency_histogram scratchpad_read;
+};
+
+/**
+ * Keeps the read latency histograms of each sensor in a fixed table and plugs
+ * into the facade read path through One_wire_temp_sensor::set_read_latency_listener().
+ **/
+template <uint8_t MAX_SENSORS>
+class Latency_histogram_table : public Read_latency_listener {
+public:
+    Latency_histogram_table() {
+        reset();
+    }
+
+    void on_read_latency(const Device_address address, uint32_t request_to_data_us, uint32_t scratchpad_read_us) override {
+        Read_latency_histograms* histograms = get_or_assign_slot(address);
+        if (histograms == nullptr)
+            return;
+        if (request_to_data_us != READ_LATENCY_UNKNOWN)
+            histograms->request_to_data.add(request_to_data_us);
+        histograms->scratchpad_read.add(scratchpad_read_us);
+    }
+
+    // Copies the histograms of a sensor. Returns false if the sensor was never read
+    bool get_snapshot(const Device_address address, Read_latency_histograms* snapshot) const {
+        uint8_t index = find_slot(address);
+        if (index == MAX_SENSORS)
+            return false;
+        *snapshot = histograms[index];
+        return true;
+    }
+
+    void reset() {
+        for (uint8_t i = 0; i < MAX_SENSORS; ++i) {
+            histograms[i].request_to_data.reset();
+            histograms[i].scratchpad_read.reset();
+            is_slot_used[i] = false;
+        }
+    }
+
+private:
+    Device_address addresses[MAX_SENSORS];
+    bool is_slot_used[MAX_SENSORS];
+    Read_latency_histograms histograms[MAX_SENSORS];
+
+    // MAX_SENSORS if the sensor has no slot
+    uint8_t find_slot(const Device_address address) const {
+        for (uint8_t i = 0; i < MAX_SENSORS; ++i)
+            if (is_slot_used[i] && memcmp(addresses[i], address, sizeof(Device_address)) == 0)
+                return i;
+        return MAX_SENSORS;
+    }
+
+    Read_latency_histograms* get_or_assign_slot(const Device_address address) {
+        uint8_t index = find_slot(address);
+        if (index < MAX_SENSORS)
+            return &histograms[index];
+        for (uint8_t i = 0; i < MAX_SENSORS; ++i) {
+            if (!is_slot_used[i]) {
+                memcpy(addresses[i], address, sizeof(Device_address));
+                is_slot_used[i] = true;
+                return &histograms[i];
+            }
+        }
+        return nullptr;
+    }
+};
\ No newline at end of file
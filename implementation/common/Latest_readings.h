@@ -0,0 +1,131 @@
+#pragma once
+#include "One_wire_types.h"
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+struct Latest_reading {
+    Device_address address;
+    float temperature_in_celsius;
+    uint32_t micros_at_reading;             // 0 without a clock
+    uint32_t reading_count;                 // readings of the device published so far
+};
+
+// Latest reading of every device, published by the task that owns the bus and read by any task on
+// either core without locks and without touching the bus. Set it as the reading listener of the
+// sensor and let only the owner task call the sensor, the sensor is not thread safe.
+//
+// Each slot is a sequence lock: the owner makes the sequence odd, writes, and makes it even again.
+// A reader copies the slot and retries if the sequence was odd or changed meanwhile. A reader that
+// preempts the owner in the middle of a write on the same core gives up after SNAPSHOT_ATTEMPTS
+class Latest_readings : public Reading_listener {
+public:
+    static const uint8_t MAX_DEVICES = ONE_WIRE_MAX_DEVICES;
+    static const uint8_t SNAPSHOT_ATTEMPTS = 8;
+
+    explicit Latest_readings(uint32_t (*get_micros)() = nullptr) : get_micros(get_micros) {}
+
+    Latest_readings(const Latest_readings&) = delete;
+    Latest_readings& operator=(const Latest_readings&) = delete;
+
+    // Only from the owner task. Devices beyond MAX_DEVICES are not published
+    void on_reading(const Device_address address, float temperature_in_celsius) override {
+        uint8_t count = device_count.load(std::memory_order_relaxed);
+        uint8_t index = find(address, count);
+        if (index == count) {
+            if (count == MAX_DEVICES)
+                return;
+            publish(slots[index], address, temperature_in_celsius, 1);
+            device_count.store(count + 1, std::memory_order_release);
+            return;
+        }
+        uint32_t reading_count = slots[index].reading_count.load(std::memory_order_relaxed);
+        publish(slots[index], address, temperature_in_celsius, reading_count + 1);
+    }
+
+    // Returns false if the device has no reading yet or the snapshot could not be taken
+    bool get(const Device_address address, Latest_reading* reading) const {
+        uint8_t count = device_count.load(std::memory_order_acquire);
+        uint8_t index = find(address, count);
+        if (index == count)
+            return false;
+        return snapshot(slots[index], reading);
+    }
+
+    // Devices are in the order of their first reading
+    bool get_on_index(uint8_t index, Latest_reading* reading) const {
+        if (index >= device_count.load(std::memory_order_acquire))
+            return false;
+        return snapshot(slots[index], reading);
+    }
+
+    uint8_t get_device_count() const {
+        return device_count.load(std::memory_order_acquire);
+    }
+
+private:
+    // Every field is an atomic word, so a torn copy is a retry and not a data race
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint32_t> address_words[2] = {};
+        std::atomic<uint32_t> temperature_bits{0};
+        std::atomic<uint32_t> micros_at_reading{0};
+        std::atomic<uint32_t> reading_count{0};
+    };
+
+    uint32_t (*get_micros)();
+    Slot slots[MAX_DEVICES];
+    std::atomic<uint8_t> device_count{0};
+
+    // The address of a slot is written once, before device_count includes it
+    uint8_t find(const Device_address address, uint8_t count) const {
+        uint32_t words[2];
+        memcpy(words, address, sizeof(words));
+        for (uint8_t i = 0; i < count; ++i)
+            if (slots[i].address_words[0].load(std::memory_order_relaxed) == words[0] &&
+                slots[i].address_words[1].load(std::memory_order_relaxed) == words[1])
+                return i;
+        return count;
+    }
+
+    void publish(Slot& slot, const Device_address address, float temperature_in_celsius, uint32_t reading_count) {
+        uint32_t words[2];
+        memcpy(words, address, sizeof(words));
+        uint32_t temperature_bits;
+        memcpy(&temperature_bits, &temperature_in_celsius, sizeof(temperature_bits));
+        uint32_t micros_at_reading = get_micros != nullptr ? get_micros() : 0;
+
+        uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.address_words[0].store(words[0], std::memory_order_relaxed);
+        slot.address_words[1].store(words[1], std::memory_order_relaxed);
+        slot.temperature_bits.store(temperature_bits, std::memory_order_relaxed);
+        slot.micros_at_reading.store(micros_at_reading, std::memory_order_relaxed);
+        slot.reading_count.store(reading_count, std::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    static bool snapshot(const Slot& slot, Latest_reading* reading) {
+        for (uint8_t attempt = 0; attempt < SNAPSHOT_ATTEMPTS; ++attempt) {
+            uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence & 1)
+                continue;
+            uint32_t words[2] = {slot.address_words[0].load(std::memory_order_relaxed),
+                                 slot.address_words[1].load(std::memory_order_relaxed)};
+            uint32_t temperature_bits = slot.temperature_bits.load(std::memory_order_relaxed);
+            uint32_t micros_at_reading = slot.micros_at_reading.load(std::memory_order_relaxed);
+            uint32_t reading_count = slot.reading_count.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            memcpy(reading->address, words, sizeof(words));
+            memcpy(&reading->temperature_in_celsius, &temperature_bits, sizeof(temperature_bits));
+            reading->micros_at_reading = micros_at_reading;
+            reading->reading_count = reading_count;
+            return true;
+        }
+        return false;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+#include <stdint.h>
+
+// Sleep of a woken up early acquisition until the sample is available
+#define LIGHT_SLEEP_POLL_US 1000
+
+// Puts the CPU to sleep with a timer wakeup, e.g. Esp_light_sleeper. The bus keeps its level while
+// sleeping, so a parasite powered bus keeps the strong pullup. On the host a fake advances a virtual clock
+class Light_sleeper {
+public:
+    virtual ~Light_sleeper() {}
+    // Returns when the timer or another wakeup source wakes the CPU
+    virtual void sleep_us(uint32_t microseconds) = 0;
+};
\ No newline at end of file
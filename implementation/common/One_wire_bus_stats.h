@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Bus counters, available when USE_ONE_WIRE_BUS_STATS is uncommented in config.h.
+ * Shared by the ESP-IDF (C) and Arduino (C++) drivers.
+ **/
+typedef struct {
+    uint32_t resets;
+    uint32_t presence_failures;
+    uint32_t bytes_clocked;
+    uint32_t bits_clocked;
+    uint32_t crc_failures;
+    uint32_t critical_sections;
+    uint64_t critical_section_total_us;
+    uint32_t critical_section_max_us;
+    uint64_t bus_busy_us;
+} One_wire_bus_stats;
\ No newline at end of file
@@ -0,0 +1,262 @@
+#pragma once
+// Awaitable sensor operations for C++20 builds. Without coroutine support this header is empty
+#if defined(__cpp_impl_coroutine)
+#include "One_wire_types.h"
+#include <coroutine>
+#include <exception>
+#include <stdint.h>
+
+#define NOTHING_TO_RUN UINT32_MAX
+#define STEP_DONE UINT32_MAX
+#define AWAIT_POLL_US 1000
+
+// Coroutine started by One_wire_executor::spawn(). Its frame is allocated once when it is
+// created and destroyed by the executor when it ends
+class One_wire_task {
+public:
+    struct promise_type {
+        One_wire_task get_return_object() {
+            return One_wire_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    One_wire_task(One_wire_task&& other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+
+    ~One_wire_task() {
+        if (handle)
+            handle.destroy();
+    }
+
+    std::coroutine_handle<> release() {
+        std::coroutine_handle<> released = handle;
+        handle = nullptr;
+        return released;
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit One_wire_task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+};
+
+// Runs many sensor tasks in one thread. Each suspended task waits for a time and then for its step
+// function, which does one bounded piece of bus work and returns STEP_DONE when the awaited
+// operation is complete, else the microseconds until it is run again. No task holds the bus longer
+// than one step, e.g. one device read.
+//
+// From a FreeRTOS task:
+//     for (;;) {
+//         uint32_t wait_us = executor.run_once();
+//         vTaskDelay(wait_us == NOTHING_TO_RUN ? portMAX_DELAY : pdMS_TO_TICKS(wait_us/1000) + 1);
+//     }
+class One_wire_executor {
+public:
+    static const uint8_t MAX_TASKS = 8;
+
+    explicit One_wire_executor(uint32_t (*get_micros)()) : get_micros(get_micros) {}
+
+    ~One_wire_executor() {
+        for (uint8_t i = 0; i < MAX_TASKS; ++i)
+            if (waiters[i].handle)
+                waiters[i].handle.destroy();
+    }
+
+    One_wire_executor(const One_wire_executor&) = delete;
+    One_wire_executor& operator=(const One_wire_executor&) = delete;
+
+    // The task starts on the next run_once(). Returns false, destroying the task, if MAX_TASKS are running
+    bool spawn(One_wire_task task) {
+        if (task_count == MAX_TASKS)
+            return false;
+        ++task_count;
+        wait(task.release(), get_micros(), nullptr, nullptr);
+        return true;
+    }
+
+    // Resumes every task whose wait is over and returns the microseconds until one is due again,
+    // NOTHING_TO_RUN when no task is left. Tasks suspended during this call run on the next one
+    uint32_t run_once() {
+        uint32_t now_us = get_micros();
+        uint32_t next_us = NOTHING_TO_RUN;
+        ++pass;
+        for (uint8_t i = 0; i < MAX_TASKS; ++i) {
+            Waiter& waiter = waiters[i];
+            if (!waiter.handle || waiter.pass == pass)
+                continue;
+            if ((int32_t)(now_us - waiter.wake_us) < 0) {
+                next_us = waiter.wake_us - now_us < next_us ? waiter.wake_us - now_us : next_us;
+                continue;
+            }
+            if (waiter.step != nullptr) {
+                uint32_t retry_us = waiter.step(waiter.context);
+                if (retry_us != STEP_DONE) {
+                    waiter.wake_us = now_us + retry_us;
+                    next_us = retry_us < next_us ? retry_us : next_us;
+                    continue;
+                }
+            }
+            std::coroutine_handle<> handle = waiter.handle;
+            waiter.handle = nullptr;
+            handle.resume();
+            if (handle.done()) {
+                handle.destroy();
+                --task_count;
+            }
+            else
+                next_us = 0;
+        }
+        return task_count == 0 ? NOTHING_TO_RUN : next_us;
+    }
+
+    uint8_t get_task_count() const {
+        return task_count;
+    }
+
+    uint32_t now() const {
+        return get_micros();
+    }
+
+    // Suspends the task until wake_us, then until step(context) returns STEP_DONE
+    void wait(std::coroutine_handle<> handle, uint32_t wake_us, uint32_t (*step)(void*), void* context) {
+        for (uint8_t i = 0; i < MAX_TASKS; ++i) {
+            if (!waiters[i].handle) {
+                waiters[i] = {handle, wake_us, step, context, pass};
+                return;
+            }
+        }
+    }
+
+private:
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        uint32_t wake_us;
+        uint32_t (*step)(void*);
+        void* context;
+        uint32_t pass;
+    };
+
+    uint32_t (*get_micros)();
+    Waiter waiters[MAX_TASKS] = {};
+    uint8_t task_count = 0;
+    uint32_t pass = 0;
+};
+
+// Awaitable operations over a sensor, e.g. One_wire_temp_sensor, run by an executor:
+//
+//     One_wire_task sample(Async_one_wire_temp_sensor<One_wire_temp_sensor>& sensor, float* temperatures) {
+//         co_await sensor.search();
+//         for (;;) {
+//             co_await sensor.convert();
+//             uint8_t read = co_await sensor.read_all(temperatures);
+//             ...
+//         }
+//     }
+template <class Sensor>
+class Async_one_wire_temp_sensor {
+public:
+    static const uint8_t MAX_DEVICES = ONE_WIRE_MAX_DEVICES;
+
+    Async_one_wire_temp_sensor(Sensor& sensor, One_wire_executor& executor) : sensor(sensor), executor(executor) {}
+
+    // Finds the devices on the bus. Resumes with the number found, read_all() reads them
+    class Search_awaiter {
+    public:
+        explicit Search_awaiter(Async_one_wire_temp_sensor& owner) : owner(owner) {}
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            owner.executor.wait(handle, owner.executor.now(), &search, &owner);
+        }
+        uint8_t await_resume() { return owner.device_count; }
+    private:
+        Async_one_wire_temp_sensor& owner;
+        static uint32_t search(void* context) {
+            Async_one_wire_temp_sensor& owner = *static_cast<Async_one_wire_temp_sensor*>(context);
+            uint8_t device_count = owner.sensor.get_device_count();
+            owner.device_count = device_count < MAX_DEVICES ? device_count : MAX_DEVICES;
+            for (uint8_t i = 0; i < owner.device_count; ++i)
+                owner.sensor.get_device_address_on_index(owner.addresses[i], i);
+            return STEP_DONE;
+        }
+    };
+
+    // Requests the conversion and resumes when the sample is available, the bus is free meanwhile
+    class Convert_awaiter {
+    public:
+        explicit Convert_awaiter(Async_one_wire_temp_sensor& owner) : owner(owner) {}
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            owner.sensor.request_temperatures();
+            uint32_t conversion_us = 1000*(uint32_t)owner.sensor.get_millis_to_wait_for_conversion(owner.sensor.get_resolution());
+            owner.executor.wait(handle, owner.executor.now() + conversion_us, &is_sample_available, &owner);
+        }
+        void await_resume() {}
+    private:
+        Async_one_wire_temp_sensor& owner;
+        static uint32_t is_sample_available(void* context) {
+            bool is_available = static_cast<Async_one_wire_temp_sensor*>(context)->sensor.is_sample_available();
+            return is_available ? STEP_DONE : AWAIT_POLL_US;
+        }
+    };
+
+    // Reads the devices found by the last search, one device per step. A failed read is left as
+    // TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS. Resumes with the number of successful reads
+    class Read_all_awaiter {
+    public:
+        Read_all_awaiter(Async_one_wire_temp_sensor& owner, float* temperatures) : owner(owner), temperatures(temperatures) {}
+        bool await_ready() { return owner.device_count == 0; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            owner.executor.wait(handle, owner.executor.now(), &read_next, this);
+        }
+        uint8_t await_resume() { return successful_reads; }
+    private:
+        Async_one_wire_temp_sensor& owner;
+        float* temperatures;
+        uint8_t next_device = 0;
+        uint8_t successful_reads = 0;
+        static uint32_t read_next(void* context) {
+            Read_all_awaiter& awaiter = *static_cast<Read_all_awaiter*>(context);
+            Async_one_wire_temp_sensor& owner = awaiter.owner;
+            uint8_t device = awaiter.next_device++;
+            if (owner.sensor.read_temperature_in_celsius(owner.addresses[device], &awaiter.temperatures[device]))
+                ++awaiter.successful_reads;
+            else
+                awaiter.temperatures[device] = TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS;
+            return awaiter.next_device == owner.device_count ? STEP_DONE : 0;
+        }
+    };
+
+    Search_awaiter search() {
+        return Search_awaiter(*this);
+    }
+
+    Convert_awaiter convert() {
+        return Convert_awaiter(*this);
+    }
+
+    // temperatures holds one value per device found, in the order of get_device_address_on_index()
+    Read_all_awaiter read_all(float* temperatures) {
+        return Read_all_awaiter(*this, temperatures);
+    }
+
+    uint8_t get_device_count() const {
+        return device_count;
+    }
+
+    const uint8_t* get_device_address(uint8_t index) const {
+        return addresses[index];
+    }
+
+private:
+    Sensor& sensor;
+    One_wire_executor& executor;
+    Device_address addresses[MAX_DEVICES];
+    uint8_t device_count = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Dallas/Maxim CRC8 (polynomial x^8 + x^5 + x^4 + 1) of ROM codes and scratchpads
+inline uint8_t one_wire_crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    while (length--) {
+        uint8_t byte = *data++;
+        for (uint8_t i = 0; i < 8; ++i) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix)
+                crc ^= 0x8C;
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+// The same CRC8 evaluated at compile time, e.g. to check the ROM codes of a Known_bus. Recursive to stay
+// a C++11 constexpr, use one_wire_crc8() at run time
+constexpr uint8_t one_wire_crc8_of_bits(uint8_t crc, uint8_t byte, uint8_t bits) {
+    return bits == 0 ? crc : one_wire_crc8_of_bits((crc ^ byte) & 0x01 ? (crc >> 1) ^ 0x8C : crc >> 1, byte >> 1, bits - 1);
+}
+
+constexpr uint8_t constexpr_one_wire_crc8(const uint8_t* data, size_t length, uint8_t crc = 0) {
+    return length == 0 ? crc : constexpr_one_wire_crc8(data + 1, length - 1, one_wire_crc8_of_bits(crc, *data, 8));
+}
+
+static constexpr uint8_t ONE_WIRE_CRC8_EXAMPLE_ROM[] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00};
+static_assert(constexpr_one_wire_crc8(ONE_WIRE_CRC8_EXAMPLE_ROM, 7) == 0xA2, "CRC8 of the ROM code example of Maxim AN27");
+
+// Dallas/Maxim CRC16 (polynomial x^16 + x^15 + x^2 + 1), the same as onewire_crc16()
+inline uint16_t one_wire_crc16(const uint8_t* data, size_t length, uint16_t crc = 0) {
+    while (length--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; ++i)
+            crc = crc & 0x0001 ? (crc >> 1) ^ 0xA001 : crc >> 1;
+    }
+    return crc;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Durations of the reset and read/write slots, in microseconds.
+ * Shared by the ESP-IDF (C) and Arduino (C++) drivers, each one has its
+ * standard and slow presets. The slow preset keeps the standard slots and
+ * lengthens the recovery between them, so the pull-up can recharge the
+ * capacitance of a long cable.
+ **/
+typedef struct {
+    uint16_t reset_low_us;
+    uint16_t presence_sample_us;    // from the release of the bus to the presence sample
+    uint16_t reset_recovery_us;
+    uint8_t write_1_low_us;
+    uint8_t write_0_low_us;
+    uint8_t write_slot_us;          // without the recovery, a longer write 0 low time fills it
+    uint8_t read_low_us;
+    uint8_t read_sample_us;         // from the release of the bus to the sample, read_low_us + read_sample_us must be below 15
+    uint8_t read_slot_us;
+    uint8_t recovery_us;            // between slots
+} One_wire_slot_timing;
+
+/**
+ * What the bus does after the master releases it, in microseconds, measured
+ * by the drivers to calibrate the slot timing. Polling does not count the
+ * time of the reads, the times may fall short by a few microseconds.
+ **/
+typedef struct {
+    uint16_t rise_us;               // from the release of a write slot to the bus read high
+    uint16_t presence_delay_us;     // from the release of a reset pulse to the start of the presence pulse
+    uint16_t presence_low_us;       // length of the presence pulse
+} One_wire_bus_measurement;
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+#include "One_wire_trace_events.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * BUS TRACE RECORD
+ *
+ *  byte 0          : event (4 upper bits) | flags (4 lower bits)
+ *  1 to 5 bytes    : microseconds since the previous event, 7 bits per byte, least significant first,
+ *                    the upper bit is set in every byte but the last one
+ *  1 byte          : data, only for ONE_WIRE_TRACE_WRITE_BYTE and ONE_WIRE_TRACE_READ_BYTE
+ *
+ * A byte clocked less than 128 us after the previous event takes 3 bytes, a reset 2 bytes.
+ * A trace is the records back to back, oldest first.
+ **/
+
+#define ONE_WIRE_TRACE_EVENT_SHIFT 4
+#define ONE_WIRE_TRACE_FLAGS_MASK 0x0F
+#define ONE_WIRE_TRACE_MAX_RECORD_SIZE 7
+#define ONE_WIRE_TRACE_ELAPSED_BITS_PER_BYTE 7
+#define ONE_WIRE_TRACE_ELAPSED_MASK 0x7F
+#define ONE_WIRE_TRACE_MORE_ELAPSED 0x80
+#define ONE_WIRE_TRACE_MAX_ELAPSED_SIZE 5
+
+inline bool has_one_wire_trace_data(uint8_t event) {
+    return event == ONE_WIRE_TRACE_WRITE_BYTE || event == ONE_WIRE_TRACE_READ_BYTE;
+}
+
+struct One_wire_trace_record {
+    uint8_t event;
+    uint8_t flags;
+    uint8_t data;
+    uint32_t elapsed_us;            // since the previous event, even if that record was dropped
+};
+
+// Records the bus events in a ring over a buffer allocated by the caller. When the ring is full the
+// oldest records are dropped. Set it as the trace of the sensor, or trace a transport with Traced_transport
+class One_wire_trace {
+public:
+    // The buffer must outlive the trace. Without a clock every elapsed time is 0
+    One_wire_trace(uint8_t* buffer, size_t buffer_size, uint32_t (*get_micros)() = nullptr)
+        : buffer(buffer), buffer_size(buffer_size), get_micros(get_micros) {}
+
+    One_wire_trace(const One_wire_trace&) = delete;
+    One_wire_trace& operator=(const One_wire_trace&) = delete;
+
+    void record(uint8_t event, uint8_t flags, uint8_t data = 0) {
+        uint32_t now_us = get_micros != nullptr ? get_micros() : 0;
+        uint32_t elapsed_us = has_last_event ? now_us - last_event_us : 0;
+        last_event_us = now_us;
+        has_last_event = true;
+
+        uint8_t encoded[ONE_WIRE_TRACE_MAX_RECORD_SIZE];
+        size_t size = 0;
+        encoded[size++] = event << ONE_WIRE_TRACE_EVENT_SHIFT | (flags & ONE_WIRE_TRACE_FLAGS_MASK);
+        do {
+            uint8_t elapsed_byte = elapsed_us & ONE_WIRE_TRACE_ELAPSED_MASK;
+            elapsed_us >>= ONE_WIRE_TRACE_ELAPSED_BITS_PER_BYTE;
+            encoded[size++] = elapsed_us != 0 ? elapsed_byte | ONE_WIRE_TRACE_MORE_ELAPSED : elapsed_byte;
+        } while (elapsed_us != 0);
+        if (has_one_wire_trace_data(event))
+            encoded[size++] = data;
+
+        if (size > buffer_size) {
+            ++dropped_record_count;
+            return;
+        }
+        while (buffer_size - length < size)
+            drop_oldest_record();
+        for (size_t i = 0; i < size; ++i)
+            buffer[(oldest + length + i) % buffer_size] = encoded[i];
+        length += size;
+    }
+
+    // One_wire_trace_hook of the drivers, the context is the trace
+    static void record_to(void* trace, uint8_t event, uint8_t flags, uint8_t data) {
+        static_cast<One_wire_trace*>(trace)->record(event, flags, data);
+    }
+
+    // Bytes of the records held
+    size_t get_length() const {
+        return length;
+    }
+
+    uint32_t get_dropped_record_count() const {
+        return dropped_record_count;
+    }
+
+    // Copies the records held, oldest first. Returns the bytes copied, 0 if they do not fit
+    size_t copy(uint8_t* destination, size_t destination_size) const {
+        if (destination_size < length)
+            return 0;
+        size_t first_part = buffer_size - oldest < length ? buffer_size - oldest : length;
+        memcpy(destination, &buffer[oldest], first_part);
+        memcpy(&destination[first_part], buffer, length - first_part);
+        return length;
+    }
+
+    void clear() {
+        oldest = 0;
+        length = 0;
+        dropped_record_count = 0;
+        has_last_event = false;
+    }
+
+private:
+    uint8_t* buffer;
+    size_t buffer_size;
+    uint32_t (*get_micros)();
+    size_t oldest = 0;
+    size_t length = 0;
+    uint32_t dropped_record_count = 0;
+    uint32_t last_event_us = 0;
+    bool has_last_event = false;
+
+    uint8_t get_byte(size_t index) const {
+        return buffer[(oldest + index) % buffer_size];
+    }
+
+    void drop_oldest_record() {
+        size_t size = 1;
+        while (size <= ONE_WIRE_TRACE_MAX_ELAPSED_SIZE && (get_byte(size++) & ONE_WIRE_TRACE_MORE_ELAPSED))
+            ;
+        if (has_one_wire_trace_data(get_byte(0) >> ONE_WIRE_TRACE_EVENT_SHIFT))
+            ++size;
+        oldest = (oldest + size) % buffer_size;
+        length -= size;
+        ++dropped_record_count;
+    }
+};
+
+// Reads the records of a trace copied out of the ring or loaded from a file
+class One_wire_trace_reader {
+public:
+    // The trace is read in place, it must outlive the reader
+    One_wire_trace_reader(const uint8_t* trace, size_t length) : trace(trace), length(length) {}
+
+    // Returns false at the end of the trace and on a truncated record
+    bool next(One_wire_trace_record* record) {
+        size_t index = position;
+        if (index >= length)
+            return false;
+        uint8_t header = trace[index++];
+        uint32_t elapsed_us = 0;
+        for (uint8_t shift = 0; ; shift += ONE_WIRE_TRACE_ELAPSED_BITS_PER_BYTE) {
+            if (index >= length || shift >= ONE_WIRE_TRACE_ELAPSED_BITS_PER_BYTE*ONE_WIRE_TRACE_MAX_ELAPSED_SIZE)
+                return false;
+            uint8_t elapsed_byte = trace[index++];
+            elapsed_us |= (uint32_t)(elapsed_byte & ONE_WIRE_TRACE_ELAPSED_MASK) << shift;
+            if (!(elapsed_byte & ONE_WIRE_TRACE_MORE_ELAPSED))
+                break;
+        }
+        record->event = header >> ONE_WIRE_TRACE_EVENT_SHIFT;
+        record->flags = header & ONE_WIRE_TRACE_FLAGS_MASK;
+        record->data = 0;
+        record->elapsed_us = elapsed_us;
+        if (has_one_wire_trace_data(record->event)) {
+            if (index >= length)
+                return false;
+            record->data = trace[index++];
+        }
+        position = index;
+        return true;
+    }
+
+    bool is_at_end() const {
+        return position >= length;
+    }
+
+    void rewind() {
+        position = 0;
+    }
+
+private:
+    const uint8_t* trace;
+    size_t length;
+    size_t position = 0;
+};
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Bus events reported to a trace hook, available when USE_ONE_WIRE_TRACE is
+ * uncommented in config.h. Shared by the ESP-IDF (C) and Arduino (C++) drivers.
+ *
+ * The 3 lower bits of the flags are the values of the event, the data is the
+ * byte of the byte events.
+ **/
+#define ONE_WIRE_TRACE_RESET 1              // value: presence pulse
+#define ONE_WIRE_TRACE_WRITE_BYTE 2         // data: byte written
+#define ONE_WIRE_TRACE_READ_BYTE 3          // data: byte read
+#define ONE_WIRE_TRACE_WRITE_BIT 4          // value: bit written
+#define ONE_WIRE_TRACE_READ_BIT 5           // value: bit read
+#define ONE_WIRE_TRACE_TRIPLET 6            // values: id bit, complement bit (bit 1) and direction (bit 2)
+#define ONE_WIRE_TRACE_STRONG_PULLUP 7      // value: bus driven high
+
+#define ONE_WIRE_TRACE_VALUE 0x01
+#define ONE_WIRE_TRACE_COMPLEMENT_BIT 0x02
+#define ONE_WIRE_TRACE_DIRECTION 0x04
+#define ONE_WIRE_TRACE_FAILED 0x08          // the driver call failed
+
+// Called by the driver after every bus event, from the task using the bus
+typedef void (*One_wire_trace_hook)(void* context, uint8_t event, uint8_t flags, uint8_t data);
\ No newline at end of file
@@ -0,0 +1,191 @@
+#pragma once
+#include "One_wire_types.h"
+#include "One_wire_crc.h"
+#include "One_wire_slot_timing.h"
+#include <stddef.h>
+#include <string.h>
+
+#define ONE_WIRE_SEARCH_ROM 0xF0
+#define ONE_WIRE_MATCH_ROM 0x55
+#define ONE_WIRE_SKIP_ROM 0xCC
+#define ONE_WIRE_READ_ROM 0x33
+
+enum One_wire_status {
+    ONE_WIRE_OK,
+    ONE_WIRE_NO_PRESENCE,
+    ONE_WIRE_CRC_ERROR,
+    ONE_WIRE_BUS_ERROR,
+    ONE_WIRE_NOT_SUPPORTED
+};
+
+struct One_wire_search_state {
+    Device_address rom;
+    uint8_t last_discrepancy;       // 1-based bit number, 0 when there was none
+    bool is_last_device_found;
+    bool is_family_filtered;
+    uint8_t family_code;
+};
+
+/**
+ * Static interface of a 1-Wire bus. Device logic is written against it as a
+ * template parameter, so the transport calls are resolved at compile time.
+ *
+ * A transport derives from One_wire_transport<Transport> and implements:
+ *
+ *  bool reset();                                       true on presence pulse
+ *  bool write_bytes(const uint8_t* bytes, size_t count);
+ *  bool read_bytes(uint8_t* bytes, size_t count);
+ *  bool write_bit(bool bit);
+ *  bool read_bit(bool* bit);
+ *  bool strong_pullup(bool enable);                    false if the transport can not drive the bus high
+ *
+ * The ROM commands and the search are built on top of them. A transport with
+ * a native search triplet (e.g. a bridge chip) defines its own triplet(), one
+ * that can drive the bus high right after a byte defines its own
+ * write_byte_and_strong_pullup(), and one with adjustable slots defines
+ * measure_bus(), get_slot_timing(), get_slow_slot_timing() and set_slot_timing().
+ *
+ * Optional, only needed by the sensor calls that use them:
+ *
+ *  One_wire_bus_stats get_bus_stats();                 with ONE_WIRE_BUS_STATS
+ *  void clear_bus_stats();                             with ONE_WIRE_BUS_STATS
+ *  void set_trace(One_wire_trace* trace);              with ONE_WIRE_TRACE
+ **/
+template <typename Transport>
+class One_wire_transport {
+public:
+    bool write_byte(uint8_t byte) {
+        return transport().write_bytes(&byte, 1);
+    }
+
+    bool read_byte(uint8_t* byte) {
+        return transport().read_bytes(byte, 1);
+    }
+
+    bool skip_rom() {
+        return write_byte(ONE_WIRE_SKIP_ROM);
+    }
+
+    // Parasite powered devices need the strong pullup within 10 us of the end of Convert T or
+    // Copy Scratchpad. A transport that can not ensure it between both calls, e.g. because of
+    // interrupts, defines its own. Without a strong pullup the bus relies on an external one
+    bool write_byte_and_strong_pullup(uint8_t byte) {
+        if (!write_byte(byte))
+            return false;
+        transport().strong_pullup(true);
+        return true;
+    }
+
+    bool select(const Device_address address) {
+        uint8_t command[1 + sizeof(Device_address)] = {ONE_WIRE_MATCH_ROM};
+        memcpy(&command[1], address, sizeof(Device_address));
+        return transport().write_bytes(command, sizeof(command));
+    }
+
+    // Reads a ROM bit and its complement, then writes the direction taken. When both
+    // bits differ the direction is the bit read, otherwise it is the one passed in.
+    // Nothing is written when both bits are 1, no device answered
+    bool triplet(bool* id_bit, bool* complement_bit, bool* direction) {
+        if (!transport().read_bit(id_bit) || !transport().read_bit(complement_bit))
+            return false;
+        if (*id_bit && *complement_bit)
+            return true;
+        if (*id_bit != *complement_bit)
+            *direction = *id_bit;
+        return transport().write_bit(*direction);
+    }
+
+    void search_start(One_wire_search_state* state) {
+        memset(state, 0, sizeof(One_wire_search_state));
+    }
+
+    // Only devices of the family are found. The direction of the family code bits is forced,
+    // so the other families are pruned while the family code is clocked
+    void search_family(One_wire_search_state* state, uint8_t family_code) {
+        search_start(state);
+        state->is_family_filtered = true;
+        state->family_code = family_code;
+    }
+
+    // Returns false when there are no more devices, the bus failed or the ROM read has a bad CRC
+    bool search_next(One_wire_search_state* state, Device_address address) {
+        if (state->is_last_device_found)
+            return false;
+        if (!transport().reset() || !write_byte(ONE_WIRE_SEARCH_ROM)) {
+            restart_search(state);
+            return false;
+        }
+
+        uint8_t last_zero = 0;
+        for (uint8_t id_bit_number = 1; id_bit_number <= 64; ++id_bit_number) {
+            uint8_t byte_index = (id_bit_number - 1) / 8;
+            uint8_t bit_mask = 1 << ((id_bit_number - 1) % 8);
+            bool direction;
+            if (id_bit_number < state->last_discrepancy)
+                direction = (state->rom[byte_index] & bit_mask) != 0;
+            else
+                direction = id_bit_number == state->last_discrepancy;
+
+            bool is_family_bit = state->is_family_filtered && id_bit_number <= 8;
+            bool family_bit = (state->family_code & bit_mask) != 0;
+            if (is_family_bit)
+                direction = family_bit;
+
+            bool id_bit, complement_bit;
+            if (!transport().triplet(&id_bit, &complement_bit, &direction) || (id_bit && complement_bit) ||
+                (is_family_bit && direction != family_bit)) {
+                restart_search(state);
+                return false;
+            }
+            // A discrepancy in the family code of a family search leads to other families
+            if (!id_bit && !complement_bit && !direction && !is_family_bit)
+                last_zero = id_bit_number;
+
+            if (direction)
+                state->rom[byte_index] |= bit_mask;
+            else
+                state->rom[byte_index] &= ~bit_mask;
+        }
+
+        state->last_discrepancy = last_zero;
+        state->is_last_device_found = last_zero == 0;
+        if (one_wire_crc8(state->rom, sizeof(Device_address) - 1) != state->rom[sizeof(Device_address) - 1])
+            return false;
+        memcpy(address, state->rom, sizeof(Device_address));
+        return true;
+    }
+
+    // Transports whose slots are clocked by hardware, a UART or a bridge, have one fixed timing.
+    // They can not measure the bus and ignore the timing set
+    bool measure_bus(One_wire_bus_measurement*) {
+        return false;
+    }
+
+    One_wire_slot_timing get_slot_timing() {
+        return One_wire_slot_timing();
+    }
+
+    // The timing with the longer recovery between slots, for long cables
+    One_wire_slot_timing get_slow_slot_timing() {
+        return transport().get_slot_timing();
+    }
+
+    void set_slot_timing(const One_wire_slot_timing&) {
+    }
+
+    // Counted in the bus stats of transports that have them
+    void count_crc_failure() {
+    }
+
+private:
+    Transport& transport() {
+        return static_cast<Transport&>(*this);
+    }
+
+    // Keeps the family filter, the next search starts again from the first device
+    void restart_search(One_wire_search_state* state) {
+        memset(state->rom, 0, sizeof(Device_address));
+        state->last_discrepancy = 0;
+        state->is_last_device_found = false;
+    }
+};
\ No newline at end of file
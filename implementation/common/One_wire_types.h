@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+typedef uint8_t Device_address[8];
+
+// Devices of one bus the sensor and its tables keep, the scan stops there
+#define ONE_WIRE_MAX_DEVICES 32
+
+#define DS18S20_FAMILY_ID 0x10
+#define DS1822_FAMILY_ID 0x22
+#define DS18B20_FAMILY_ID 0x28
+#define DS1825_FAMILY_ID 0x3B
+#define DS28EA00_FAMILY_ID 0x42
+
+#define TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS -127.0f
+
+struct Read_retry_policy {
+    uint8_t max_attempts;                   // 1 disables the retries
+    uint16_t first_backoff_ms;              // wait before the second attempt, doubled after every failed attempt
+    uint16_t max_backoff_ms;
+    bool use_slow_timing_on_last_attempt;
+};
+
+class Reading_listener {
+public:
+    virtual ~Reading_listener() {}
+    virtual void on_reading(const Device_address address, float temperature_in_celsius) = 0;
+};
+
+#define READ_LATENCY_UNKNOWN UINT32_MAX
+
+class Read_latency_listener {
+public:
+    virtual ~Read_latency_listener() {}
+    // request_to_data_us is READ_LATENCY_UNKNOWN when no conversion was requested with request_temperatures()
+    virtual void on_read_latency(const Device_address address, uint32_t request_to_data_us, uint32_t scratchpad_read_us) = 0;
+};
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+#include "One_wire_types.h"
+#include <stdint.h>
+
+#define PIPELINED_SAMPLER_MAX_GROUPS 4
+
+// Reads a sensor continuously in groups, so the bus is not idle while the devices convert. Every group
+// converts with Match ROM on its own, and the scratchpads of a group whose conversion is over are read
+// while the other groups convert. Then that group converts again. With two groups on a bus where the
+// reads take about as long as a conversion, every device is read almost twice as often as with a
+// broadcast conversion followed by all the reads.
+// The devices are split in group_count groups of consecutive addresses. Conversions are waited by time,
+// a read slot would be held low by the devices of the other groups. Externally powered buses only, a
+// parasite powered device needs the strong pullup, which holds the bus during the conversion.
+// Readings go to the reading listener of the sensor. Do not request temperatures of the whole bus while
+// the sampler runs
+template <class Sensor>
+class Pipelined_sampler {
+public:
+    Pipelined_sampler(Sensor& sensor, const Device_address* addresses, uint8_t device_count, uint8_t group_count, uint32_t (*get_micros)())
+        : sensor(sensor), addresses(addresses), device_count(device_count), get_micros(get_micros),
+          group_count(group_count == 0 ? 1 : group_count > PIPELINED_SAMPLER_MAX_GROUPS ? PIPELINED_SAMPLER_MAX_GROUPS : group_count) {
+        if (this->group_count > device_count && device_count > 0)
+            this->group_count = device_count;
+    }
+
+    // Starts the conversion of every group, one after the other. Returns false on parasite powered buses
+    bool start() {
+        if (sensor.is_parasite_powered())
+            return false;
+        for (uint8_t group = 0; group < group_count; ++group)
+            start_conversion(group);
+        is_running = true;
+        return true;
+    }
+
+    // Reads the group whose conversion ended first, if it is over, and converts it again.
+    // Returns the microseconds until a conversion is over
+    uint32_t run() {
+        if (!is_running)
+            return 0;
+        uint8_t group = get_next_group();
+        uint32_t now_us = get_micros();
+        uint32_t end_us = conversion_start_us[group] + conversion_us;
+        if (is_before(now_us, end_us))
+            return end_us - now_us;
+
+        read_group(group);
+        start_conversion(group);
+        ++cycles[group];
+
+        group = get_next_group();
+        now_us = get_micros();
+        end_us = conversion_start_us[group] + conversion_us;
+        return is_before(now_us, end_us) ? end_us - now_us : 0;
+    }
+
+    void stop() {
+        is_running = false;
+    }
+
+    uint8_t get_group_count() const {
+        return group_count;
+    }
+
+    // Times every device of group was read
+    uint32_t get_cycles(uint8_t group) const {
+        return group < group_count ? cycles[group] : 0;
+    }
+
+private:
+    Sensor& sensor;
+    const Device_address* addresses;
+    uint8_t device_count;
+    uint32_t (*get_micros)();
+    uint8_t group_count;
+
+    bool is_running = false;
+    uint32_t conversion_us = 0;
+    uint32_t conversion_start_us[PIPELINED_SAMPLER_MAX_GROUPS] = {};
+    uint32_t cycles[PIPELINED_SAMPLER_MAX_GROUPS] = {};
+
+    static bool is_before(uint32_t time_us, uint32_t reference_us) {
+        return (int32_t)(time_us - reference_us) < 0;
+    }
+
+    uint8_t get_first_device(uint8_t group) const {
+        return (uint16_t)device_count*group/group_count;
+    }
+
+    void start_conversion(uint8_t group) {
+        uint8_t first_device = get_first_device(group);
+        conversion_us = 1000*(uint32_t)sensor.get_millis_to_wait_for_conversion(sensor.get_resolution());
+        sensor.request_temperatures_of(&addresses[first_device], get_first_device(group + 1) - first_device);
+        conversion_start_us[group] = get_micros();
+    }
+
+    void read_group(uint8_t group) {
+        for (uint8_t i = get_first_device(group); i < get_first_device(group + 1); ++i) {
+            float temperature;
+            sensor.read_temperature_in_celsius(addresses[i], &temperature);
+        }
+    }
+
+    uint8_t get_next_group() const {
+        uint8_t next_group = 0;
+        for (uint8_t group = 1; group < group_count; ++group)
+            if (is_before(conversion_start_us[group], conversion_start_us[next_group]))
+                next_group = group;
+        return next_group;
+    }
+};
\ No newline at end of file
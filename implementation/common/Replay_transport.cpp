@@ -0,0 +1,129 @@
+#include "Replay_transport.h"
+
+Replay_transport* Replay_clock::replay = nullptr;
+
+Replay_transport::Replay_transport(const uint8_t* trace, size_t length) : reader(trace, length) {
+}
+
+bool Replay_transport::reset() {
+    One_wire_trace_record record;
+    if (!replay(ONE_WIRE_TRACE_RESET, &record))
+        return false;
+    return (record.flags & ONE_WIRE_TRACE_VALUE) && !(record.flags & ONE_WIRE_TRACE_FAILED);
+}
+
+bool Replay_transport::write_bytes(const uint8_t* bytes, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        One_wire_trace_reader next_reader = reader;
+        One_wire_trace_record record;
+        if (!next_reader.next(&record) || record.event != ONE_WIRE_TRACE_WRITE_BYTE || record.data != bytes[i]) {
+            ++divergence_count;
+            return false;
+        }
+        replay(ONE_WIRE_TRACE_WRITE_BYTE, &record);
+        if (record.flags & ONE_WIRE_TRACE_FAILED)
+            return false;
+    }
+    return true;
+}
+
+bool Replay_transport::read_bytes(uint8_t* bytes, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        One_wire_trace_record record;
+        if (!replay(ONE_WIRE_TRACE_READ_BYTE, &record) || (record.flags & ONE_WIRE_TRACE_FAILED))
+            return false;
+        bytes[i] = record.data;
+    }
+    return true;
+}
+
+bool Replay_transport::write_bit(bool bit) {
+    return replay_written(ONE_WIRE_TRACE_WRITE_BIT, bit);
+}
+
+bool Replay_transport::read_bit(bool* bit) {
+    One_wire_trace_record record;
+    if (!replay(ONE_WIRE_TRACE_READ_BIT, &record) || (record.flags & ONE_WIRE_TRACE_FAILED))
+        return false;
+    *bit = (record.flags & ONE_WIRE_TRACE_VALUE) != 0;
+    return true;
+}
+
+// Drivers without a native triplet record the search as its bits. With a triplet the direction
+// is only taken by the caller when both bits were 0, then it must be the recorded one
+bool Replay_transport::triplet(bool* id_bit, bool* complement_bit, bool* direction) {
+    One_wire_trace_reader next_reader = reader;
+    One_wire_trace_record record;
+    bool has_record = next_reader.next(&record);
+    if (has_record && record.event == ONE_WIRE_TRACE_READ_BIT)
+        return One_wire_transport<Replay_transport>::triplet(id_bit, complement_bit, direction);
+    if (!has_record || record.event != ONE_WIRE_TRACE_TRIPLET) {
+        ++divergence_count;
+        return false;
+    }
+    bool recorded_id_bit = (record.flags & ONE_WIRE_TRACE_VALUE) != 0;
+    bool recorded_complement_bit = (record.flags & ONE_WIRE_TRACE_COMPLEMENT_BIT) != 0;
+    bool recorded_direction = (record.flags & ONE_WIRE_TRACE_DIRECTION) != 0;
+    bool is_discrepancy = !recorded_id_bit && !recorded_complement_bit;
+    if (is_discrepancy && !(record.flags & ONE_WIRE_TRACE_FAILED) && *direction != recorded_direction) {
+        ++divergence_count;
+        return false;
+    }
+    replay(ONE_WIRE_TRACE_TRIPLET, &record);
+    if (record.flags & ONE_WIRE_TRACE_FAILED)
+        return false;
+    *id_bit = recorded_id_bit;
+    *complement_bit = recorded_complement_bit;
+    *direction = recorded_direction;
+    return true;
+}
+
+bool Replay_transport::strong_pullup(bool enable) {
+    return replay_written(ONE_WIRE_TRACE_STRONG_PULLUP, enable);
+}
+
+uint32_t Replay_transport::get_micros() const {
+    return micros;
+}
+
+uint32_t Replay_transport::get_micros_of_next_event() const {
+    One_wire_trace_reader next_reader = reader;
+    One_wire_trace_record record;
+    return next_reader.next(&record) ? micros + record.elapsed_us : micros;
+}
+
+uint32_t Replay_transport::get_divergence_count() const {
+    return divergence_count;
+}
+
+bool Replay_transport::is_finished() const {
+    return reader.is_at_end();
+}
+
+void Replay_transport::rewind() {
+    reader.rewind();
+    micros = 0;
+    divergence_count = 0;
+}
+
+bool Replay_transport::replay(uint8_t event, One_wire_trace_record* record) {
+    One_wire_trace_reader next_reader = reader;
+    if (!next_reader.next(record) || record->event != event) {
+        ++divergence_count;
+        return false;
+    }
+    reader = next_reader;
+    micros += record->elapsed_us;
+    return true;
+}
+
+bool Replay_transport::replay_written(uint8_t event, bool value) {
+    One_wire_trace_reader next_reader = reader;
+    One_wire_trace_record record;
+    if (!next_reader.next(&record) || record.event != event || ((record.flags & ONE_WIRE_TRACE_VALUE) != 0) != value) {
+        ++divergence_count;
+        return false;
+    }
+    replay(event, &record);
+    return !(record.flags & ONE_WIRE_TRACE_FAILED);
+}
\ No newline at end of file
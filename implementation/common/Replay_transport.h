@@ -0,0 +1,61 @@
+#pragma once
+#include "One_wire_transport.h"
+#include "One_wire_trace.h"
+
+/**
+ * Transport that plays a recorded trace back, to run the device logic on the
+ * host with the traffic of a field installation. Reads, presence pulses and
+ * failures are the recorded ones, writes are checked against the trace.
+ *
+ * The clock is virtual, it advances by the recorded time of every event
+ * replayed, so time-based logic sees the timing of the installation and the
+ * host only measures the CPU cost of the code under test.
+ *
+ * A call that does not match the next event fails, is counted as a divergence
+ * and does not advance the replay.
+ **/
+class Replay_transport : public One_wire_transport<Replay_transport> {
+public:
+    // The trace is read in place, it must outlive the transport
+    Replay_transport(const uint8_t* trace, size_t length);
+
+    bool reset();
+    bool write_bytes(const uint8_t* bytes, size_t count);
+    bool read_bytes(uint8_t* bytes, size_t count);
+    bool write_bit(bool bit);
+    bool read_bit(bool* bit);
+    bool triplet(bool* id_bit, bool* complement_bit, bool* direction);
+    bool strong_pullup(bool enable);
+
+    uint32_t get_micros() const;
+    // The time of the event to replay next, the one of the last event at the end of the trace
+    uint32_t get_micros_of_next_event() const;
+    uint32_t get_divergence_count() const;
+    bool is_finished() const;
+    void rewind();
+
+private:
+    One_wire_trace_reader reader;
+    uint32_t micros = 0;
+    uint32_t divergence_count = 0;
+
+    bool replay(uint8_t event, One_wire_trace_record* record);
+    // Replays a write of one bit, or of the strong pullup state
+    bool replay_written(uint8_t event, bool value);
+};
+
+// Clock of Transport_backend over a replay, to run the sensor facade on a trace recorded from it:
+//   Replay_clock::replay = &replay_bus;
+//   Basic_one_wire_temp_sensor<Transport_backend<Replay_transport, Replay_clock>> sensor(replay_bus);
+// The checks of the conversion time are not recorded, they happen right before the event they lead
+// to, so they see the time of the next event. The delays are in the recorded times, they do not wait
+struct Replay_clock {
+    static Replay_transport* replay;
+
+    static uint32_t get_micros() {
+        return replay->get_micros_of_next_event();
+    }
+
+    static void delay_ms(uint32_t) {
+    }
+};
\ No newline at end of file
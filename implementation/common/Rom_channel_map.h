@@ -0,0 +1,42 @@
+#pragma once
+#include "One_wire_types.h"
+#include <stdint.h>
+#include <string.h>
+
+#define ROM_CHANNEL_NONE 0xFFFF
+
+// FNV-1a of the family code and serial number, the CRC adds nothing. The low bits of FNV-1a only depend on
+// the low bits of the bytes, so the MurmurHash3 finalizer mixes the high ones down before the modulo.
+// tools/generate_rom_channel_map.py computes the same hash
+inline uint32_t rom_channel_hash(const Device_address rom, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (uint8_t i = 0; i < 7; ++i)
+        hash = (hash ^ rom[i])*16777619u;
+    hash = (hash ^ (hash >> 16))*0x85EBCA6Bu;
+    hash = (hash ^ (hash >> 13))*0xC2B2AE35u;
+    return hash ^ (hash >> 16);
+}
+
+// Maps the ROM codes of an installation to logical channels, e.g. "boiler_in" or "zone3", with a minimal
+// perfect hash generated at build time by tools/generate_rom_channel_map.py. A ROM code goes to a bucket,
+// the seed of the bucket gives its slot and the slot its channel, so a lookup hashes twice and compares
+// one ROM code, however many devices there are. The tables are constexpr and stay in flash. One map can
+// serve the sensors of every bus
+struct Rom_channel_map {
+    const Device_address* roms;             // by channel
+    const char* const* names;               // by channel
+    uint16_t channel_count;
+    const uint16_t* seeds;                  // by bucket
+    uint16_t bucket_count;
+    const uint16_t* slot_channels;          // by slot, channel_count slots
+};
+
+// Returns ROM_CHANNEL_NONE for ROM codes out of the map
+inline uint16_t get_rom_channel(const Rom_channel_map& map, const Device_address rom) {
+    if (map.channel_count == 0 || map.bucket_count == 0)
+        return ROM_CHANNEL_NONE;
+    uint16_t bucket = rom_channel_hash(rom, 0) % map.bucket_count;
+    uint16_t slot = rom_channel_hash(rom, map.seeds[bucket]) % map.channel_count;
+    uint16_t channel = map.slot_channels[slot];
+    return memcmp(map.roms[channel], rom, sizeof(Device_address)) == 0 ? channel : ROM_CHANNEL_NONE;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+#include "One_wire_types.h"
+#include <stdint.h>
+
+class Deadline_listener {
+public:
+    virtual ~Deadline_listener() {}
+    // The readings of the cycle due at deadline_us ended late_us after it. Cycles that would end a
+    // whole period late are skipped and reported with the lateness they would have had
+    virtual void on_deadline_missed(uint32_t deadline_us, uint32_t late_us) = 0;
+};
+
+#define DEFAULT_READ_BUDGET_US_PER_DEVICE 12000
+#define SAMPLE_AVAILABLE_POLL_US 1000
+
+// Reads a group of devices of one sensor with a fixed period. The readings of cycle k are due at
+// first_deadline + k*period, the conversion starts the conversion time plus the read budget before
+// it. The read budget starts at DEFAULT_READ_BUDGET_US_PER_DEVICE per device and grows to the
+// slowest reads seen. Deadlines sit on a fixed grid, so a late cycle does not push the next ones.
+// If the reads end after the next conversion should have started, it starts right after them.
+// Readings go to the reading listener of the sensor. A period shorter than the conversion time
+// plus the reads misses every deadline, lower the resolution or calibrate the conversion time
+template <class Sensor>
+class Sampling_scheduler {
+public:
+    Sampling_scheduler(Sensor& sensor, const Device_address* addresses, uint8_t device_count, uint32_t period_us, uint32_t (*get_micros)())
+        : sensor(sensor), addresses(addresses), device_count(device_count), period_us(period_us), get_micros(get_micros),
+          read_budget_us(DEFAULT_READ_BUDGET_US_PER_DEVICE*(uint32_t)device_count) {
+    }
+
+    // The first readings are due as soon as a conversion and the reads can be done
+    void start() {
+        start(get_micros() + get_conversion_us() + read_budget_us);
+    }
+
+    void start(uint32_t first_deadline_us) {
+        next_deadline_us = first_deadline_us;
+        is_converting = false;
+    }
+
+    // Does what is due and returns the microseconds until something is due again
+    uint32_t run() {
+        uint32_t now_us = get_micros();
+        if (is_converting) {
+            if (is_before(now_us, conversion_start_us + conversion_us))
+                return conversion_start_us + conversion_us - now_us;
+            if (!sensor.is_sample_available())
+                return SAMPLE_AVAILABLE_POLL_US;
+            now_us = read_group(now_us);
+        }
+
+        uint32_t start_us = next_deadline_us - get_conversion_us() - read_budget_us;
+        if (is_before(now_us, start_us))
+            return start_us - now_us;
+        sensor.request_temperatures();
+        conversion_start_us = now_us;
+        conversion_us = get_conversion_us();
+        is_converting = true;
+        return conversion_us;
+    }
+
+    void set_deadline_listener(Deadline_listener* listener) {
+        deadline_listener = listener;
+    }
+
+    uint32_t get_missed_deadlines() const {
+        return missed_deadlines;
+    }
+
+    uint32_t get_read_budget_us() const {
+        return read_budget_us;
+    }
+
+    uint32_t get_next_deadline_us() const {
+        return next_deadline_us;
+    }
+
+private:
+    Sensor& sensor;
+    const Device_address* addresses;
+    uint8_t device_count;
+    uint32_t period_us;
+    uint32_t (*get_micros)();
+    Deadline_listener* deadline_listener = nullptr;
+
+    uint32_t read_budget_us;
+    uint32_t next_deadline_us = 0;
+    uint32_t conversion_start_us = 0;
+    uint32_t conversion_us = 0;
+    bool is_converting = false;
+    uint32_t missed_deadlines = 0;
+
+    static bool is_before(uint32_t time_us, uint32_t reference_us) {
+        return (int32_t)(time_us - reference_us) < 0;
+    }
+
+    uint32_t get_conversion_us() const {
+        return 1000*(uint32_t)sensor.get_millis_to_wait_for_conversion(sensor.get_resolution());
+    }
+
+    uint32_t read_group(uint32_t read_start_us) {
+        for (uint8_t i = 0; i < device_count; ++i) {
+            float temperature;
+            sensor.read_temperature_in_celsius(addresses[i], &temperature);
+        }
+        uint32_t read_end_us = get_micros();
+        if (read_end_us - read_start_us > read_budget_us)
+            read_budget_us = read_end_us - read_start_us;
+        is_converting = false;
+
+        if (is_before(next_deadline_us, read_end_us))
+            report_missed_deadline(next_deadline_us, read_end_us - next_deadline_us);
+        next_deadline_us += period_us;
+        // A cycle that would end a whole period late is skipped, late cycles are not served in a burst
+        uint32_t start_us = next_deadline_us - conversion_us - read_budget_us;
+        while (!is_before(read_end_us, start_us + period_us)) {
+            report_missed_deadline(next_deadline_us, read_end_us - start_us);
+            next_deadline_us += period_us;
+            start_us += period_us;
+        }
+        return read_end_us;
+    }
+
+    void report_missed_deadline(uint32_t deadline_us, uint32_t late_us) {
+        ++missed_deadlines;
+        if (deadline_listener != nullptr)
+            deadline_listener->on_deadline_missed(deadline_us, late_us);
+    }
+};
\ No newline at end of file
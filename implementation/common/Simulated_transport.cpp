@@ -0,0 +1,238 @@
+#include "Simulated_transport.h"
+#include "Ds18x20.h"
+#include <math.h>
+
+#define CONFIG_RESOLUTION_SHIFT 5
+#define DS18S20_COUNT_PER_C 16
+
+bool Simulated_transport::add_device(const Device_address rom, float temperature_in_celsius, bool is_parasite_powered) {
+    if (device_count >= MAX_DEVICES)
+        return false;
+    Device& device = devices[device_count++];
+    memcpy(device.rom, rom, sizeof(Device_address));
+    const uint8_t power_up_scratchpad[DS18X20_SCRATCHPAD_SIZE] = {0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0x00};
+    memcpy(device.scratchpad, power_up_scratchpad, sizeof(power_up_scratchpad));
+    memcpy(device.eeprom, &power_up_scratchpad[2], sizeof(device.eeprom));
+    update_scratchpad_crc(device);
+    device.temperature_in_celsius = temperature_in_celsius;
+    device.is_parasite_powered = is_parasite_powered;
+    device.is_selected = false;
+    return true;
+}
+
+void Simulated_transport::set_temperature(uint8_t device_index, float temperature_in_celsius) {
+    devices[device_index].temperature_in_celsius = temperature_in_celsius;
+}
+
+uint8_t* Simulated_transport::get_scratchpad(uint8_t device_index) {
+    return devices[device_index].scratchpad;
+}
+
+bool Simulated_transport::is_strong_pullup_enabled() const {
+    return is_pullup_enabled;
+}
+
+uint8_t Simulated_transport::get_device_count() const {
+    return device_count;
+}
+
+bool Simulated_transport::reset() {
+    is_pullup_enabled = false;
+    byte_in_progress = 0;
+    bit_index = 0;
+    byte_index = 0;
+    for (uint8_t i = 0; i < device_count; ++i)
+        devices[i].is_selected = true;
+    state = device_count > 0 ? ROM_COMMAND : IDLE;
+    return device_count > 0;
+}
+
+bool Simulated_transport::write_bytes(const uint8_t* bytes, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        for (uint8_t bit = 0; bit < 8; ++bit)
+            if (!write_bit((bytes[i] >> bit) & 0x01))
+                return false;
+    return true;
+}
+
+bool Simulated_transport::read_bytes(uint8_t* bytes, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        bytes[i] = 0;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            bool value;
+            if (!read_bit(&value))
+                return false;
+            if (value)
+                bytes[i] |= 1 << bit;
+        }
+    }
+    return true;
+}
+
+bool Simulated_transport::write_bit(bool bit) {
+    is_pullup_enabled = false;
+    if (state == SEARCH_ID_BIT || state == SEARCH_COMPLEMENT_BIT)
+        return false;
+    if (state == SEARCH_DIRECTION) {
+        for (uint8_t i = 0; i < device_count; ++i)
+            if (((devices[i].rom[bit_index / 8] >> (bit_index % 8)) & 0x01) != bit)
+                devices[i].is_selected = false;
+        state = ++bit_index < 64 ? SEARCH_ID_BIT : IDLE;
+        return true;
+    }
+
+    if (bit)
+        byte_in_progress |= 1 << bit_index;
+    if (++bit_index == 8) {
+        uint8_t byte = byte_in_progress;
+        byte_in_progress = 0;
+        bit_index = 0;
+        on_byte_written(byte);
+    }
+    return true;
+}
+
+bool Simulated_transport::read_bit(bool* bit) {
+    is_pullup_enabled = false;
+    switch (state) {
+        case SEARCH_ID_BIT:
+            *bit = get_wired_and_bit(true, bit_index);
+            state = SEARCH_COMPLEMENT_BIT;
+            break;
+        case SEARCH_COMPLEMENT_BIT:
+            // Low when a selected device has a 1 in this bit
+            *bit = true;
+            for (uint8_t i = 0; i < device_count; ++i)
+                if (devices[i].is_selected && ((devices[i].rom[bit_index / 8] >> (bit_index % 8)) & 0x01))
+                    *bit = false;
+            state = SEARCH_DIRECTION;
+            break;
+        case READ_ROM:
+            *bit = get_wired_and_bit(true, byte_index);
+            if (++byte_index == 64)
+                state = IDLE;
+            break;
+        case READ_SCRATCHPAD:
+            *bit = get_wired_and_bit(false, byte_index);
+            if (++byte_index == DS18X20_SCRATCHPAD_SIZE*8)
+                state = IDLE;
+            break;
+        case READ_POWER_SUPPLY:
+            *bit = true;
+            for (uint8_t i = 0; i < device_count; ++i)
+                if (devices[i].is_selected && devices[i].is_parasite_powered)
+                    *bit = false;
+            break;
+        case SEARCH_DIRECTION:
+            return false;
+        default:
+            *bit = true;
+            break;
+    }
+    return true;
+}
+
+bool Simulated_transport::strong_pullup(bool enable) {
+    is_pullup_enabled = enable;
+    return true;
+}
+
+void Simulated_transport::on_byte_written(uint8_t byte) {
+    switch (state) {
+        case ROM_COMMAND:
+            if (byte == ONE_WIRE_SKIP_ROM)
+                state = FUNCTION_COMMAND;
+            else if (byte == ONE_WIRE_MATCH_ROM)
+                state = MATCH_ROM;
+            else if (byte == ONE_WIRE_SEARCH_ROM)
+                state = SEARCH_ID_BIT;
+            else if (byte == ONE_WIRE_READ_ROM)
+                state = READ_ROM;
+            else
+                state = IDLE;
+            byte_index = 0;
+            break;
+        case MATCH_ROM:
+            matched_rom[byte_index++] = byte;
+            if (byte_index == sizeof(Device_address)) {
+                for (uint8_t i = 0; i < device_count; ++i)
+                    devices[i].is_selected = memcmp(devices[i].rom, matched_rom, sizeof(Device_address)) == 0;
+                state = FUNCTION_COMMAND;
+                byte_index = 0;
+            }
+            break;
+        case FUNCTION_COMMAND:
+            on_function_command(byte);
+            break;
+        case WRITE_SCRATCHPAD:
+            for (uint8_t i = 0; i < device_count; ++i) {
+                if (!devices[i].is_selected)
+                    continue;
+                devices[i].scratchpad[2 + byte_index] = byte;
+                update_scratchpad_crc(devices[i]);
+            }
+            if (++byte_index == sizeof(Device::eeprom))
+                state = IDLE;
+            break;
+        default:
+            break;
+    }
+}
+
+void Simulated_transport::on_function_command(uint8_t command) {
+    state = IDLE;
+    byte_index = 0;
+    for (uint8_t i = 0; i < device_count; ++i) {
+        Device& device = devices[i];
+        if (!device.is_selected)
+            continue;
+        if (command == DS18X20_CONVERT_T)
+            convert_temperature(device);
+        else if (command == DS18X20_COPY_SCRATCHPAD)
+            memcpy(device.eeprom, &device.scratchpad[2], sizeof(device.eeprom));
+        else if (command == DS18X20_RECALL_E2) {
+            memcpy(&device.scratchpad[2], device.eeprom, sizeof(device.eeprom));
+            update_scratchpad_crc(device);
+        }
+    }
+    if (command == DS18X20_READ_SCRATCHPAD)
+        state = READ_SCRATCHPAD;
+    else if (command == DS18X20_WRITE_SCRATCHPAD)
+        state = WRITE_SCRATCHPAD;
+    else if (command == DS18X20_READ_POWER_SUPPLY)
+        state = READ_POWER_SUPPLY;
+}
+
+bool Simulated_transport::get_wired_and_bit(bool is_rom, uint8_t bit_number) const {
+    for (uint8_t i = 0; i < device_count; ++i) {
+        if (!devices[i].is_selected)
+            continue;
+        const uint8_t* data = is_rom ? devices[i].rom : devices[i].scratchpad;
+        if (!((data[bit_number / 8] >> (bit_number % 8)) & 0x01))
+            return false;
+    }
+    return true;
+}
+
+void Simulated_transport::convert_temperature(Device& device) {
+    int16_t raw;
+    if (device.rom[0] == DS18S20_FAMILY_ID) {
+        // Half degree register plus COUNT_REMAIN for the extended resolution
+        float whole_degrees = floorf(device.temperature_in_celsius + 0.25f);
+        raw = (int16_t)(whole_degrees*2);
+        float count_remain = DS18S20_COUNT_PER_C - (device.temperature_in_celsius - whole_degrees + 0.25f)*DS18S20_COUNT_PER_C;
+        device.scratchpad[6] = (uint8_t)(count_remain + 0.5f);
+    }
+    else {
+        uint8_t ignored_bits = 3 - ((device.scratchpad[4] >> CONFIG_RESOLUTION_SHIFT) & 0x03);
+        raw = (int16_t)floorf(device.temperature_in_celsius*16);
+        raw &= ~((1 << ignored_bits) - 1);
+    }
+    device.scratchpad[0] = raw & 0xFF;
+    device.scratchpad[1] = (raw >> 8) & 0xFF;
+    update_scratchpad_crc(device);
+}
+
+void Simulated_transport::update_scratchpad_crc(Device& device) {
+    device.scratchpad[DS18X20_SCRATCHPAD_CRC] = one_wire_crc8(device.scratchpad, DS18X20_SCRATCHPAD_CRC);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+#include "One_wire_transport.h"
+
+/**
+ * In-memory 1-Wire bus with DS18x20 devices, decoded one time slot at a time.
+ * Reads are the wired AND of every device still selected, so ROM search and
+ * SKIP ROM reads behave as on a real bus. Conversions finish instantly.
+ **/
+class Simulated_transport : public One_wire_transport<Simulated_transport> {
+public:
+    static const uint8_t MAX_DEVICES = 8;
+
+    // Returns false if the bus is full
+    bool add_device(const Device_address rom, float temperature_in_celsius, bool is_parasite_powered = false);
+    void set_temperature(uint8_t device_index, float temperature_in_celsius);
+
+    // Scratchpad of a device, writable to inject corrupted data
+    uint8_t* get_scratchpad(uint8_t device_index);
+    bool is_strong_pullup_enabled() const;
+    uint8_t get_device_count() const;
+
+    bool reset();
+    bool write_bytes(const uint8_t* bytes, size_t count);
+    bool read_bytes(uint8_t* bytes, size_t count);
+    bool write_bit(bool bit);
+    bool read_bit(bool* bit);
+    bool strong_pullup(bool enable);
+
+private:
+    enum State {
+        IDLE,
+        ROM_COMMAND,
+        MATCH_ROM,
+        SEARCH_ID_BIT,
+        SEARCH_COMPLEMENT_BIT,
+        SEARCH_DIRECTION,
+        READ_ROM,
+        FUNCTION_COMMAND,
+        READ_SCRATCHPAD,
+        WRITE_SCRATCHPAD,
+        READ_POWER_SUPPLY
+    };
+
+    struct Device {
+        Device_address rom;
+        uint8_t scratchpad[9];
+        uint8_t eeprom[3];
+        float temperature_in_celsius;
+        bool is_parasite_powered;
+        bool is_selected;
+    };
+
+    Device devices[MAX_DEVICES];
+    uint8_t device_count = 0;
+    State state = IDLE;
+    uint8_t byte_in_progress = 0;
+    uint8_t bit_index = 0;          // bit of byte_in_progress or of the ROM being searched
+    uint8_t byte_index = 0;         // byte of the ROM, scratchpad or data being transferred
+    Device_address matched_rom;
+    bool is_pullup_enabled = false;
+
+    void on_byte_written(uint8_t byte);
+    void on_function_command(uint8_t command);
+    bool get_wired_and_bit(bool is_rom, uint8_t bit_number) const;
+    void convert_temperature(Device& device);
+    static void update_scratchpad_crc(Device& device);
+};
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include "One_wire_slot_timing.h"
+#include <stdint.h>
+
+// Microseconds added to every measured time, the polling of the drivers does not count the time of its reads
+#define SLOT_TIMING_MARGIN_US 2
+// Devices sample a write slot and drive a read slot from 15 us after its start
+#define SLOT_TIMING_DEVICE_SAMPLE_US 15
+// Spec window of the presence pulse, the measurements may exceed it by the polling error
+#define SLOT_TIMING_MAX_PRESENCE_DELAY_US 60
+#define SLOT_TIMING_MIN_PRESENCE_LOW_US 60
+#define SLOT_TIMING_MAX_PRESENCE_LOW_US 240
+#define SLOT_TIMING_POLLING_ERROR_US 10
+// Spec minimums of a standard speed slot, its write 0 low time and the recovery between slots
+#define SLOT_TIMING_MIN_SLOT_US 60
+#define SLOT_TIMING_MIN_WRITE_0_LOW_US 60
+#define SLOT_TIMING_MIN_RECOVERY_US 1
+
+inline uint16_t get_shorter_us(uint16_t base_us, uint16_t calibrated_us) {
+    return calibrated_us < base_us ? calibrated_us : base_us;
+}
+
+inline uint16_t get_longer_us(uint16_t first_us, uint16_t second_us) {
+    return first_us > second_us ? first_us : second_us;
+}
+
+// The tightest safe timing for the measured bus, never longer than base. The slots and the write 0
+// low time are cut to their spec minimums, the recovery between slots only waits for the rise
+// time, a read is sampled once a 1 has risen and the presence pulse is sampled in its middle.
+// The reset pulse and the write 1 and read low times stay the ones of base, and the presence
+// sample and reset recovery still add up to the 480 us of base.
+// Returns false if there was no presence pulse or the bus is too slow for the spec
+inline bool calibrate_slot_timing(const One_wire_bus_measurement& measurement, const One_wire_slot_timing& base,
+                                  One_wire_slot_timing* calibrated) {
+    uint16_t rise_us = measurement.rise_us + SLOT_TIMING_MARGIN_US;
+    if (base.read_low_us + rise_us >= SLOT_TIMING_DEVICE_SAMPLE_US ||
+        base.write_1_low_us + rise_us > SLOT_TIMING_DEVICE_SAMPLE_US)
+        return false;
+
+    if (measurement.presence_delay_us > SLOT_TIMING_MAX_PRESENCE_DELAY_US + SLOT_TIMING_POLLING_ERROR_US ||
+        measurement.presence_low_us + SLOT_TIMING_POLLING_ERROR_US < SLOT_TIMING_MIN_PRESENCE_LOW_US ||
+        measurement.presence_low_us > SLOT_TIMING_MAX_PRESENCE_LOW_US + SLOT_TIMING_POLLING_ERROR_US)
+        return false;
+    uint16_t presence_sample_us = measurement.presence_delay_us + measurement.presence_low_us/2;
+    uint16_t reset_release_us = base.presence_sample_us + base.reset_recovery_us;
+    if (measurement.presence_delay_us + measurement.presence_low_us >= reset_release_us)
+        return false;
+
+    *calibrated = base;
+    calibrated->presence_sample_us = presence_sample_us;
+    calibrated->reset_recovery_us = reset_release_us - presence_sample_us;
+    calibrated->write_0_low_us = get_shorter_us(base.write_0_low_us, SLOT_TIMING_MIN_WRITE_0_LOW_US);
+    calibrated->write_slot_us = get_shorter_us(base.write_slot_us, get_longer_us(SLOT_TIMING_MIN_SLOT_US, calibrated->write_0_low_us));
+    calibrated->read_sample_us = get_shorter_us(base.read_sample_us, rise_us);
+    calibrated->read_slot_us = get_shorter_us(base.read_slot_us, SLOT_TIMING_MIN_SLOT_US);
+    calibrated->recovery_us = get_shorter_us(base.recovery_us, get_longer_us(SLOT_TIMING_MIN_RECOVERY_US, rise_us));
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "Snapshot_frame.h"
+#include "One_wire_crc.h"
+
+#define RAW_UNITS_PER_DEGREE 16
+#define VERSION_SHIFT 5
+#define BUS_ID_MASK 0x1F
+#define BITS_PER_BYTE 8
+
+int16_t get_raw_temperature_FROM_celsius(float temperature_in_celsius) {
+    float raw = temperature_in_celsius * RAW_UNITS_PER_DEGREE;
+    return (int16_t)(raw < 0 ? raw - 0.5f : raw + 0.5f);
+}
+
+float get_celsius_FROM_raw_temperature(int16_t raw_temperature) {
+    return (float)raw_temperature / RAW_UNITS_PER_DEGREE;
+}
+
+static void write_little_endian(uint8_t* destination, uint32_t value, uint8_t bytes) {
+    for (uint8_t i = 0; i < bytes; ++i) {
+        destination[i] = value & 0xFF;
+        value >>= BITS_PER_BYTE;
+    }
+}
+
+static uint32_t read_little_endian(const uint8_t* source, uint8_t bytes) {
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i)
+        value = (value << BITS_PER_BYTE) | source[i];
+    return value;
+}
+
+Snapshot_frame_encoder::Snapshot_frame_encoder(uint8_t* buffer, size_t buffer_size)
+    : buffer(buffer), buffer_size(buffer_size) {
+}
+
+bool Snapshot_frame_encoder::begin(uint8_t bus_id, uint32_t timestamp) {
+    length = 0;
+    if (bus_id > SNAPSHOT_FRAME_MAX_BUS_ID || buffer_size < SNAPSHOT_FRAME_SIZE(0))
+        return false;
+
+    buffer[0] = (SNAPSHOT_FRAME_VERSION << VERSION_SHIFT) | bus_id;
+    write_little_endian(&buffer[1], timestamp, 4);
+    length = SNAPSHOT_FRAME_HEADER_SIZE;
+    return true;
+}
+
+bool Snapshot_frame_encoder::add_reading(uint8_t rom_index, int16_t raw_temperature) {
+    if (length == 0 || length + SNAPSHOT_FRAME_READING_SIZE + SNAPSHOT_FRAME_CRC_SIZE > buffer_size)
+        return false;
+    if (length == SNAPSHOT_FRAME_HEADER_SIZE + SNAPSHOT_FRAME_READING_SIZE*SNAPSHOT_FRAME_MAX_READINGS)
+        return false;
+
+    buffer[length] = rom_index;
+    write_little_endian(&buffer[length + 1], (uint16_t)raw_temperature, 2);
+    length += SNAPSHOT_FRAME_READING_SIZE;
+    return true;
+}
+
+bool Snapshot_frame_encoder::add_reading_in_celsius(uint8_t rom_index, float temperature_in_celsius) {
+    return add_reading(rom_index, get_raw_temperature_FROM_celsius(temperature_in_celsius));
+}
+
+size_t Snapshot_frame_encoder::finish() {
+    if (length == 0)
+        return 0;
+
+    uint16_t crc = one_wire_crc16(buffer, length);
+    write_little_endian(&buffer[length], crc, SNAPSHOT_FRAME_CRC_SIZE);
+    size_t frame_length = length + SNAPSHOT_FRAME_CRC_SIZE;
+    length = 0;
+    return frame_length;
+}
+
+Snapshot_frame_decoder::Snapshot_frame_decoder(const uint8_t* frame, size_t frame_length)
+    : frame(frame), frame_length(frame_length) {
+    is_frame_valid = false;
+    if (frame_length < SNAPSHOT_FRAME_SIZE(0))
+        return;
+    if ((frame_length - SNAPSHOT_FRAME_SIZE(0)) % SNAPSHOT_FRAME_READING_SIZE != 0)
+        return;
+    if (frame_length > SNAPSHOT_FRAME_SIZE(SNAPSHOT_FRAME_MAX_READINGS))
+        return;
+    if (get_version() != SNAPSHOT_FRAME_VERSION)
+        return;
+
+    size_t crc_position = frame_length - SNAPSHOT_FRAME_CRC_SIZE;
+    uint16_t crc = one_wire_crc16(frame, crc_position);
+    is_frame_valid = crc == read_little_endian(&frame[crc_position], SNAPSHOT_FRAME_CRC_SIZE);
+}
+
+bool Snapshot_frame_decoder::is_valid() const {
+    return is_frame_valid;
+}
+
+uint8_t Snapshot_frame_decoder::get_version() const {
+    if (frame_length < SNAPSHOT_FRAME_HEADER_SIZE)
+        return 0;
+    return frame[0] >> VERSION_SHIFT;
+}
+
+uint8_t Snapshot_frame_decoder::get_bus_id() const {
+    if (frame_length < SNAPSHOT_FRAME_HEADER_SIZE)
+        return 0;
+    return frame[0] & BUS_ID_MASK;
+}
+
+uint32_t Snapshot_frame_decoder::get_timestamp() const {
+    if (frame_length < SNAPSHOT_FRAME_HEADER_SIZE)
+        return 0;
+    return read_little_endian(&frame[1], 4);
+}
+
+uint8_t Snapshot_frame_decoder::get_reading_count() const {
+    if (!is_frame_valid)
+        return 0;
+    return (frame_length - SNAPSHOT_FRAME_SIZE(0)) / SNAPSHOT_FRAME_READING_SIZE;
+}
+
+bool Snapshot_frame_decoder::get_reading(uint8_t index, uint8_t* rom_index, int16_t* raw_temperature) const {
+    if (index >= get_reading_count())
+        return false;
+
+    const uint8_t* reading = &frame[SNAPSHOT_FRAME_HEADER_SIZE + index*SNAPSHOT_FRAME_READING_SIZE];
+    *rom_index = reading[0];
+    *raw_temperature = (int16_t)read_little_endian(&reading[1], 2);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * SNAPSHOT FRAME (version 1, little endian)
+ *
+ *  byte 0         : version (3 upper bits) | bus id (5 lower bits)
+ *  bytes 1..4     : timestamp
+ *  3 bytes/reading: ROM index, raw temperature (int16, 1/16 degree Celsius)
+ *  last 2 bytes   : CRC16 of all the previous bytes, computed with one_wire_crc16()
+ *
+ * The reading count is implied by the frame length: 64 readings take 199 bytes.
+ * A frame holds up to 255 readings.
+ **/
+
+#define SNAPSHOT_FRAME_VERSION 1
+#define SNAPSHOT_FRAME_MAX_BUS_ID 31
+#define SNAPSHOT_FRAME_MAX_READINGS 255
+#define SNAPSHOT_FRAME_HEADER_SIZE 5
+#define SNAPSHOT_FRAME_READING_SIZE 3
+#define SNAPSHOT_FRAME_CRC_SIZE 2
+#define SNAPSHOT_FRAME_SIZE(reading_count) (SNAPSHOT_FRAME_HEADER_SIZE + SNAPSHOT_FRAME_READING_SIZE*(reading_count) + SNAPSHOT_FRAME_CRC_SIZE)
+
+int16_t get_raw_temperature_FROM_celsius(float temperature_in_celsius);
+float get_celsius_FROM_raw_temperature(int16_t raw_temperature);
+
+class Snapshot_frame_encoder {
+public:
+    Snapshot_frame_encoder(uint8_t* buffer, size_t buffer_size);
+
+    bool begin(uint8_t bus_id, uint32_t timestamp);
+    bool add_reading(uint8_t rom_index, int16_t raw_temperature);
+    bool add_reading_in_celsius(uint8_t rom_index, float temperature_in_celsius);
+
+    // Appends the CRC and returns the frame length, or 0 if the frame could not be closed
+    size_t finish();
+
+private:
+    uint8_t* buffer;
+    size_t buffer_size;
+    size_t length = 0;
+};
+
+class Snapshot_frame_decoder {
+public:
+    // The frame is read in place, it must outlive the decoder
+    Snapshot_frame_decoder(const uint8_t* frame, size_t frame_length);
+
+    bool is_valid() const;
+
+    // The header fields are 0 if the frame is shorter than the header
+    uint8_t get_version() const;
+    uint8_t get_bus_id() const;
+    uint32_t get_timestamp() const;
+    uint8_t get_reading_count() const;
+    bool get_reading(uint8_t index, uint8_t* rom_index, int16_t* raw_temperature) const;
+
+private:
+    const uint8_t* frame;
+    size_t frame_length;
+    bool is_frame_valid;
+};
\ No newline at end of file
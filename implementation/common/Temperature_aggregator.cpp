@@ -0,0 +1,160 @@
+#include "Temperature_aggregator.h"
+
+#define CENTI_PER_UNIT 100
+
+int16_t get_centi_celsius_FROM_celsius(float temperature_in_celsius) {
+    float centi_celsius = temperature_in_celsius * CENTI_PER_UNIT;
+    return (int16_t)(centi_celsius < 0 ? centi_celsius - 0.5f : centi_celsius + 0.5f);
+}
+
+static int16_t get_rounded_average(int32_t sum, uint16_t count) {
+    if (count == 0)
+        return 0;
+    int32_t half_count = count / 2;
+    return (int16_t)((sum < 0 ? sum - half_count : sum + half_count) / count);
+}
+
+Tumbling_window_aggregator::Tumbling_window_aggregator(uint16_t samples_per_window)
+    : samples_per_window(samples_per_window == 0 ? 1 : samples_per_window) {
+}
+
+bool Tumbling_window_aggregator::add(float temperature_in_celsius) {
+    int16_t sample = get_centi_celsius_FROM_celsius(temperature_in_celsius);
+    if (count == 0 || sample < min)
+        min = sample;
+    if (count == 0 || sample > max)
+        max = sample;
+    sum += sample;
+    ++count;
+
+    if (count < samples_per_window)
+        return false;
+
+    last_summary.min_centi_celsius = min;
+    last_summary.max_centi_celsius = max;
+    last_summary.avg_centi_celsius = get_rounded_average(sum, count);
+    last_summary.sample_count = count;
+    count = 0;
+    sum = 0;
+    return true;
+}
+
+Temperature_summary Tumbling_window_aggregator::get_summary() const {
+    return last_summary;
+}
+
+void Tumbling_window_aggregator::reset() {
+    count = 0;
+    sum = 0;
+    last_summary = {0, 0, 0, 0};
+}
+
+Sliding_window_aggregator::Sliding_window_aggregator(uint16_t window_length) {
+    if (window_length < BUCKETS)
+        window_length = BUCKETS;
+    samples_per_bucket = window_length / BUCKETS;
+    buckets_with_one_more_sample = window_length % BUCKETS;
+    reset();
+}
+
+void Sliding_window_aggregator::clear_bucket(Bucket& bucket) {
+    bucket.min = 0;
+    bucket.max = 0;
+    bucket.sum = 0;
+    bucket.count = 0;
+}
+
+uint16_t Sliding_window_aggregator::get_bucket_size(uint8_t index) const {
+    return index < buckets_with_one_more_sample ? samples_per_bucket + 1 : samples_per_bucket;
+}
+
+bool Sliding_window_aggregator::add(float temperature_in_celsius) {
+    Bucket& bucket = buckets[current_bucket];
+    if (is_current_bucket_old) {
+        clear_bucket(bucket);
+        is_current_bucket_old = false;
+    }
+    int16_t sample = get_centi_celsius_FROM_celsius(temperature_in_celsius);
+    if (bucket.count == 0 || sample < bucket.min)
+        bucket.min = sample;
+    if (bucket.count == 0 || sample > bucket.max)
+        bucket.max = sample;
+    bucket.sum += sample;
+    ++bucket.count;
+
+    if (bucket.count < get_bucket_size(current_bucket))
+        return false;
+
+    current_bucket = (current_bucket + 1) % BUCKETS;
+    is_current_bucket_old = true;
+    return true;
+}
+
+Temperature_summary Sliding_window_aggregator::get_summary() const {
+    Temperature_summary summary = {0, 0, 0, 0};
+    int32_t sum = 0;
+    for (uint8_t i = 0; i < BUCKETS; ++i) {
+        const Bucket& bucket = buckets[i];
+        if (bucket.count == 0)
+            continue;
+        if (summary.sample_count == 0 || bucket.min < summary.min_centi_celsius)
+            summary.min_centi_celsius = bucket.min;
+        if (summary.sample_count == 0 || bucket.max > summary.max_centi_celsius)
+            summary.max_centi_celsius = bucket.max;
+        sum += bucket.sum;
+        summary.sample_count += bucket.count;
+    }
+    summary.avg_centi_celsius = get_rounded_average(sum, summary.sample_count);
+    return summary;
+}
+
+void Sliding_window_aggregator::reset() {
+    current_bucket = 0;
+    is_current_bucket_old = false;
+    for (uint8_t i = 0; i < BUCKETS; ++i)
+        clear_bucket(buckets[i]);
+}
+
+Ema_aggregator::Ema_aggregator(float alpha, uint16_t samples_per_summary)
+    : alpha(alpha), samples_per_summary(samples_per_summary == 0 ? 1 : samples_per_summary) {
+}
+
+bool Ema_aggregator::add(float temperature_in_celsius) {
+    int16_t sample = get_centi_celsius_FROM_celsius(temperature_in_celsius);
+    if (!has_samples) {
+        average = temperature_in_celsius;
+        has_samples = true;
+    } else {
+        average += alpha * (temperature_in_celsius - average);
+    }
+    // The first sample after a summary starts the min and max of the next one
+    if (samples_since_summary == samples_per_summary)
+        samples_since_summary = 0;
+    if (samples_since_summary == 0 || sample < min)
+        min = sample;
+    if (samples_since_summary == 0 || sample > max)
+        max = sample;
+    ++samples_since_summary;
+    return samples_since_summary == samples_per_summary;
+}
+
+Temperature_summary Ema_aggregator::get_summary() const {
+    Temperature_summary summary;
+    summary.min_centi_celsius = min;
+    summary.max_centi_celsius = max;
+    summary.avg_centi_celsius = get_centi_celsius_FROM_celsius(average);
+    summary.sample_count = samples_since_summary;
+    return summary;
+}
+
+float Ema_aggregator::get_average_in_celsius() const {
+    return average;
+}
+
+void Ema_aggregator::reset() {
+    has_samples = false;
+    samples_since_summary = 0;
+    average = 0;
+    min = 0;
+    max = 0;
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+#include "One_wire_types.h"
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * Incremental aggregators: every sample costs O(1) and the state size does not
+ * depend on the window length. Temperatures are kept in centi-degrees Celsius.
+ **/
+
+struct Temperature_summary {
+    int16_t min_centi_celsius;
+    int16_t max_centi_celsius;
+    int16_t avg_centi_celsius;
+    uint16_t sample_count;
+};
+
+int16_t get_centi_celsius_FROM_celsius(float temperature_in_celsius);
+
+class Tumbling_window_aggregator {
+public:
+    explicit Tumbling_window_aggregator(uint16_t samples_per_window = 1);
+
+    // Returns true when the sample closes a window and a new summary is ready
+    bool add(float temperature_in_celsius);
+    Temperature_summary get_summary() const;
+    void reset();
+
+private:
+    uint16_t samples_per_window;
+    uint16_t count = 0;
+    int16_t min = 0;
+    int16_t max = 0;
+    int32_t sum = 0;
+    Temperature_summary last_summary = {0, 0, 0, 0};
+};
+
+class Sliding_window_aggregator {
+public:
+    // The window slides one bucket at a time. The window_length % BUCKETS first buckets take one
+    // sample more than the others, so a full window holds window_length samples, at least BUCKETS
+    static const uint8_t BUCKETS = 8;
+
+    explicit Sliding_window_aggregator(uint16_t window_length = BUCKETS);
+
+    // Returns true when the sample closes a bucket, then the summary covers the whole window.
+    // The oldest bucket is dropped when the next sample comes
+    bool add(float temperature_in_celsius);
+    Temperature_summary get_summary() const;
+    void reset();
+
+private:
+    struct Bucket {
+        int16_t min;
+        int16_t max;
+        int32_t sum;
+        uint16_t count;
+    };
+
+    uint16_t samples_per_bucket;
+    uint8_t buckets_with_one_more_sample;
+    uint8_t current_bucket = 0;
+    bool is_current_bucket_old = false;
+    Bucket buckets[BUCKETS];
+
+    void clear_bucket(Bucket& bucket);
+    uint16_t get_bucket_size(uint8_t index) const;
+};
+
+class Ema_aggregator {
+public:
+    // alpha in (0, 1]: weight of the newest sample. A summary is emitted every samples_per_summary samples,
+    // its min and max are the ones of those samples
+    explicit Ema_aggregator(float alpha = 1.0f, uint16_t samples_per_summary = 1);
+
+    bool add(float temperature_in_celsius);
+    Temperature_summary get_summary() const;
+    float get_average_in_celsius() const;
+    void reset();
+
+private:
+    float alpha;
+    uint16_t samples_per_summary;
+    uint16_t samples_since_summary = 0;
+    bool has_samples = false;
+    float average = 0;
+    int16_t min = 0;
+    int16_t max = 0;
+};
+
+/**
+ * Keeps one aggregator per sensor in a fixed table and plugs into the
+ * facade read path through One_wire_temp_sensor::set_reading_listener().
+ **/
+template <typename Aggregator, uint8_t MAX_SENSORS>
+class Aggregator_bank : public Reading_listener {
+public:
+    typedef void Summary_handler(const Device_address, const Temperature_summary&);
+
+    explicit Aggregator_bank(const Aggregator& prototype, Summary_handler* handler = nullptr)
+        : handler(handler) {
+        for (uint8_t i = 0; i < MAX_SENSORS; ++i) {
+            aggregators[i] = prototype;
+            is_slot_used[i] = false;
+        }
+    }
+
+    void on_reading(const Device_address address, float temperature_in_celsius) override {
+        Aggregator* aggregator = get_or_assign_slot(address);
+        if (aggregator == nullptr)
+            return;
+        if (aggregator->add(temperature_in_celsius) && handler != nullptr)
+            handler(address, aggregator->get_summary());
+    }
+
+    Aggregator* get_aggregator(const Device_address address) {
+        for (uint8_t i = 0; i < MAX_SENSORS; ++i)
+            if (is_slot_used[i] && memcmp(addresses[i], address, sizeof(Device_address)) == 0)
+                return &aggregators[i];
+        return nullptr;
+    }
+
+private:
+    Summary_handler* handler;
+    Device_address addresses[MAX_SENSORS];
+    bool is_slot_used[MAX_SENSORS];
+    Aggregator aggregators[MAX_SENSORS];
+
+    Aggregator* get_or_assign_slot(const Device_address address) {
+        Aggregator* aggregator = get_aggregator(address);
+        if (aggregator != nullptr)
+            return aggregator;
+        for (uint8_t i = 0; i < MAX_SENSORS; ++i) {
+            if (!is_slot_used[i]) {
+                memcpy(addresses[i], address, sizeof(Device_address));
+                is_slot_used[i] = true;
+                return &aggregators[i];
+            }
+        }
+        return nullptr;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include "One_wire_transport.h"
+#include "One_wire_trace.h"
+
+/**
+ * Transport that records every call to another transport in a trace, e.g.
+ * Ds18x20<Traced_transport<Ds2482_transport>>. The search triplet of the
+ * traced transport is kept, native or not, and recorded as one event.
+ **/
+template <typename Transport>
+class Traced_transport : public One_wire_transport<Traced_transport<Transport>> {
+public:
+    Traced_transport(Transport& bus, One_wire_trace& trace) : bus(bus), trace(trace) {
+    }
+
+    bool reset() {
+        bool is_present = bus.reset();
+        trace.record(ONE_WIRE_TRACE_RESET, is_present ? ONE_WIRE_TRACE_VALUE : 0);
+        return is_present;
+    }
+
+    // A failed write is recorded as failed on every byte, the transport does not tell which one failed
+    bool write_bytes(const uint8_t* bytes, size_t count) {
+        bool is_written = bus.write_bytes(bytes, count);
+        for (size_t i = 0; i < count; ++i)
+            trace.record(ONE_WIRE_TRACE_WRITE_BYTE, is_written ? 0 : ONE_WIRE_TRACE_FAILED, bytes[i]);
+        return is_written;
+    }
+
+    bool read_bytes(uint8_t* bytes, size_t count) {
+        bool is_read = bus.read_bytes(bytes, count);
+        for (size_t i = 0; i < count; ++i)
+            trace.record(ONE_WIRE_TRACE_READ_BYTE, is_read ? 0 : ONE_WIRE_TRACE_FAILED, is_read ? bytes[i] : 0);
+        return is_read;
+    }
+
+    bool write_bit(bool bit) {
+        bool is_written = bus.write_bit(bit);
+        trace.record(ONE_WIRE_TRACE_WRITE_BIT, get_flags(is_written, bit));
+        return is_written;
+    }
+
+    bool read_bit(bool* bit) {
+        bool is_read = bus.read_bit(bit);
+        trace.record(ONE_WIRE_TRACE_READ_BIT, get_flags(is_read, is_read && *bit));
+        return is_read;
+    }
+
+    bool triplet(bool* id_bit, bool* complement_bit, bool* direction) {
+        bool is_done = bus.triplet(id_bit, complement_bit, direction);
+        uint8_t flags = get_flags(is_done, is_done && *id_bit);
+        if (is_done && *complement_bit)
+            flags |= ONE_WIRE_TRACE_COMPLEMENT_BIT;
+        if (is_done && *direction)
+            flags |= ONE_WIRE_TRACE_DIRECTION;
+        trace.record(ONE_WIRE_TRACE_TRIPLET, flags);
+        return is_done;
+    }
+
+    bool strong_pullup(bool enable) {
+        bool is_done = bus.strong_pullup(enable);
+        trace.record(ONE_WIRE_TRACE_STRONG_PULLUP, get_flags(is_done, enable));
+        return is_done;
+    }
+
+    // The traced transport keeps its own, e.g. one critical section. It is recorded as the byte then
+    // the strong pullup, as the default one of a replay calls them
+    bool write_byte_and_strong_pullup(uint8_t byte) {
+        bool is_done = bus.write_byte_and_strong_pullup(byte);
+        trace.record(ONE_WIRE_TRACE_WRITE_BYTE, is_done ? 0 : ONE_WIRE_TRACE_FAILED, byte);
+        trace.record(ONE_WIRE_TRACE_STRONG_PULLUP, get_flags(is_done, true));
+        return is_done;
+    }
+
+    // The slot timing is not a bus event, it is not recorded
+    One_wire_slot_timing get_slot_timing() {
+        return bus.get_slot_timing();
+    }
+
+    One_wire_slot_timing get_slow_slot_timing() {
+        return bus.get_slow_slot_timing();
+    }
+
+    void set_slot_timing(const One_wire_slot_timing& timing) {
+        bus.set_slot_timing(timing);
+    }
+
+    void count_crc_failure() {
+        bus.count_crc_failure();
+    }
+
+private:
+    Transport& bus;
+    One_wire_trace& trace;
+
+    static uint8_t get_flags(bool is_done, bool value) {
+        return (is_done ? 0 : ONE_WIRE_TRACE_FAILED) | (value ? ONE_WIRE_TRACE_VALUE : 0);
+    }
+};
\ No newline at end of file
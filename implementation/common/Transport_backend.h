@@ -0,0 +1,350 @@
+#pragma once
+#include "One_wire_types.h"
+#include "Ds18x20.h"
+#include "Conversion_time.h"
+#include "Bus_snapshot.h"
+#include "Known_bus.h"
+#include "One_wire_slot_timing.h"
+#if defined(ONE_WIRE_BUS_STATS)
+    #include "One_wire_bus_stats.h"
+#endif
+#if defined(ONE_WIRE_TRACE)
+    #include "One_wire_trace.h"
+#endif
+#include <stdint.h>
+#include <string.h>
+
+static_assert(BUS_SNAPSHOT_MAX_DEVICES == ONE_WIRE_MAX_DEVICES, "The snapshot holds every device the backend keeps");
+
+// Backend of Basic_one_wire_temp_sensor running Ds18x20 over any One_wire_transport, e.g.
+//   Basic_one_wire_temp_sensor<Transport_backend<Uart_transport, Esp_idf_clock>> sensor(uart_transport);
+// The transport is not owned and must outlive the backend. The clock provides
+//   static uint32_t get_micros();
+//   static void delay_ms(uint32_t millis);       waits at least millis
+template <typename Transport, typename Clock>
+class Transport_backend {
+public:
+    typedef Transport& Bus;
+
+    explicit Transport_backend(Transport& bus, Bus_snapshot_store* snapshot_store = nullptr) : bus(bus), ds18x20(bus) {
+        if (!warm_start(snapshot_store))
+            search_devices();
+    }
+
+    Transport_backend(Transport& bus, const Known_bus& known_bus) : bus(bus), ds18x20(bus) {
+        if (!known_start(known_bus))
+            search_devices();
+    }
+
+    bool is_search_deferred() const {
+        return is_search_pending;
+    }
+
+    void search_devices() {
+        scan();
+        is_search_pending = false;
+    }
+
+    // Finds the devices, their power mode and resolution again, e.g. after a device was added or replaced
+    void rescan_devices() {
+        scan();
+    }
+
+    // Returns false if the snapshot does not hold every device found, it has the first ones then
+    bool get_snapshot(Bus_snapshot* snapshot) const {
+        snapshot->resolution = resolution;
+        snapshot->has_parasite_devices = has_parasite_devices;
+        snapshot->device_count = device_count < BUS_SNAPSHOT_MAX_DEVICES ? device_count : BUS_SNAPSHOT_MAX_DEVICES;
+        memcpy(snapshot->addresses, addresses, sizeof(Device_address)*snapshot->device_count);
+        return snapshot->device_count == device_count;
+    }
+
+    // The devices found by the last search, the bus is not searched again
+    uint8_t get_device_count() const {
+        return device_count;
+    }
+
+    void get_device_address_on_index(Device_address address_to_get, uint8_t index) const {
+        if (index < device_count)
+            memcpy(address_to_get, addresses[index], sizeof(Device_address));
+    }
+
+    uint8_t scan_devices_of_family(uint8_t family_id, Device_address* addresses_found, uint8_t max_addresses) {
+        return (uint8_t)ds18x20.scan_devices_of_family(family_id, addresses_found, max_addresses);
+    }
+
+    uint8_t get_resolution() const {
+        return resolution;
+    }
+
+    // Copied to the EEPROM of every device, so it survives a power cycle. The alarm thresholds TH and TL
+    // are read back and kept, a DS18S20 has no configuration register and is skipped. Returns false if
+    // a device was not written, the resolution in use does not change then
+    bool set_resolution(uint8_t new_resolution) {
+        if (new_resolution < DS18X20_MIN_RESOLUTION || new_resolution > DS18X20_MAX_RESOLUTION)
+            return false;
+
+        bool is_every_device_set = true;
+        for (uint8_t i = 0; i < device_count; ++i)
+            if (configs[i].family_id != DS18S20_FAMILY_ID && !write_resolution(i, new_resolution))
+                is_every_device_set = false;
+        if (is_every_device_set)
+            resolution = new_resolution;
+        return is_every_device_set;
+    }
+
+    // The slowest device found sets the time. A device configured below resolution converts at its own one,
+    // e.g. on a bus of mixed resolutions, and a DS18S20 takes 750 ms at any resolution
+    uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const {
+        if (device_count == 0)
+            return get_max_conversion_millis(DS18B20_FAMILY_ID, resolution);
+        uint16_t millis_to_wait = 0;
+        for (uint8_t i = 0; i < device_count; ++i) {
+            uint8_t device_resolution = resolution;
+            if (configs[i].is_scratchpad_read && get_config_resolution(configs[i].config) < resolution)
+                device_resolution = get_config_resolution(configs[i].config);
+            uint16_t device_millis = get_max_conversion_millis(configs[i].family_id, device_resolution);
+            if (device_millis > millis_to_wait)
+                millis_to_wait = device_millis;
+        }
+        return millis_to_wait;
+    }
+
+    bool is_parasite_powered() const {
+        return has_parasite_devices;
+    }
+
+    void start_conversion() {
+        ds18x20.measure(nullptr, has_parasite_devices);
+        micros_at_conversion_request = Clock::get_micros();
+    }
+
+    // A parasite powered device needs the strong pullup of start_conversion() and is not started
+    bool start_conversion_of(const Device_address address) {
+        const Device_config* config = find_config(address);
+        if (config != nullptr ? config->is_parasite_powered : has_parasite_devices)
+            return false;
+        return ds18x20.measure(address, false) == ONE_WIRE_OK;
+    }
+
+    // The strong pullup lasts the conversion time of the resolution in use, not the 750 ms worst case
+    void convert_BLOCKING(uint16_t millis_to_wait) {
+        micros_at_conversion_request = 0;
+        ds18x20.measure(nullptr, has_parasite_devices);
+        Clock::delay_ms(millis_to_wait);
+        if (has_parasite_devices)
+            depower();
+    }
+
+    bool is_conversion_time_over(uint16_t millis_to_wait) {
+        return Clock::get_micros() - micros_at_conversion_request >= 1000*(uint32_t)millis_to_wait;
+    }
+
+    bool poll_conversion() {
+        bool is_done = false;
+        return ds18x20.poll_measure(&is_done) == ONE_WIRE_OK && is_done;
+    }
+
+    void depower() {
+        ds18x20.depower();
+    }
+
+    bool measure_bus(One_wire_bus_measurement* measurement) {
+        return bus.measure_bus(measurement);
+    }
+
+    One_wire_slot_timing get_slot_timing() const {
+        return bus.get_slot_timing();
+    }
+
+    void set_slot_timing(const One_wire_slot_timing& timing) {
+        bus.set_slot_timing(timing);
+    }
+
+    bool read_celsius(const Device_address address, float* temperature_in_celsius, const Read_retry_policy& policy) const {
+        uint16_t backoff_ms = policy.first_backoff_ms;
+        One_wire_status status = ONE_WIRE_BUS_ERROR;
+        for (uint8_t attempt = 1; attempt <= policy.max_attempts; ++attempt) {
+            bool is_slow_attempt = policy.use_slow_timing_on_last_attempt && attempt > 1 && attempt == policy.max_attempts;
+            One_wire_slot_timing previous_timing;
+            if (is_slow_attempt) {
+                previous_timing = bus.get_slot_timing();
+                bus.set_slot_timing(bus.get_slow_slot_timing());
+            }
+            status = ds18x20.read_temperature(address, temperature_in_celsius);
+            if (is_slow_attempt)
+                bus.set_slot_timing(previous_timing);
+            if (status == ONE_WIRE_CRC_ERROR)
+                bus.count_crc_failure();
+
+            if (status == ONE_WIRE_OK || attempt == policy.max_attempts)
+                break;
+            if (backoff_ms > 0)
+                Clock::delay_ms(backoff_ms);
+            backoff_ms = backoff_ms*2 < policy.max_backoff_ms ? backoff_ms*2 : policy.max_backoff_ms;
+        }
+        return status == ONE_WIRE_OK;
+    }
+
+    uint32_t get_micros() const {
+        return Clock::get_micros();
+    }
+
+    uint32_t get_micros_at_conversion_request() const {
+        return micros_at_conversion_request;
+    }
+
+#if defined(ONE_WIRE_BUS_STATS)
+    One_wire_bus_stats get_bus_stats() const {
+        return bus.get_bus_stats();
+    }
+
+    void clear_bus_stats() {
+        bus.clear_bus_stats();
+    }
+#endif
+
+#if defined(ONE_WIRE_TRACE)
+    void set_trace(One_wire_trace* trace) {
+        bus.set_trace(trace);
+    }
+#endif
+
+private:
+    // What the last search read from a device. A snapshot or a known bus only tells the power mode of the
+    // whole bus and no scratchpad, it is read when set_resolution() needs it
+    struct Device_config {
+        uint8_t family_id;
+        bool is_parasite_powered;
+        bool is_scratchpad_read;                // th, tl and config are valid
+        uint8_t th;
+        uint8_t tl;
+        uint8_t config;                         // configuration register, a DS18S20 has none
+    };
+
+    Transport& bus;
+    // Reading a device does not change the backend
+    mutable Ds18x20<Transport> ds18x20;
+
+    // The devices found, or the table of a known bus which is never copied
+    Device_address found_addresses[ONE_WIRE_MAX_DEVICES];
+    const Device_address* addresses = found_addresses;
+    Device_config configs[ONE_WIRE_MAX_DEVICES];
+    uint8_t device_count = 0;
+    uint8_t resolution = DS18X20_MAX_RESOLUTION;
+    bool has_parasite_devices = false;
+    bool is_search_pending = false;
+    uint32_t micros_at_conversion_request = 0;
+
+    // A presence pulse is enough to trust the snapshot until the deferred search
+    bool warm_start(Bus_snapshot_store* snapshot_store) {
+        Bus_snapshot snapshot;
+        if (snapshot_store == nullptr || !snapshot_store->load(&snapshot) || snapshot.device_count > ONE_WIRE_MAX_DEVICES ||
+            !bus.reset())
+            return false;
+        memcpy(found_addresses, snapshot.addresses, sizeof(Device_address)*snapshot.device_count);
+        addresses = found_addresses;
+        take_devices(snapshot.device_count, snapshot.resolution, snapshot.has_parasite_devices);
+        is_search_pending = true;
+        return true;
+    }
+
+    // The devices of the table are never searched, with no presence pulse or an invalid table the bus is
+    // searched as usual
+    bool known_start(const Known_bus& known_bus) {
+        if (!known_bus.is_valid || !bus.reset())
+            return false;
+        addresses = known_bus.addresses;
+        take_devices(known_bus.device_count, known_bus.resolution, known_bus.has_parasite_devices);
+        return true;
+    }
+
+    void take_devices(uint8_t count, uint8_t devices_resolution, bool are_parasite_powered) {
+        device_count = count;
+        for (uint8_t i = 0; i < device_count; ++i)
+            configs[i] = {addresses[i][0], are_parasite_powered, false, 0, 0, 0};
+        resolution = devices_resolution;
+        has_parasite_devices = are_parasite_powered;
+    }
+
+    // nullptr if the device was not found
+    const Device_config* find_config(const Device_address address) const {
+        for (uint8_t i = 0; i < device_count; ++i)
+            if (memcmp(addresses[i], address, sizeof(Device_address)) == 0)
+                return &configs[i];
+        return nullptr;
+    }
+
+    static uint8_t get_config_resolution(uint8_t config) {
+        return DS18X20_MIN_RESOLUTION + ((config & DS18X20_CONFIG_RESOLUTION_MASK) >> DS18X20_CONFIG_RESOLUTION_SHIFT);
+    }
+
+    bool write_resolution(uint8_t index, uint8_t new_resolution) {
+        Device_config& device = configs[index];
+        if (!device.is_scratchpad_read && !read_config(index))
+            return false;
+        uint8_t config = (uint8_t)((device.config & ~DS18X20_CONFIG_RESOLUTION_MASK) |
+                                   (new_resolution - DS18X20_MIN_RESOLUTION) << DS18X20_CONFIG_RESOLUTION_SHIFT);
+        const uint8_t th_tl_config[3] = {device.th, device.tl, config};
+        if (ds18x20.write_scratchpad(addresses[index], th_tl_config) != ONE_WIRE_OK ||
+            ds18x20.copy_scratchpad(addresses[index]) != ONE_WIRE_OK)
+            return false;
+        Clock::delay_ms(DS18X20_COPY_SCRATCHPAD_MS);
+        ds18x20.depower();
+        device.config = config;
+        return true;
+    }
+
+    void scan() {
+        addresses = found_addresses;
+        device_count = (uint8_t)ds18x20.scan_devices(found_addresses, ONE_WIRE_MAX_DEVICES);
+        for (uint8_t i = 0; i < device_count; ++i)
+            configs[i] = {addresses[i][0], false, false, 0, 0, 0};
+        detect_power_mode();
+        read_configs();
+    }
+
+    // One read of the whole bus, only if a device pulls it low every device is read alone. A device whose
+    // power supply can not be read keeps the strong pullup, it is harmless for externally powered devices
+    void detect_power_mode() {
+        if (device_count == 0)
+            return;
+        bool is_any_device_parasite_powered = false;
+        One_wire_status status = ds18x20.read_power_supply(nullptr, &is_any_device_parasite_powered);
+        has_parasite_devices = false;
+        if (status == ONE_WIRE_OK && !is_any_device_parasite_powered)
+            return;
+        for (uint8_t i = 0; i < device_count; ++i) {
+            bool is_parasite_powered = true;
+            if (ds18x20.read_power_supply(addresses[i], &is_parasite_powered) != ONE_WIRE_OK)
+                is_parasite_powered = true;
+            configs[i].is_parasite_powered = is_parasite_powered;
+            has_parasite_devices = has_parasite_devices || is_parasite_powered;
+        }
+    }
+
+    // The resolution in use is the highest configured, a DS18S20 has no configuration register
+    void read_configs() {
+        uint8_t highest_resolution = 0;
+        for (uint8_t i = 0; i < device_count; ++i) {
+            if (configs[i].family_id == DS18S20_FAMILY_ID || !read_config(i))
+                continue;
+            uint8_t device_resolution = get_config_resolution(configs[i].config);
+            if (device_resolution > highest_resolution)
+                highest_resolution = device_resolution;
+        }
+        if (highest_resolution != 0)
+            resolution = highest_resolution;
+    }
+
+    bool read_config(uint8_t index) {
+        uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+        if (ds18x20.read_scratchpad(addresses[index], scratchpad) != ONE_WIRE_OK)
+            return false;
+        configs[index].th = scratchpad[DS18X20_SCRATCHPAD_TH];
+        configs[index].tl = scratchpad[DS18X20_SCRATCHPAD_TL];
+        configs[index].config = scratchpad[DS18X20_SCRATCHPAD_CONFIG];
+        configs[index].is_scratchpad_read = true;
+        return true;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Uart_transport.h"
+#include <string.h>
+
+void get_uart_slots_FROM_byte(uint8_t byte, uint8_t* slots) {
+    for (uint8_t i = 0; i < UART_TRANSPORT_SLOTS_PER_BYTE; ++i) {
+        slots[i] = (byte & 0x01) ? UART_TRANSPORT_BIT_1 : UART_TRANSPORT_BIT_0;
+        byte >>= 1;
+    }
+}
+
+uint8_t get_byte_FROM_uart_slots(const uint8_t* slots) {
+    uint8_t byte = 0;
+    for (uint8_t i = 0; i < UART_TRANSPORT_SLOTS_PER_BYTE; ++i)
+        if (slots[i] == UART_TRANSPORT_BIT_1)
+            byte |= 1 << i;
+    return byte;
+}
+
+Uart_transport::Uart_transport(Uart_port& port) : port(port) {
+}
+
+bool Uart_transport::reset() {
+    uint8_t reset_pulse = UART_TRANSPORT_RESET_PULSE;
+    uint8_t reset_echo;
+    port.set_baud_rate(UART_TRANSPORT_RESET_BAUD_RATE);
+    bool is_echo_complete = port.transfer(&reset_pulse, &reset_echo, 1);
+    port.set_baud_rate(UART_TRANSPORT_DATA_BAUD_RATE);
+    return is_echo_complete && reset_echo != UART_TRANSPORT_RESET_PULSE;
+}
+
+bool Uart_transport::write_bytes(const uint8_t* bytes, size_t count) {
+    while (count > 0) {
+        size_t bytes_in_transfer = count < BYTES_PER_TRANSFER ? count : BYTES_PER_TRANSFER;
+        size_t slot_count = bytes_in_transfer*UART_TRANSPORT_SLOTS_PER_BYTE;
+        for (size_t i = 0; i < bytes_in_transfer; ++i)
+            get_uart_slots_FROM_byte(bytes[i], &slots[i*UART_TRANSPORT_SLOTS_PER_BYTE]);
+        if (!port.transfer(slots, echo, slot_count) || memcmp(slots, echo, slot_count) != 0)
+            return false;
+        bytes += bytes_in_transfer;
+        count -= bytes_in_transfer;
+    }
+    return true;
+}
+
+bool Uart_transport::read_bytes(uint8_t* bytes, size_t count) {
+    memset(slots, UART_TRANSPORT_BIT_1, sizeof(slots));
+    while (count > 0) {
+        size_t bytes_in_transfer = count < BYTES_PER_TRANSFER ? count : BYTES_PER_TRANSFER;
+        if (!port.transfer(slots, echo, bytes_in_transfer*UART_TRANSPORT_SLOTS_PER_BYTE))
+            return false;
+        for (size_t i = 0; i < bytes_in_transfer; ++i)
+            bytes[i] = get_byte_FROM_uart_slots(&echo[i*UART_TRANSPORT_SLOTS_PER_BYTE]);
+        bytes += bytes_in_transfer;
+        count -= bytes_in_transfer;
+    }
+    return true;
+}
+
+bool Uart_transport::write_bit(bool bit) {
+    uint8_t slot = bit ? UART_TRANSPORT_BIT_1 : UART_TRANSPORT_BIT_0;
+    uint8_t slot_echo;
+    return port.transfer(&slot, &slot_echo, 1) && slot_echo == slot;
+}
+
+bool Uart_transport::read_bit(bool* bit) {
+    uint8_t slot = UART_TRANSPORT_BIT_1;
+    uint8_t slot_echo;
+    if (!port.transfer(&slot, &slot_echo, 1))
+        return false;
+    *bit = slot_echo == UART_TRANSPORT_BIT_1;
+    return true;
+}
+
+bool Uart_transport::strong_pullup(bool enable) {
+    return !enable;
+}
\ No newline at end of file
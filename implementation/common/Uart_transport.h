@@ -0,0 +1,60 @@
+#pragma once
+#include "One_wire_transport.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * 1-Wire over a UART whose TX (open drain) and RX lines are tied to the bus.
+ *
+ *  reset: 0xF0 at 9600 baud, a device answering with a presence pulse
+ *         pulls down the upper bits of the echo
+ *  slots: one UART byte per bit at 115200 baud, 0xFF writes or reads a 1,
+ *         0x00 writes a 0. A read slot echoes 0xFF only if no device pulled
+ *         the bus low
+ *
+ * Whole bytes are clocked by the UART (FIFO or DMA), the CPU only encodes
+ * the slots before the transfer and compares the echo after it.
+ **/
+
+#define UART_TRANSPORT_RESET_BAUD_RATE 9600
+#define UART_TRANSPORT_DATA_BAUD_RATE 115200
+#define UART_TRANSPORT_RESET_PULSE 0xF0
+#define UART_TRANSPORT_BIT_1 0xFF
+#define UART_TRANSPORT_BIT_0 0x00
+#define UART_TRANSPORT_SLOTS_PER_BYTE 8
+
+class Uart_port {
+public:
+    virtual ~Uart_port() {}
+    virtual void set_baud_rate(uint32_t baud_rate) = 0;
+
+    // Writes the bytes and reads back their echo. Returns false if the echo is incomplete
+    virtual bool transfer(const uint8_t* to_write, uint8_t* echo, size_t length) = 0;
+};
+
+void get_uart_slots_FROM_byte(uint8_t byte, uint8_t* slots);
+uint8_t get_byte_FROM_uart_slots(const uint8_t* slots);
+
+class Uart_transport : public One_wire_transport<Uart_transport> {
+public:
+    explicit Uart_transport(Uart_port& port);
+
+    // Returns true if a device answered with a presence pulse
+    bool reset();
+
+    // Every function below returns false if the echo is incomplete or, for writes, does not match
+    bool write_bytes(const uint8_t* bytes, size_t count);
+    bool read_bytes(uint8_t* bytes, size_t count);
+    bool write_bit(bool bit);
+    bool read_bit(bool* bit);
+
+    // The open drain TX can not drive the bus high, parasite devices need an external pullup
+    bool strong_pullup(bool enable);
+
+private:
+    static const uint8_t BYTES_PER_TRANSFER = 8;
+
+    Uart_port& port;
+    uint8_t slots[BYTES_PER_TRANSFER*UART_TRANSPORT_SLOTS_PER_BYTE];
+    uint8_t echo[BYTES_PER_TRANSFER*UART_TRANSPORT_SLOTS_PER_BYTE];
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include "CppUTestExt/MockSupport.h"
+
+// Returns the number of microseconds since the board began running the current program
+inline unsigned long micros() {
+    mock().actualCall("micros");
+    return mock().returnUnsignedLongIntValueOrDefault(0);
+}
+
+// Returns the number of milliseconds since the board began running the current program
+inline unsigned long millis() {
+    mock().actualCall("millis");
+    return mock().returnUnsignedLongIntValueOrDefault(0);
+}
+
+// Pauses the program for the amount of time (in milliseconds) specified as parameter
+inline void delay(unsigned long ms) {
+    mock().actualCall("delay")
+          .withUnsignedLongIntParameter("ms", ms);
+}
\ No newline at end of file
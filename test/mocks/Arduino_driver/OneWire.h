@@ -1,5 +1,8 @@
 #pragma once
 #include "CppUTestExt/MockSupport.h"
+#include "../../../implementation/common/One_wire_bus_stats.h"
+#include "../../../implementation/common/One_wire_slot_timing.h"
+#include "../../../implementation/common/One_wire_trace_events.h"
 
 class OneWire
 {
@@ -8,4 +11,101 @@ class OneWire
         mock().actualCall("OneWire->constructor(uint8_t)")
               .withUnsignedIntParameter("pin", pin);
     }
+
+    static constexpr One_wire_slot_timing STANDARD_TIMING = {480, 70, 410, 10, 65, 60, 3, 10, 61, 5};
+    static constexpr One_wire_slot_timing SLOW_TIMING = {480, 70, 410, 10, 65, 60, 3, 10, 61, 30};
+
+    void set_timing(const One_wire_slot_timing &new_timing) {
+        mock().actualCall("OneWire->set_timing(const One_wire_slot_timing&)")
+              .withUnsignedIntParameter("recovery_us", new_timing.recovery_us);
+    }
+
+    const One_wire_slot_timing &get_timing() const {
+        mock().actualCall("OneWire->get_timing()");
+        return STANDARD_TIMING;
+    }
+
+    bool measure_bus(One_wire_bus_measurement *measurement) {
+        mock().actualCall("OneWire->measure_bus(One_wire_bus_measurement*)")
+              .withOutputParameter("measurement", measurement);
+        return mock().returnBoolValueOrDefault(false);
+    }
+
+    uint8_t reset(void) {
+        mock().actualCall("OneWire->reset()");
+        return mock().returnUnsignedIntValueOrDefault(0);
+    }
+
+    void write(uint8_t v, uint8_t power = 0) {
+        mock().actualCall("OneWire->write(uint8_t, uint8_t)")
+              .withUnsignedIntParameter("v", v)
+              .withUnsignedIntParameter("power", power);
+    }
+
+    void write_bytes(const uint8_t *buf, uint16_t count, bool power = 0) {
+        mock().actualCall("OneWire->write_bytes(const uint8_t*, uint16_t, bool)")
+              .withMemoryBufferParameter("buf", buf, count)
+              .withBoolParameter("power", power);
+    }
+
+    void read_bytes(uint8_t *buf, uint16_t count) {
+        mock().actualCall("OneWire->read_bytes(uint8_t*, uint16_t)")
+              .withOutputParameter("buf", buf)
+              .withUnsignedIntParameter("count", count);
+    }
+
+    void write_bit(uint8_t v) {
+        mock().actualCall("OneWire->write_bit(uint8_t)")
+              .withUnsignedIntParameter("v", v);
+    }
+
+    uint8_t read_bit(void) {
+        mock().actualCall("OneWire->read_bit()");
+        return mock().returnUnsignedIntValueOrDefault(1);
+    }
+
+    void power(void) {
+        mock().actualCall("OneWire->power()");
+    }
+
+    void depower(void) {
+        mock().actualCall("OneWire->depower()");
+    }
+
+    static uint8_t crc8(const uint8_t *addr, uint8_t len) {
+        uint8_t crc = 0;
+        while (len--) {
+            uint8_t inbyte = *addr++;
+            for (uint8_t i = 8; i; i--) {
+                uint8_t mix = (crc ^ inbyte) & 0x01;
+                crc >>= 1;
+                if (mix) crc ^= 0x8C;
+                inbyte >>= 1;
+            }
+        }
+        return crc;
+    }
+
+#if defined(ONE_WIRE_TRACE)
+    void set_trace_hook(One_wire_trace_hook hook, void *context) {
+        mock().actualCall("OneWire->set_trace_hook(One_wire_trace_hook, void*)")
+              .withBoolParameter("has_hook", hook != nullptr)
+              .withPointerParameter("context", context);
+    }
+#endif
+
+#if defined(ONE_WIRE_BUS_STATS)
+    void get_stats(One_wire_bus_stats *stats_to_get) const {
+        mock().actualCall("OneWire->get_stats(One_wire_bus_stats*)")
+              .withOutputParameter("stats_to_get", stats_to_get);
+    }
+
+    void clear_stats() {
+        mock().actualCall("OneWire->clear_stats()");
+    }
+
+    void count_crc_failure() {
+        mock().actualCall("OneWire->count_crc_failure()");
+    }
+#endif
 };
\ No newline at end of file
@@ -8,4 +8,19 @@ int64_t esp_timer_get_time(void)
 {
     mock().actualCall("esp_timer_get_time");
     return mock().returnLongLongIntValueOrDefault(0);
+}
+
+typedef uint32_t TickType_t;
+#define configTICK_RATE_HZ 100
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+
+/**
+ * @brief Delay a task for a given number of ticks
+ * @param xTicksToDelay The amount of time, in tick periods, that the calling task should block
+ */
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    mock().actualCall("vTaskDelay")
+          .withUnsignedIntParameter("xTicksToDelay", xTicksToDelay);
 }
\ No newline at end of file
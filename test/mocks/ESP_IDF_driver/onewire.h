@@ -0,0 +1,331 @@
+/**
+ * @file onewire.h
+ * @defgroup onewire onewire
+ * @{
+ *
+ * Routines to access devices using the Dallas Semiconductor 1-Wire(tm)
+ * protocol.
+ *
+ * The CRC routines are pure functions, so they are copied from the driver
+ * instead of being mocked.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "CppUTestExt/MockSupport.h"
+#include "../../../implementation/common/One_wire_slot_timing.h"
+#include "../../../implementation/common/One_wire_bus_stats.h"
+#include "../../../implementation/common/One_wire_trace_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    GPIO_NUM_NC = -1,    /*!< Use to signal not connected to S/W */
+    GPIO_NUM_0 = 0,     /*!< GPIO0, input and output */
+    GPIO_NUM_1 = 1,     /*!< GPIO1, input and output */
+    GPIO_NUM_2 = 2,     /*!< GPIO2, input and output */
+    GPIO_NUM_3 = 3,     /*!< GPIO3, input and output */
+    GPIO_NUM_4 = 4,     /*!< GPIO4, input and output */
+    GPIO_NUM_5 = 5,     /*!< GPIO5, input and output */
+    GPIO_NUM_6 = 6,     /*!< GPIO6, input and output */
+    GPIO_NUM_7 = 7,     /*!< GPIO7, input and output */
+    GPIO_NUM_8 = 8,     /*!< GPIO8, input and output */
+    GPIO_NUM_9 = 9,     /*!< GPIO9, input and output */
+    GPIO_NUM_10 = 10,   /*!< GPIO10, input and output */
+    GPIO_NUM_11 = 11,   /*!< GPIO11, input and output */
+    GPIO_NUM_12 = 12,   /*!< GPIO12, input and output */
+    GPIO_NUM_13 = 13,   /*!< GPIO13, input and output */
+    GPIO_NUM_14 = 14,   /*!< GPIO14, input and output */
+    GPIO_NUM_15 = 15,   /*!< GPIO15, input and output */
+    GPIO_NUM_16 = 16,   /*!< GPIO16, input and output */
+    GPIO_NUM_17 = 17,   /*!< GPIO17, input and output */
+    GPIO_NUM_18 = 18,   /*!< GPIO18, input and output */
+    GPIO_NUM_19 = 19,   /*!< GPIO19, input and output */
+    GPIO_NUM_20 = 20,   /*!< GPIO20, input and output */
+    GPIO_NUM_21 = 21,   /*!< GPIO21, input and output */
+    GPIO_NUM_22 = 22,   /*!< GPIO22, input and output */
+    GPIO_NUM_23 = 23,   /*!< GPIO23, input and output */
+    GPIO_NUM_25 = 25,   /*!< GPIO25, input and output */
+    GPIO_NUM_26 = 26,   /*!< GPIO26, input and output */
+    GPIO_NUM_27 = 27,   /*!< GPIO27, input and output */
+    GPIO_NUM_28 = 28,   /*!< GPIO28, input and output */
+    GPIO_NUM_29 = 29,   /*!< GPIO29, input and output */
+    GPIO_NUM_30 = 30,   /*!< GPIO30, input and output */
+    GPIO_NUM_31 = 31,   /*!< GPIO31, input and output */
+    GPIO_NUM_32 = 32,   /*!< GPIO32, input and output */
+    GPIO_NUM_33 = 33,   /*!< GPIO33, input and output */
+    GPIO_NUM_34 = 34,   /*!< GPIO34, input mode only */
+    GPIO_NUM_35 = 35,   /*!< GPIO35, input mode only */
+    GPIO_NUM_36 = 36,   /*!< GPIO36, input mode only */
+    GPIO_NUM_37 = 37,   /*!< GPIO37, input mode only */
+    GPIO_NUM_38 = 38,   /*!< GPIO38, input mode only */
+    GPIO_NUM_39 = 39,   /*!< GPIO39, input mode only */
+    GPIO_NUM_MAX,
+} gpio_num_t;
+
+/**
+ * @brief Compute a Dallas Semiconductor 8 bit CRC.
+ *
+ * These are used in the ROM address and scratchpad registers to verify the
+ * transmitted data is correct.
+ */
+inline uint8_t onewire_crc8(const uint8_t *data, uint8_t len)
+{
+    uint8_t crc = 0;
+
+    while (len--)
+    {
+        uint8_t inbyte = *data++;
+        for (int i = 8; i; i--)
+        {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix)
+                crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Write bytes to the 1-Wire bus.
+ *
+ * @param pin    The GPIO pin connected to the 1-Wire bus.
+ * @param buf    The bytes to write
+ * @param count  Number of bytes to write
+ *
+ * @return `true` if all bytes are written successfully, `false` otherwise
+ */
+inline bool onewire_write_bytes(uint8_t pin, const uint8_t *buf, size_t count)
+{
+    mock().actualCall("onewire_write_bytes")
+          .withUnsignedIntParameter("pin", pin)
+          .withMemoryBufferParameter("buf", buf, count);
+    return mock().returnBoolValueOrDefault(true);
+}
+
+/**
+ * @brief Read bytes from the 1-Wire bus.
+ *
+ * @param pin         The GPIO pin connected to the 1-Wire bus.
+ * @param[out] buf    Destination of the bytes read
+ * @param count       Number of bytes to read
+ *
+ * @return `true` on success, `false` on error
+ */
+inline bool onewire_read_bytes(uint8_t pin, uint8_t *buf, size_t count)
+{
+    mock().actualCall("onewire_read_bytes")
+          .withUnsignedIntParameter("pin", pin)
+          .withOutputParameter("buf", buf)
+          .withUnsignedLongIntParameter("count", count);
+    return mock().returnBoolValueOrDefault(true);
+}
+
+/**
+ * @brief Write a single bit to the 1-Wire bus.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ * @param v    The bit value to write
+ *
+ * @return `true` if bit written successfully, `false` otherwise
+ */
+inline bool onewire_write_bit(uint8_t pin, bool v)
+{
+    mock().actualCall("onewire_write_bit")
+          .withUnsignedIntParameter("pin", pin)
+          .withBoolParameter("v", v);
+    return mock().returnBoolValueOrDefault(true);
+}
+
+/**
+ * @brief Read a single bit from the 1-Wire bus.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ *
+ * @return the bit value read, or a negative value on error.
+ */
+inline int onewire_read_bit(uint8_t pin)
+{
+    mock().actualCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", pin);
+    return mock().returnIntValueOrDefault(1);
+}
+
+/**
+ * @brief Run one step of the ROM search: read a bit, read its complement
+ *        and write the direction taken.
+ *
+ * @param pin                The GPIO pin connected to the 1-Wire bus.
+ * @param[out] id_bit        The bit read
+ * @param[out] cmp_id_bit    The complement read
+ * @param[in,out] direction  Direction to take when both bits are 0, the
+ *                           direction written on return.
+ *
+ * @return `true` on success, `false` if the bus is held low.
+ */
+inline bool onewire_triplet(uint8_t pin, bool *id_bit, bool *cmp_id_bit, bool *direction)
+{
+    mock().actualCall("onewire_triplet")
+          .withUnsignedIntParameter("pin", pin)
+          .withOutputParameter("id_bit", id_bit)
+          .withOutputParameter("cmp_id_bit", cmp_id_bit)
+          .withOutputParameter("direction", direction);
+    return mock().returnBoolValueOrDefault(true);
+}
+
+/**
+ * @brief Actively drive the bus high.
+ *
+ * @param pin    The GPIO pin connected to the 1-Wire bus.
+ *
+ * @return `true` on success, `false` on error.
+ */
+inline bool onewire_power(uint8_t pin)
+{
+    mock().actualCall("onewire_power")
+          .withUnsignedIntParameter("pin", pin);
+    return mock().returnBoolValueOrDefault(true);
+}
+
+/**
+ * @brief Write a byte and actively drive the bus high right after it.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ * @param v    The byte to write
+ *
+ * @return `true` on success, `false` on error.
+ */
+inline bool onewire_write_power(uint8_t pin, uint8_t v)
+{
+    mock().actualCall("onewire_write_power")
+          .withUnsignedIntParameter("pin", pin)
+          .withUnsignedIntParameter("v", v);
+    return mock().returnBoolValueOrDefault(true);
+}
+
+/**
+ * @brief Stop forcing power onto the bus.
+ *
+ * @param pin    The GPIO pin connected to the 1-Wire bus.
+ */
+inline void onewire_depower(uint8_t pin)
+{
+    mock().actualCall("onewire_depower")
+          .withUnsignedIntParameter("pin", pin);
+}
+
+/**
+ * @brief Perform a 1-Wire reset cycle.
+ *
+ * @param pin  The GPIO pin connected to the 1-Wire bus.
+ *
+ * @return `true` if at least one device responds with a presence pulse,
+ *         `false` if no devices were detected (or the bus is shorted, etc)
+ */
+inline bool onewire_reset(uint8_t pin)
+{
+    mock().actualCall("onewire_reset")
+          .withUnsignedIntParameter("pin", pin);
+    return mock().returnBoolValueOrDefault(false);
+}
+
+static const One_wire_slot_timing ONEWIRE_STANDARD_TIMING = {480, 70, 410, 10, 65, 65, 2, 11, 61, 1};
+static const One_wire_slot_timing ONEWIRE_SLOW_TIMING = {480, 70, 410, 10, 65, 65, 2, 11, 61, 30};
+
+/**
+ * @brief Set the reset and read/write slot timing.
+ *
+ * @param timing  New slot timing
+ */
+inline void onewire_set_timing(const One_wire_slot_timing *timing)
+{
+    mock().actualCall("onewire_set_timing")
+          .withUnsignedIntParameter("write_slot_us", timing->write_slot_us)
+          .withUnsignedIntParameter("recovery_us", timing->recovery_us);
+}
+
+/**
+ * @brief Copy the reset and read/write slot timing in use.
+ *
+ * @param timing  Destination of the slot timing
+ */
+inline void onewire_get_timing(One_wire_slot_timing *timing)
+{
+    mock().actualCall("onewire_get_timing")
+          .withOutputParameter("timing", timing);
+}
+
+/**
+ * @brief Measure how the bus rises after a write slot and the presence pulse
+ *        after a reset.
+ *
+ * @param pin          The GPIO pin connected to the 1-Wire bus.
+ * @param measurement  Destination of the times measured
+ *
+ * @return `true` if a device asserted a presence pulse, `false` otherwise.
+ */
+inline bool onewire_measure(uint8_t pin, One_wire_bus_measurement *measurement)
+{
+    mock().actualCall("onewire_measure")
+          .withUnsignedIntParameter("pin", pin)
+          .withOutputParameter("measurement", measurement);
+    return mock().returnBoolValueOrDefault(false);
+}
+
+#if defined(ONE_WIRE_TRACE)
+
+/**
+ * @brief Report every bus event to a trace hook.
+ *
+ * @param hook     Trace hook, NULL stops the trace
+ * @param context  Passed to the hook
+ */
+inline void onewire_set_trace_hook(One_wire_trace_hook hook, void *context)
+{
+    mock().actualCall("onewire_set_trace_hook")
+          .withBoolParameter("has_hook", hook != nullptr)
+          .withPointerParameter("context", context);
+}
+
+#endif
+
+#if defined(ONE_WIRE_BUS_STATS)
+
+/**
+ * @brief Copy the bus counters.
+ *
+ * @param stats  Destination of the counters
+ */
+inline void onewire_get_stats(One_wire_bus_stats *stats)
+{
+    mock().actualCall("onewire_get_stats")
+          .withOutputParameter("stats", stats);
+}
+
+/**
+ * @brief Set every bus counter to zero.
+ */
+inline void onewire_clear_stats(void)
+{
+    mock().actualCall("onewire_clear_stats");
+}
+
+/**
+ * @brief Count a CRC failure detected by a device driver.
+ */
+inline void onewire_stats_count_crc_failure(void)
+{
+    mock().actualCall("onewire_stats_count_crc_failure");
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
\ No newline at end of file
@@ -1,11 +1,158 @@
 #include "CppUTest/TestHarness.h"
 #include "CppUTestExt/MockSupport.h"
 #include "../../One_wire_temp_sensor.h"
-#include "../mocks/Arduino_driver/DallasTemperature.h"
+#include "../mocks/Arduino_driver/OneWire.h"
 #include <string.h>
 
+#define TEMPERATURE_SENSOR_PIN 4
+const size_t DEVICE_COUNT = 2;
+
+static constexpr Device_address ROMS[DEVICE_COUNT] = {
+    {0x28, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3},
+    {0x28, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC4},
+};
+static uint8_t select_commands[DEVICE_COUNT][1 + sizeof(Device_address)];
+static const uint8_t SKIP_ROM[1] = {ONE_WIRE_SKIP_ROM};
+static const uint8_t CONVERT_T[1] = {DS18X20_CONVERT_T};
+static const uint8_t READ_SCRATCHPAD[1] = {DS18X20_READ_SCRATCHPAD};
+static const uint8_t READ_POWER_SUPPLY[1] = {DS18X20_READ_POWER_SUPPLY};
+static const uint8_t SEARCH_ROM[1] = {ONE_WIRE_SEARCH_ROM};
+
+static void make_select_commands() {
+    for (size_t i = 0; i < DEVICE_COUNT; ++i) {
+        select_commands[i][0] = ONE_WIRE_MATCH_ROM;
+        memcpy(&select_commands[i][1], ROMS[i], sizeof(Device_address));
+    }
+}
+
+static void make_scratchpad(float temperature_in_celsius, uint8_t config, uint8_t* scratchpad) {
+    int16_t raw = (int16_t)(temperature_in_celsius*16);
+    memset(scratchpad, 0, DS18X20_SCRATCHPAD_SIZE);
+    scratchpad[0] = raw & 0xFF;
+    scratchpad[1] = raw >> 8;
+    scratchpad[DS18X20_SCRATCHPAD_CONFIG] = config;
+    scratchpad[DS18X20_SCRATCHPAD_CRC] = OneWire::crc8(scratchpad, DS18X20_SCRATCHPAD_CRC);
+}
+
+static void expect_presence(bool is_device_present) {
+    mock().expectOneCall("OneWire->reset()")
+          .andReturnValue(is_device_present ? 1 : 0);
+}
+
+static void expect_write(const uint8_t* bytes, size_t count) {
+    mock().expectOneCall("OneWire->write_bytes(const uint8_t*, uint16_t, bool)")
+          .withMemoryBufferParameter("buf", bytes, count)
+          .withBoolParameter("power", false);
+}
+
+// The output buffer is read when the call happens, so it must outlive the expectations
+static void expect_scratchpad_read(size_t device_index, const uint8_t* scratchpad) {
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    expect_write(READ_SCRATCHPAD, sizeof(READ_SCRATCHPAD));
+    mock().expectOneCall("OneWire->read_bytes(uint8_t*, uint16_t)")
+          .withOutputParameterReturning("buf", scratchpad, DS18X20_SCRATCHPAD_SIZE)
+          .withUnsignedIntParameter("count", DS18X20_SCRATCHPAD_SIZE);
+}
+
+// Keeps the TH and TL of the scratchpad read, the EEPROM write holds the bus high for 10 ms
+static void expect_resolution_write(size_t device_index, const uint8_t* scratchpad, const uint8_t* th_tl_config) {
+    expect_scratchpad_read(device_index, scratchpad);
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    expect_write(th_tl_config, 1 + 3);
+
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    mock().expectOneCall("OneWire->write(uint8_t, uint8_t)")
+          .withUnsignedIntParameter("v", DS18X20_COPY_SCRATCHPAD)
+          .withUnsignedIntParameter("power", 1);
+    mock().expectOneCall("delay")
+          .withUnsignedLongIntParameter("ms", DS18X20_COPY_SCRATCHPAD_MS);
+    mock().expectOneCall("OneWire->depower()");
+}
+
+// Every device answers with the TH and TL of its power up
+static void set_resolution_of_every_device(One_wire_temp_sensor* sensor, uint8_t resolution) {
+    static uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    static uint8_t th_tl_config[1 + 3];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    th_tl_config[0] = DS18X20_WRITE_SCRATCHPAD;
+    th_tl_config[1] = 0x00;
+    th_tl_config[2] = 0x00;
+    th_tl_config[3] = 0x1F | (resolution - 9) << 5;
+    for (size_t i = 0; i < DEVICE_COUNT; ++i)
+        expect_resolution_write(i, scratchpad, th_tl_config);
+    CHECK_TRUE(sensor->set_resolution(resolution));
+}
+
+static void expect_conversion_start_on_every_device() {
+    expect_presence(true);
+    expect_write(SKIP_ROM, sizeof(SKIP_ROM));
+    expect_write(CONVERT_T, sizeof(CONVERT_T));
+}
+
+// The library has no search triplet, every ROM bit is two read slots and a write slot. With a
+// single device on the bus there is no discrepancy, the search takes the bit read
+static void expect_search_of(const Device_address rom) {
+    expect_presence(true);
+    expect_write(SEARCH_ROM, sizeof(SEARCH_ROM));
+    for (uint8_t bit_number = 0; bit_number < 64; ++bit_number) {
+        unsigned bit = (rom[bit_number / 8] >> (bit_number % 8)) & 0x01;
+        mock().expectOneCall("OneWire->read_bit()").andReturnValue(bit);
+        mock().expectOneCall("OneWire->read_bit()").andReturnValue(bit ^ 1);
+        mock().expectOneCall("OneWire->write_bit(uint8_t)").withUnsignedIntParameter("v", bit);
+    }
+}
+
+// The search of a family stops at the first bit of the family code the device does not have
+static void expect_search_of_other_family(const Device_address rom, uint8_t family_id) {
+    expect_presence(true);
+    expect_write(SEARCH_ROM, sizeof(SEARCH_ROM));
+    for (uint8_t bit_number = 0; bit_number < 8; ++bit_number) {
+        unsigned bit = (rom[0] >> bit_number) & 0x01;
+        mock().expectOneCall("OneWire->read_bit()").andReturnValue(bit);
+        mock().expectOneCall("OneWire->read_bit()").andReturnValue(bit ^ 1);
+        mock().expectOneCall("OneWire->write_bit(uint8_t)").withUnsignedIntParameter("v", bit);
+        if (bit != ((family_id >> bit_number) & 0x01u))
+            return;
+    }
+}
+
+// Every DS18x20 family is searched alone, after a presence check
+static void expect_scan_of(const Device_address rom) {
+    expect_presence(true);
+    for (uint8_t family_id : DS18X20_FAMILY_IDS) {
+        if (family_id == rom[0])
+            expect_search_of(rom);
+        else
+            expect_search_of_other_family(rom, family_id);
+    }
+}
+
+static void expect_power_supply_read(bool is_parasite_powered) {
+    expect_presence(true);
+    expect_write(SKIP_ROM, sizeof(SKIP_ROM));
+    expect_write(READ_POWER_SUPPLY, sizeof(READ_POWER_SUPPLY));
+    mock().expectOneCall("OneWire->read_bit()")
+          .andReturnValue(is_parasite_powered ? 0u : 1u);
+}
+
+// After a device pulled the read of the whole bus low, every device is read alone
+static void expect_power_supply_read_of(size_t device_index, bool is_parasite_powered) {
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    expect_write(READ_POWER_SUPPLY, sizeof(READ_POWER_SUPPLY));
+    mock().expectOneCall("OneWire->read_bit()")
+          .andReturnValue(is_parasite_powered ? 0u : 1u);
+}
+
 TEST_GROUP(One_wire_temperature_sensor_arduino_init)
 {
+    void setup()
+    {
+        make_select_commands();
+    }
     void teardown()
     {
         mock().checkExpectations();
@@ -13,22 +160,73 @@ TEST_GROUP(One_wire_temperature_sensor_arduino_init)
     }
 };
 
-#define TEMPERATURE_SENSOR_PIN 4
+TEST(One_wire_temperature_sensor_arduino_init, WHEN_class_is_instanced_THEN_bus_is_searched_and_power_supply_and_resolution_are_read)
+{
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x3F, scratchpad);
+    mock().expectOneCall("OneWire->constructor(uint8_t)")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+    expect_scan_of(ROMS[0]);
+    expect_power_supply_read(true);
+    expect_power_supply_read_of(0, true);
+    expect_scratchpad_read(0, scratchpad);
+
+    One_wire_temp_sensor temp_sensor(TEMPERATURE_SENSOR_PIN);
+
+    CHECK_TRUE(temp_sensor.is_parasite_powered());
+    UNSIGNED_LONGS_EQUAL(10, temp_sensor.get_resolution());
+    Device_address address;
+    temp_sensor.get_device_address_on_index(address, 0);
+    MEMCMP_EQUAL(ROMS[0], address, sizeof(Device_address));
+}
+
+class Memory_snapshot_store : public Bus_snapshot_store {
+public:
+    Bus_snapshot snapshot = {12, true, 1, {{0x28, 1, 2, 3, 4, 5, 6, 7}}};
+    unsigned saves = 0;
 
-TEST(One_wire_temperature_sensor_arduino_init, WHEN_class_is_instanced_THEN_initialize_Dallas_library_and_begin_it)
+    bool load(Bus_snapshot* snapshot_to_load) override {
+        *snapshot_to_load = snapshot;
+        return true;
+    }
+    bool save(const Bus_snapshot& snapshot_to_save) override {
+        ++saves;
+        return true;
+    }
+};
+
+TEST(One_wire_temperature_sensor_arduino_init, GIVEN_stored_snapshot_and_devices_present_WHEN_class_is_instanced_THEN_bus_is_not_searched)
 {
+    Memory_snapshot_store store;
     mock().expectOneCall("OneWire->constructor(uint8_t)")
           .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+    expect_presence(true);
 
-    mock().expectOneCall("DallasTemperature->constructor(OneWire*)")
-          .ignoreOtherParameters();
+    One_wire_temp_sensor temp_sensor(TEMPERATURE_SENSOR_PIN, &store);
 
-    mock().expectOneCall("DallasTemperature->begin");
+    CHECK_TRUE(temp_sensor.is_search_deferred());
+    CHECK_TRUE(temp_sensor.is_parasite_powered());
+    UNSIGNED_LONGS_EQUAL(12, temp_sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(0, store.saves);
+}
 
-    mock().expectOneCall("DallasTemperature->setWaitForConversion")
-          .withBoolParameter("flag", false);
+static constexpr Device_address KNOWN_ROMS[] = {
+    {0x28, 0xFF, 0x4C, 0x6B, 0x71, 0x16, 0x05, 0xB9},
+    {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2},
+};
+static constexpr Known_bus KNOWN_BUS(KNOWN_ROMS, 11, false);
 
-    One_wire_temp_sensor temp_sensor(TEMPERATURE_SENSOR_PIN);
+TEST(One_wire_temperature_sensor_arduino_init, GIVEN_known_bus_and_devices_present_WHEN_class_is_instanced_THEN_bus_is_never_searched)
+{
+    mock().expectOneCall("OneWire->constructor(uint8_t)")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+    expect_presence(true);
+
+    One_wire_temp_sensor temp_sensor(TEMPERATURE_SENSOR_PIN, KNOWN_BUS);
+
+    UNSIGNED_LONGS_EQUAL(2, temp_sensor.get_device_count());
+    UNSIGNED_LONGS_EQUAL(11, temp_sensor.get_resolution());
+    CHECK_FALSE(temp_sensor.is_search_deferred());
 }
 
 One_wire_temp_sensor* temp_sensor = nullptr;
@@ -37,9 +235,14 @@ TEST_GROUP(One_wire_temperature_sensor_arduino)
 {
     void setup()
     {
-        mock().disable();
-        temp_sensor = new One_wire_temp_sensor(TEMPERATURE_SENSOR_PIN);
-        mock().enable();
+        make_select_commands();
+        static constexpr Known_bus EXTERNALLY_POWERED_BUS(ROMS, 12, false);
+        mock().expectOneCall("OneWire->constructor(uint8_t)")
+              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+        expect_presence(true);
+        temp_sensor = new One_wire_temp_sensor(TEMPERATURE_SENSOR_PIN, EXTERNALLY_POWERED_BUS);
+        mock().checkExpectations();
+        mock().clear();
     }
     void teardown()
     {
@@ -49,69 +252,303 @@ TEST_GROUP(One_wire_temperature_sensor_arduino)
     }
 };
 
-TEST(One_wire_temperature_sensor_arduino, get_device_count)
+TEST(One_wire_temperature_sensor_arduino, get_device_address_on_index)
 {
-    const int DEVICE_COUNT = 2;
-    mock().expectOneCall("DallasTemperature->getDeviceCount")
-          .andReturnValue(DEVICE_COUNT);
-    
-    CHECK_EQUAL(DEVICE_COUNT, temp_sensor->get_device_count());
-}
+    const uint8_t INDEX_TO_ASK_FOR_ADDRESS = 1;
 
-TEST(One_wire_temperature_sensor_arduino,  get_device_address_on_index)
-{
-    DeviceAddress device_address = {1, 2, 3, 4, 5, 6, 7, 8};
-    const uint8_t INDEX_TO_ASK_FOR_ADDRESS = 0;
-    mock().expectOneCall("DallasTemperature->getAddress")
-          .withOutputParameterReturning("deviceAddress", (const void*)device_address, sizeof(device_address))
-          .withUnsignedIntParameter("index", INDEX_TO_ASK_FOR_ADDRESS)
-          .andReturnValue(true);
-    
     Device_address address;
-    memcpy(address, device_address, sizeof(device_address));
     temp_sensor->get_device_address_on_index(address, INDEX_TO_ASK_FOR_ADDRESS);
+
+    MEMCMP_EQUAL(ROMS[INDEX_TO_ASK_FOR_ADDRESS], address, sizeof(Device_address));
 }
 
 #define bits
-const uint8_t RESOLUTION = 14 bits;
 
-TEST(One_wire_temperature_sensor_arduino, get_resolution)
+TEST(One_wire_temperature_sensor_arduino, set_resolution)
 {
-    mock().expectOneCall("DallasTemperature->getResolution")
-          .andReturnValue(RESOLUTION);
-    
+    const uint8_t RESOLUTION = 11 bits;
+    // The alarm thresholds set by the user are written back unchanged
+    static uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    scratchpad[DS18X20_SCRATCHPAD_TH] = 0x4B;
+    scratchpad[DS18X20_SCRATCHPAD_TL] = 0x46;
+    scratchpad[DS18X20_SCRATCHPAD_CRC] = OneWire::crc8(scratchpad, DS18X20_SCRATCHPAD_CRC);
+    const uint8_t TH_TL_CONFIG[4] = {DS18X20_WRITE_SCRATCHPAD, 0x4B, 0x46, 0x1F | (RESOLUTION - 9) << 5};
+    for (size_t i = 0; i < DEVICE_COUNT; ++i)
+        expect_resolution_write(i, scratchpad, TH_TL_CONFIG);
+
+    CHECK_TRUE(temp_sensor->set_resolution(RESOLUTION));
+
     CHECK_EQUAL(RESOLUTION, temp_sensor->get_resolution());
 }
 
-TEST(One_wire_temperature_sensor_arduino, set_resolution)
+TEST(One_wire_temperature_sensor_arduino, request_temperatures)
 {
-    mock().expectOneCall("DallasTemperature->setResolution")
-          .withUnsignedIntParameter("newResolution", RESOLUTION);
-    
-    temp_sensor->set_resolution(RESOLUTION);
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("micros");
+    mock().expectNoCall("OneWire->write(uint8_t, uint8_t)");
+
+    temp_sensor->request_temperatures();
 }
 
-TEST(One_wire_temperature_sensor_arduino, request_temperatures)
+TEST(One_wire_temperature_sensor_arduino, request_temperature_BLOCKING)
 {
-    mock().expectOneCall("DallasTemperature->requestTemperatures");
+    set_resolution_of_every_device(temp_sensor, 9);
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("delay")
+          .withUnsignedLongIntParameter("ms", 94);
+
+    temp_sensor->request_temperature_BLOCKING();
+    CHECK_TRUE(temp_sensor->is_sample_available());
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_externally_powered_bus_WHEN_conversion_ends_before_time_THEN_sample_is_available)
+{
+    mock().disable();
     temp_sensor->request_temperatures();
+    mock().enable();
+
+    mock().expectOneCall("micros")
+          .andReturnValue((unsigned long)100000);
+    mock().expectOneCall("OneWire->read_bit()")
+          .andReturnValue(1u);
+
+    CHECK_TRUE(temp_sensor->is_sample_available());
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_parasite_powered_bus_WHEN_conversion_time_is_over_THEN_strong_pullup_is_released_and_sample_is_available)
+{
+    static constexpr Known_bus PARASITE_BUS(ROMS, 9, true);
+    mock().expectOneCall("OneWire->constructor(uint8_t)")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+    expect_presence(true);
+    One_wire_temp_sensor parasite_sensor(TEMPERATURE_SENSOR_PIN, PARASITE_BUS);
+    expect_presence(true);
+    expect_write(SKIP_ROM, sizeof(SKIP_ROM));
+    mock().expectOneCall("OneWire->write(uint8_t, uint8_t)")
+          .withUnsignedIntParameter("v", DS18X20_CONVERT_T)
+          .withUnsignedIntParameter("power", 1);
+    mock().expectOneCall("micros")
+          .andReturnValue((unsigned long)0);
+    parasite_sensor.request_temperatures();
+    CHECK_TRUE(parasite_sensor.is_parasite_powered());
+    mock().checkExpectations();
+    mock().clear();
+
+    mock().expectOneCall("micros")
+          .andReturnValue((unsigned long)94000);
+    mock().expectOneCall("OneWire->depower()");
+
+    CHECK_TRUE(parasite_sensor.is_sample_available());
 }
 
 TEST(One_wire_temperature_sensor_arduino, get_temperature_in_celsius)
 {
-    DeviceAddress device_address = {1, 2, 3, 4, 5, 6, 7, 8};
-    float TEMPERATURE_IN_CELSIUS = 24.7;
-    mock().expectOneCall("DallasTemperature->getTempC")
-          .withMemoryBufferParameter("deviceAddress", device_address, sizeof(device_address))
-          .andReturnValue(TEMPERATURE_IN_CELSIUS);
-    
-    Device_address address;
-    memcpy(address, device_address, sizeof(device_address));
-    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(address), 0.000001f);
+    float TEMPERATURE_IN_CELSIUS = -10.125;
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(TEMPERATURE_IN_CELSIUS, 0x7F, scratchpad);
+    expect_scratchpad_read(0, scratchpad);
+
+    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(ROMS[0]), 0.000001f);
 }
 
 TEST(One_wire_temperature_sensor_arduino, get_millis_to_wait_for_conversion)
 {
-    mock().expectOneCall("DallasTemperature->millisToWaitForConversion");
-    temp_sensor->get_millis_to_wait_for_conversion(RESOLUTION);
-}
\ No newline at end of file
+    UNSIGNED_LONGS_EQUAL(94, temp_sensor->get_millis_to_wait_for_conversion(9));
+}
+
+class Reading_listener_spy : public Reading_listener {
+public:
+    uint8_t readings_received = 0;
+    float last_temperature = 0;
+    void on_reading(const Device_address address, float temperature_in_celsius) override {
+        ++readings_received;
+        last_temperature = temperature_in_celsius;
+    }
+};
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_reading_listener_is_set_WHEN_get_temperature_in_celsius_THEN_listener_receives_the_reading)
+{
+    Reading_listener_spy listener;
+    temp_sensor->set_reading_listener(&listener);
+    float TEMPERATURE_IN_CELSIUS = 24.75;
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(TEMPERATURE_IN_CELSIUS, 0x7F, scratchpad);
+    expect_scratchpad_read(0, scratchpad);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(1, listener.readings_received);
+    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, listener.last_temperature, 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_reading_listener_is_set_WHEN_device_is_disconnected_THEN_listener_is_not_called)
+{
+    Reading_listener_spy listener;
+    temp_sensor->set_reading_listener(&listener);
+    expect_presence(false);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(0, listener.readings_received);
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_scratchpad_has_a_bad_crc_WHEN_get_temperature_in_celsius_THEN_crc_failure_is_counted)
+{
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    scratchpad[DS18X20_SCRATCHPAD_CRC] ^= 0x01;
+    expect_scratchpad_read(0, scratchpad);
+    mock().expectOneCall("OneWire->count_crc_failure()");
+
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(ROMS[0]), 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_arduino, get_bus_stats)
+{
+    One_wire_bus_stats STATS = {};
+    STATS.bytes_clocked = 18;
+    STATS.presence_failures = 2;
+    STATS.bus_busy_us = 1500;
+    mock().expectOneCall("OneWire->get_stats(One_wire_bus_stats*)")
+          .withOutputParameterReturning("stats_to_get", &STATS, sizeof(STATS));
+
+    One_wire_bus_stats stats = temp_sensor->get_bus_stats();
+
+    UNSIGNED_LONGS_EQUAL(STATS.bytes_clocked, stats.bytes_clocked);
+    UNSIGNED_LONGS_EQUAL(STATS.presence_failures, stats.presence_failures);
+    UNSIGNED_LONGS_EQUAL(STATS.bus_busy_us, stats.bus_busy_us);
+}
+
+TEST(One_wire_temperature_sensor_arduino, clear_bus_stats)
+{
+    mock().expectOneCall("OneWire->clear_stats()");
+
+    temp_sensor->clear_bus_stats();
+}
+
+TEST(One_wire_temperature_sensor_arduino, set_trace)
+{
+    uint8_t buffer[32];
+    One_wire_trace trace(buffer, sizeof(buffer));
+    mock().expectOneCall("OneWire->set_trace_hook(One_wire_trace_hook, void*)")
+          .withBoolParameter("has_hook", true)
+          .withPointerParameter("context", &trace);
+    mock().expectOneCall("OneWire->set_trace_hook(One_wire_trace_hook, void*)")
+          .withBoolParameter("has_hook", false)
+          .withPointerParameter("context", (void*)nullptr);
+
+    temp_sensor->set_trace(&trace);
+    temp_sensor->set_trace(nullptr);
+}
+
+class Read_latency_listener_spy : public Read_latency_listener {
+public:
+    uint8_t latencies_received = 0;
+    uint32_t last_request_to_data_us = 0;
+    uint32_t last_scratchpad_read_us = 0;
+    void on_read_latency(const Device_address address, uint32_t request_to_data_us, uint32_t scratchpad_read_us) override {
+        ++latencies_received;
+        last_request_to_data_us = request_to_data_us;
+        last_scratchpad_read_us = scratchpad_read_us;
+    }
+};
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_temperatures_were_requested_WHEN_get_temperature_in_celsius_THEN_read_latencies_are_reported)
+{
+    Read_latency_listener_spy listener;
+    temp_sensor->set_read_latency_listener(&listener);
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("micros").andReturnValue((unsigned long)1000);
+    temp_sensor->request_temperatures();
+
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    mock().expectOneCall("micros").andReturnValue((unsigned long)751000);
+    expect_scratchpad_read(0, scratchpad);
+    mock().expectOneCall("micros").andReturnValue((unsigned long)757000);
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(1, listener.latencies_received);
+    UNSIGNED_LONGS_EQUAL(756000, listener.last_request_to_data_us);
+    UNSIGNED_LONGS_EQUAL(6000, listener.last_scratchpad_read_us);
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_read_latency_listener_is_set_WHEN_device_is_disconnected_THEN_listener_is_not_called)
+{
+    Read_latency_listener_spy listener;
+    temp_sensor->set_read_latency_listener(&listener);
+    mock().expectOneCall("micros");
+    expect_presence(false);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(0, listener.latencies_received);
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_retry_policy_WHEN_reads_fail_THEN_device_is_read_again_with_bounded_backoff_and_slow_timing_on_last_attempt)
+{
+    Read_retry_policy policy = {3, 10, 15, true};
+    temp_sensor->set_read_retry_policy(policy);
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    expect_presence(false);
+    mock().expectOneCall("delay").withUnsignedLongIntParameter("ms", 10);
+    expect_presence(false);
+    mock().expectOneCall("delay").withUnsignedLongIntParameter("ms", 15);
+    mock().expectOneCall("OneWire->get_timing()");
+    mock().expectOneCall("OneWire->set_timing(const One_wire_slot_timing&)")
+          .withUnsignedIntParameter("recovery_us", OneWire::SLOW_TIMING.recovery_us);
+    expect_scratchpad_read(1, scratchpad);
+    mock().expectOneCall("OneWire->set_timing(const One_wire_slot_timing&)")
+          .withUnsignedIntParameter("recovery_us", OneWire::STANDARD_TIMING.recovery_us);
+
+    float temperature = 0;
+    CHECK_TRUE(temp_sensor->read_temperature_in_celsius(ROMS[1], &temperature));
+    DOUBLES_EQUAL(24.5, temperature, 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_retry_policy_WHEN_every_attempt_fails_THEN_read_temperature_in_celsius_returns_false)
+{
+    Read_retry_policy policy = {2, 0, 0, false};
+    temp_sensor->set_read_retry_policy(policy);
+    mock().expectNCalls(2, "OneWire->reset()")
+          .andReturnValue(0);
+
+    float temperature;
+    CHECK_FALSE(temp_sensor->read_temperature_in_celsius(ROMS[0], &temperature));
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+WHEN_devices_of_a_family_are_scanned_THEN_only_its_devices_are_found)
+{
+    const uint8_t DS2438_FAMILY_ID = 0x26;
+    Device_address ds2438_rom = {DS2438_FAMILY_ID, 1, 2, 3, 4, 5, 6, 0};
+    ds2438_rom[7] = OneWire::crc8(ds2438_rom, 7);
+    expect_search_of(ds2438_rom);
+
+    Device_address addresses[4];
+    UNSIGNED_LONGS_EQUAL(1, temp_sensor->scan_devices_of_family(DS2438_FAMILY_ID, addresses, 4));
+    MEMCMP_EQUAL(ds2438_rom, addresses[0], sizeof(Device_address));
+}
+
+TEST(One_wire_temperature_sensor_arduino,
+GIVEN_the_rom_read_has_a_bad_crc_WHEN_devices_of_a_family_are_scanned_THEN_it_is_skipped)
+{
+    const uint8_t DS2438_FAMILY_ID = 0x26;
+    Device_address corrupted_rom = {DS2438_FAMILY_ID, 9, 9, 9, 9, 9, 9, 0};
+    corrupted_rom[7] = OneWire::crc8(corrupted_rom, 7) ^ 0x01;
+    expect_search_of(corrupted_rom);
+
+    Device_address addresses[4];
+    UNSIGNED_LONGS_EQUAL(0, temp_sensor->scan_devices_of_family(DS2438_FAMILY_ID, addresses, 4));
+}
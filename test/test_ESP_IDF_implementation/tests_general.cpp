@@ -1,13 +1,183 @@
 #include "CppUTest/TestHarness.h"
 #include "CppUTestExt/MockSupport.h"
 #include "../../One_wire_temp_sensor.h"
-#include "../mocks/ESP_IDF_driver/ds18x20.h"
+#include "../mocks/ESP_IDF_driver/onewire.h"
 #include <string.h>
 
 #define TEMPERATURE_SENSOR_PIN 4
 const int MAX_DEVICES = 10;
 const size_t DEVICE_COUNT = 2;
-const ds18x20_addr_t addr_list[DEVICE_COUNT] = {560, 230};
+const bool IS_EXTERNALLY_POWERED = false;
+
+static constexpr Device_address ROMS[DEVICE_COUNT] = {
+    {0x28, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3},
+    {0x28, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC4},
+};
+static uint8_t select_commands[DEVICE_COUNT][1 + sizeof(Device_address)];
+static const uint8_t SEARCH_ROM[1] = {ONE_WIRE_SEARCH_ROM};
+static const uint8_t SKIP_ROM[1] = {ONE_WIRE_SKIP_ROM};
+static const uint8_t CONVERT_T[1] = {DS18X20_CONVERT_T};
+static const uint8_t READ_SCRATCHPAD[1] = {DS18X20_READ_SCRATCHPAD};
+static const uint8_t READ_POWER_SUPPLY[1] = {DS18X20_READ_POWER_SUPPLY};
+static const bool BITS[2] = {false, true};
+
+static void make_select_commands() {
+    for (size_t i = 0; i < DEVICE_COUNT; ++i) {
+        select_commands[i][0] = ONE_WIRE_MATCH_ROM;
+        memcpy(&select_commands[i][1], ROMS[i], sizeof(Device_address));
+    }
+}
+
+#define MAX_NUMBERS_PER_BYTE 256
+#define BITS_PER_BYTE 8
+inline uint16_t get_representation_with_12_bits_and_3_fixed_decimals(float temp_to_convert) {
+    return temp_to_convert*16;
+}
+
+static void make_scratchpad(float temperature_in_celsius, uint8_t config, uint8_t* scratchpad) {
+    uint16_t raw = get_representation_with_12_bits_and_3_fixed_decimals(temperature_in_celsius);
+    memset(scratchpad, 0, DS18X20_SCRATCHPAD_SIZE);
+    scratchpad[0] = raw % MAX_NUMBERS_PER_BYTE;
+    scratchpad[1] = raw >> BITS_PER_BYTE;
+    scratchpad[DS18X20_SCRATCHPAD_CONFIG] = config;
+    scratchpad[DS18X20_SCRATCHPAD_CRC] = onewire_crc8(scratchpad, DS18X20_SCRATCHPAD_CRC);
+}
+
+static void expect_presence(bool is_device_present) {
+    mock().expectOneCall("onewire_reset")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(is_device_present);
+}
+
+static void expect_write(const uint8_t* bytes, size_t count) {
+    mock().expectOneCall("onewire_write_bytes")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .withMemoryBufferParameter("buf", bytes, count);
+}
+
+// The output buffers are read when the call happens, so they must outlive the expectations
+static void expect_scratchpad_read(size_t device_index, const uint8_t* scratchpad) {
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    expect_write(READ_SCRATCHPAD, sizeof(READ_SCRATCHPAD));
+    mock().expectOneCall("onewire_read_bytes")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .withOutputParameterReturning("buf", scratchpad, DS18X20_SCRATCHPAD_SIZE)
+          .withUnsignedLongIntParameter("count", DS18X20_SCRATCHPAD_SIZE);
+}
+
+// Keeps the TH and TL of the scratchpad read, the EEPROM write holds the bus high for 10 ms,
+// 1 tick rounded up plus the partial first one
+static void expect_resolution_write(size_t device_index, const uint8_t* scratchpad, const uint8_t* th_tl_config) {
+    expect_scratchpad_read(device_index, scratchpad);
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    expect_write(th_tl_config, 1 + 3);
+
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    mock().expectOneCall("onewire_write_power")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .withUnsignedIntParameter("v", DS18X20_COPY_SCRATCHPAD);
+    mock().expectOneCall("vTaskDelay")
+          .withUnsignedIntParameter("xTicksToDelay", 2);
+    mock().expectOneCall("onewire_depower")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+}
+
+// Every device answers with the TH and TL of its power up
+static void set_resolution_of_every_device(One_wire_temp_sensor* sensor, uint8_t resolution) {
+    static uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    static uint8_t th_tl_config[1 + 3];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    th_tl_config[0] = DS18X20_WRITE_SCRATCHPAD;
+    th_tl_config[1] = 0x00;
+    th_tl_config[2] = 0x00;
+    th_tl_config[3] = 0x1F | (resolution - 9) << 5;
+    for (size_t i = 0; i < DEVICE_COUNT; ++i)
+        expect_resolution_write(i, scratchpad, th_tl_config);
+    CHECK_TRUE(sensor->set_resolution(resolution));
+}
+
+static void expect_conversion_start_on_every_device() {
+    expect_presence(true);
+    expect_write(SKIP_ROM, sizeof(SKIP_ROM));
+    expect_write(CONVERT_T, sizeof(CONVERT_T));
+}
+
+// With a single device on the bus there is no discrepancy, the search takes the bit read
+static void expect_search_of(const Device_address rom) {
+    expect_presence(true);
+    expect_write(SEARCH_ROM, sizeof(SEARCH_ROM));
+    for (uint8_t bit_number = 0; bit_number < 64; ++bit_number) {
+        bool bit = (rom[bit_number / 8] >> (bit_number % 8)) & 0x01;
+        mock().expectOneCall("onewire_triplet")
+              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+              .withOutputParameterReturning("id_bit", &BITS[bit], sizeof(bool))
+              .withOutputParameterReturning("cmp_id_bit", &BITS[!bit], sizeof(bool))
+              .withOutputParameterReturning("direction", &BITS[bit], sizeof(bool));
+    }
+}
+
+// The search of a family stops at the first bit of the family code the device does not have
+static void expect_search_of_other_family(const Device_address rom, uint8_t family_id) {
+    expect_presence(true);
+    expect_write(SEARCH_ROM, sizeof(SEARCH_ROM));
+    for (uint8_t bit_number = 0; bit_number < 8; ++bit_number) {
+        bool bit = (rom[0] >> bit_number) & 0x01;
+        mock().expectOneCall("onewire_triplet")
+              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+              .withOutputParameterReturning("id_bit", &BITS[bit], sizeof(bool))
+              .withOutputParameterReturning("cmp_id_bit", &BITS[!bit], sizeof(bool))
+              .withOutputParameterReturning("direction", &BITS[bit], sizeof(bool));
+        if (bit != (((family_id >> bit_number) & 0x01) != 0))
+            return;
+    }
+}
+
+// Every DS18x20 family is searched alone, after a presence check
+static void expect_scan_of(const Device_address rom) {
+    expect_presence(true);
+    for (uint8_t family_id : DS18X20_FAMILY_IDS) {
+        if (family_id == rom[0])
+            expect_search_of(rom);
+        else
+            expect_search_of_other_family(rom, family_id);
+    }
+}
+
+static void expect_power_supply_read(const bool* is_parasite_powered) {
+    expect_presence(true);
+    expect_write(SKIP_ROM, sizeof(SKIP_ROM));
+    expect_write(READ_POWER_SUPPLY, sizeof(READ_POWER_SUPPLY));
+    mock().expectOneCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(*is_parasite_powered ? 0 : 1);
+}
+
+// After a device pulled the read of the whole bus low, every device is read alone
+static void expect_power_supply_read_of(size_t device_index, const bool* is_parasite_powered) {
+    expect_presence(true);
+    expect_write(select_commands[device_index], sizeof(select_commands[device_index]));
+    expect_write(READ_POWER_SUPPLY, sizeof(READ_POWER_SUPPLY));
+    mock().expectOneCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(*is_parasite_powered ? 0 : 1);
+}
+
+static uint8_t scratchpad_at_12_bits[DS18X20_SCRATCHPAD_SIZE];
+
+// Search of the first device, then its power supply and its resolution are read
+static void expect_search_of_first_device() {
+    make_scratchpad(24.5, 0x7F, scratchpad_at_12_bits);
+    expect_scan_of(ROMS[0]);
+    expect_power_supply_read(&IS_EXTERNALLY_POWERED);
+    expect_scratchpad_read(0, scratchpad_at_12_bits);
+}
+
+static void expect_no_device_on_search() {
+    expect_presence(false);
+}
 
 One_wire_temp_sensor* temp_sensor = nullptr;
 
@@ -15,14 +185,13 @@ TEST_GROUP(One_wire_temperature_sensor_esp_idf)
 {
     void setup ()
     {
-        mock().expectOneCall("ds18x20_scan_devices")
-            .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
-            .withOutputParameterReturning("addr_list", (const void*)addr_list, sizeof(addr_list))
-            .withUnsignedLongIntParameter("addr_count", MAX_DEVICES)
-            .withOutputParameterReturning("found", (const void*)&DEVICE_COUNT, sizeof(DEVICE_COUNT))
-            .andReturnValue(ESP_OK);
+        make_select_commands();
+        static constexpr Known_bus EXTERNALLY_POWERED_BUS(ROMS, 12, IS_EXTERNALLY_POWERED);
+        expect_presence(true);
 
-        temp_sensor = new One_wire_temp_sensor(TEMPERATURE_SENSOR_PIN);
+        temp_sensor = new One_wire_temp_sensor(TEMPERATURE_SENSOR_PIN, EXTERNALLY_POWERED_BUS);
+        mock().checkExpectations();
+        mock().clear();
     }
     void teardown()
     {
@@ -32,13 +201,8 @@ TEST_GROUP(One_wire_temperature_sensor_esp_idf)
     }
 };
 
-TEST(One_wire_temperature_sensor_esp_idf, get_device_count)
+TEST(One_wire_temperature_sensor_esp_idf, GIVEN_known_bus_WHEN_get_device_count_THEN_bus_is_not_searched)
 {
-    const size_t DEVICE_COUNT = 2;
-
-    mock().expectOneCall("ds18x20_scan_devices")
-          .withOutputParameterReturning("found", &DEVICE_COUNT, sizeof(DEVICE_COUNT))
-          .ignoreOtherParameters();
     CHECK_EQUAL(DEVICE_COUNT, temp_sensor->get_device_count());
 }
 
@@ -47,14 +211,10 @@ TEST(One_wire_temperature_sensor_esp_idf, get_device_count)
 TEST(One_wire_temperature_sensor_esp_idf,  get_device_address_on_index)
 {
     uint8_t address[BYTES_PER_ADDRESS];
-    const uint8_t INDEX_TO_ASK_FOR_ADDRESS = 0;
+    const uint8_t INDEX_TO_ASK_FOR_ADDRESS = 1;
     temp_sensor->get_device_address_on_index(address, INDEX_TO_ASK_FOR_ADDRESS);
 
-    uint64_t raw_address = addr_list[INDEX_TO_ASK_FOR_ADDRESS];
-    for (int i = 0; i < BYTES_PER_ADDRESS; ++i) {
-        CHECK_EQUAL(raw_address & 0xFF, address[i]);
-        raw_address >>= BYTES_PER_ADDRESS;
-    }
+    MEMCMP_EQUAL(ROMS[INDEX_TO_ASK_FOR_ADDRESS], address, BYTES_PER_ADDRESS);
 }
 
 TEST(One_wire_temperature_sensor_esp_idf, get_device_address_on_index_WHEN_index_is_invalid_THEN_address_does_not_change) {
@@ -68,7 +228,7 @@ TEST(One_wire_temperature_sensor_esp_idf, get_device_address_on_index_WHEN_index
 
 #define bits
 
-TEST(One_wire_temperature_sensor_esp_idf, GIVEN_resolution_was_not_set_WHEN_get_resolution_THEN_resolution_is_9_bits)
+TEST(One_wire_temperature_sensor_esp_idf, GIVEN_resolution_was_not_set_WHEN_get_resolution_THEN_resolution_is_12_bits)
 {
     const uint8_t DEFAULT_RESOLUTION = 12 bits;
 
@@ -79,92 +239,84 @@ TEST(One_wire_temperature_sensor_esp_idf, set_resolution)
 {
     const uint8_t RESOLUTION_TO_SET = 12 bits;
 
-    uint8_t TH = 0x00;
-    uint8_t TL = 0xFF;
-    uint8_t config = 0 + ((RESOLUTION_TO_SET - 9) << 5 bits);
-    uint8_t bytes_to_write[3] = { TH, TL, config };
+    // The alarm thresholds set by the user are written back unchanged
+    uint8_t TH = 0x4B;
+    uint8_t TL = 0x46;
+    static uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x1F, scratchpad);
+    scratchpad[DS18X20_SCRATCHPAD_TH] = TH;
+    scratchpad[DS18X20_SCRATCHPAD_TL] = TL;
+    scratchpad[DS18X20_SCRATCHPAD_CRC] = onewire_crc8(scratchpad, DS18X20_SCRATCHPAD_CRC);
+    uint8_t config = 0x1F + ((RESOLUTION_TO_SET - 9) << 5 bits);
+    uint8_t bytes_to_write[4] = { DS18X20_WRITE_SCRATCHPAD, TH, TL, config };
+
+    for (size_t i = 0; i < DEVICE_COUNT; ++i )
+        expect_resolution_write(i, scratchpad, bytes_to_write);
+
+    CHECK_TRUE(temp_sensor->set_resolution(RESOLUTION_TO_SET));
+}
 
-    for (size_t i = 0; i < DEVICE_COUNT; ++i ) {
-        mock().expectOneCall("ds18x20_write_scratchpad")
-              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
-              .withUnsignedLongLongIntParameter("addr", addr_list[i])
-              .withMemoryBufferParameter("buffer", bytes_to_write, sizeof(bytes_to_write))
-              .andReturnValue(ESP_OK);
+TEST(One_wire_temperature_sensor_esp_idf, WHEN_a_scratchpad_write_fails_THEN_the_resolution_is_kept)
+{
+    const uint8_t RESOLUTION_BEFORE = temp_sensor->get_resolution();
+    static uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    static const uint8_t TH_TL_CONFIG[4] = { DS18X20_WRITE_SCRATCHPAD, 0x00, 0x00, 0x1F };
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    expect_scratchpad_read(0, scratchpad);
+    expect_presence(false);
+    expect_resolution_write(1, scratchpad, TH_TL_CONFIG);
 
-        mock().expectOneCall("ds18x20_copy_scratchpad")
-              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
-              .withUnsignedLongLongIntParameter("addr", addr_list[i])
-              .andReturnValue(ESP_OK);
-    }
-    
-    temp_sensor->set_resolution(RESOLUTION_TO_SET);
+    CHECK_FALSE(temp_sensor->set_resolution(9 bits));
+
+    CHECK_EQUAL(RESOLUTION_BEFORE, temp_sensor->get_resolution());
 }
 
 TEST(One_wire_temperature_sensor_esp_idf, WHEN_invalid_resolution_is_set_THEN_set_resolution_has_no_effect)
 {
     uint8_t invalid_resolution = 8 bits;
-    mock().expectNoCall("ds18x20_write_scratchpad");
-    mock().expectNoCall("ds18x20_copy_scratchpad");
+    mock().expectNoCall("onewire_write_bytes");
+    mock().expectNoCall("onewire_write_power");
     temp_sensor->set_resolution(invalid_resolution);
 
     invalid_resolution = 13 bits;
-    mock().expectNoCall("ds18x20_write_scratchpad");
-    mock().expectNoCall("ds18x20_copy_scratchpad");
     temp_sensor->set_resolution(invalid_resolution);
 }
 
-TEST(One_wire_temperature_sensor_esp_idf, GIVEN_resolution_is_set_to_12_bits_WHEN_get_resolution_THEN_it_is_12_bits)
+TEST(One_wire_temperature_sensor_esp_idf, GIVEN_resolution_is_set_to_10_bits_WHEN_get_resolution_THEN_it_is_10_bits)
 {
-    const uint8_t RESOLUTION_TO_GET = 12 bits;
-    mock().disable();
-    temp_sensor->set_resolution(RESOLUTION_TO_GET);
-    mock().enable();
+    const uint8_t RESOLUTION_TO_GET = 10 bits;
+    set_resolution_of_every_device(temp_sensor, RESOLUTION_TO_GET);
 
     CHECK_EQUAL(RESOLUTION_TO_GET, temp_sensor->get_resolution());
 }
 
-TEST(One_wire_temperature_sensor_esp_idf, request_temperatures)
+TEST(One_wire_temperature_sensor_esp_idf, GIVEN_externally_powered_bus_WHEN_request_temperatures_THEN_bus_is_not_held_high)
 {
-    mock().expectOneCall("ds18x20_measure")
-          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
-          .withUnsignedLongLongIntParameter("addr", DS18X20_ANY)
-          .withBoolParameter("wait", false)
-          .andReturnValue(ESP_OK);
-    mock().ignoreOtherCalls();
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("esp_timer_get_time");
+    mock().expectNoCall("onewire_write_power");
+    mock().expectNoCall("onewire_power");
 
     temp_sensor->request_temperatures();
 }
 
-#define MAX_NUMBERS_PER_BYTE 256
-#define BITS_PER_BYTE 8
-inline uint16_t get_representation_with_12_bits_and_3_fixed_decimals(float temp_to_convert) {
-    return temp_to_convert*16;
-}
-
 TEST(One_wire_temperature_sensor_esp_idf, get_temperature_in_celsius)
 {
-    Device_address device_address = {0, 0, 0, 0, 0, 0, 0, 0};
-    device_address[0] = addr_list[0] % MAX_NUMBERS_PER_BYTE;
-    device_address[1] = (addr_list[0] >> BITS_PER_BYTE) % MAX_NUMBERS_PER_BYTE;
-    
     float TEMPERATURE_IN_CELSIUS = 24.5;
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(TEMPERATURE_IN_CELSIUS, 0x7F, scratchpad);
+    expect_scratchpad_read(0, scratchpad);
 
-    mock().expectOneCall("ds18b20_read_temperature")
-          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
-          .withUnsignedLongLongIntParameter("addr", addr_list[0])
-          .withOutputParameterReturning("temperature", &TEMPERATURE_IN_CELSIUS, sizeof(TEMPERATURE_IN_CELSIUS))
-          .andReturnValue(ESP_OK);
-
-    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(device_address), 0.000001f);
+    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(ROMS[0]), 0.000001f);
 }
 
 TEST(One_wire_temperature_sensor_esp_idf, request_temperature_BLOCKING)
 {
-    mock().expectOneCall("ds18x20_measure")
-          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
-          .withUnsignedLongLongIntParameter("addr", DS18X20_ANY)
-          .withBoolParameter("wait", true);
-    
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("vTaskDelay")
+          .withUnsignedIntParameter("xTicksToDelay", 76);
+
+    UNSIGNED_LONGS_EQUAL(750, temp_sensor->get_millis_to_wait_for_conversion(temp_sensor->get_resolution()));
     temp_sensor->request_temperature_BLOCKING();
 }
 
@@ -174,7 +326,36 @@ GIVEN_did_not_requested_temperature_THEN_is_sample_available_is_false)
     CHECK_FALSE(temp_sensor->is_sample_available());
 }
 
+TEST(One_wire_temperature_sensor_esp_idf,
+WHEN_conversion_time_is_calibrated_THEN_every_device_converts_alone_and_the_slowest_plus_margin_is_waited)
+{
+    const int64_t CONVERSION_US[DEVICE_COUNT] = {520000, 610000};
+    for (size_t i = 0; i < DEVICE_COUNT; ++i) {
+        expect_presence(true);
+        expect_write(select_commands[i], sizeof(select_commands[i]));
+        expect_write(CONVERT_T, sizeof(CONVERT_T));
+        mock().expectOneCall("esp_timer_get_time")
+              .andReturnValue((int64_t)0);
+        mock().expectOneCall("onewire_read_bit")
+              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+              .andReturnValue(1);
+        mock().expectOneCall("esp_timer_get_time")
+              .andReturnValue(CONVERSION_US[i]);
+    }
+    Conversion_time_table table(10);
+
+    CHECK_TRUE(temp_sensor->calibrate_conversion_time(&table));
+    UNSIGNED_LONGS_EQUAL(671, temp_sensor->get_millis_to_wait_for_conversion(temp_sensor->get_resolution()));
+
+    // 671 ms at 100 Hz: 68 ticks rounded up plus the partial first one
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("vTaskDelay")
+          .withUnsignedIntParameter("xTicksToDelay", 69);
+    temp_sensor->request_temperature_BLOCKING();
+}
+
 #define RES temp_sensor->get_resolution()
+const int IS_CONVERTING = 0;
 #define USECS_TO_WAIT_FOR_SAMPLE 1000*(int64_t)temp_sensor->get_millis_to_wait_for_conversion(RES)
 
 TEST(One_wire_temperature_sensor_esp_idf,
@@ -186,11 +367,17 @@ GIVEN_requested_temperature_WHEN_time_to_wait_for_sample_is_not_over_THEN_return
 
     mock().expectOneCall("esp_timer_get_time")
           .andReturnValue(USECS_TO_WAIT_FOR_SAMPLE - 2);
+    mock().expectOneCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(IS_CONVERTING);
 
     CHECK_FALSE(temp_sensor->is_sample_available());
 
     mock().expectOneCall("esp_timer_get_time")
           .andReturnValue(USECS_TO_WAIT_FOR_SAMPLE - 1);
+    mock().expectOneCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(IS_CONVERTING);
 
     CHECK_FALSE(temp_sensor->is_sample_available());
 }
@@ -213,9 +400,9 @@ TEST(One_wire_temperature_sensor_esp_idf,
 WHEN_request_temperatures_after_100usecs_THEN_time_to_wait_for_sample_is_shifted_in_100usecs)
 {
     int64_t TIME_SHIFT_IN_MICROSECS = 100;
+    expect_conversion_start_on_every_device();
     mock().expectOneCall("esp_timer_get_time")
           .andReturnValue(TIME_SHIFT_IN_MICROSECS);
-    mock().ignoreOtherCalls();
     temp_sensor->request_temperatures();
 
     mock().checkExpectations();
@@ -224,13 +411,32 @@ WHEN_request_temperatures_after_100usecs_THEN_time_to_wait_for_sample_is_shifted
     int64_t USEC_SINCE_INIT_TO_WAIT_FOR_SAMPLE = TIME_SHIFT_IN_MICROSECS + USECS_TO_WAIT_FOR_SAMPLE;
     mock().expectOneCall("esp_timer_get_time")
           .andReturnValue(USEC_SINCE_INIT_TO_WAIT_FOR_SAMPLE - 1);
-    
+    mock().expectOneCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(IS_CONVERTING);
+
     CHECK_FALSE(temp_sensor->is_sample_available());
 
     mock().expectOneCall("esp_timer_get_time")
           .andReturnValue(USEC_SINCE_INIT_TO_WAIT_FOR_SAMPLE);
-    
+
+    CHECK_TRUE(temp_sensor->is_sample_available());
     CHECK_TRUE(temp_sensor->is_sample_available());
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_externally_powered_bus_WHEN_conversion_ends_before_time_THEN_sample_is_available)
+{
+    mock().disable();
+    temp_sensor->request_temperatures();
+    mock().enable();
+
+    mock().expectOneCall("esp_timer_get_time")
+          .andReturnValue((int64_t)1000);
+    mock().expectOneCall("onewire_read_bit")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(1);
+
     CHECK_TRUE(temp_sensor->is_sample_available());
 }
 
@@ -242,4 +448,534 @@ WHEN_request_temperature_blocking_THEN_sample_is_available)
     mock().enable();
 
     CHECK_TRUE(temp_sensor->is_sample_available());
-}
\ No newline at end of file
+}
+
+class Reading_listener_spy : public Reading_listener {
+public:
+    uint8_t readings_received = 0;
+    float last_temperature = 0;
+    void on_reading(const Device_address address, float temperature_in_celsius) override {
+        ++readings_received;
+        last_temperature = temperature_in_celsius;
+    }
+};
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_reading_listener_is_set_WHEN_get_temperature_in_celsius_THEN_listener_receives_the_reading)
+{
+    Reading_listener_spy listener;
+    temp_sensor->set_reading_listener(&listener);
+    float TEMPERATURE_IN_CELSIUS = 24.5;
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(TEMPERATURE_IN_CELSIUS, 0x7F, scratchpad);
+    expect_scratchpad_read(0, scratchpad);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(1, listener.readings_received);
+    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, listener.last_temperature, 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_reading_listener_is_set_WHEN_read_fails_THEN_listener_is_not_called)
+{
+    Reading_listener_spy listener;
+    temp_sensor->set_reading_listener(&listener);
+    expect_presence(false);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(0, listener.readings_received);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_scratchpad_has_a_bad_crc_WHEN_get_temperature_in_celsius_THEN_crc_failure_is_counted)
+{
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    scratchpad[0] ^= 0x01;
+    expect_scratchpad_read(0, scratchpad);
+    mock().expectOneCall("onewire_stats_count_crc_failure");
+
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(ROMS[0]), 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf, get_bus_stats)
+{
+    One_wire_bus_stats STATS = {};
+    STATS.resets = 3;
+    STATS.crc_failures = 1;
+    STATS.critical_section_max_us = 75;
+    mock().expectOneCall("onewire_get_stats")
+          .withOutputParameterReturning("stats", &STATS, sizeof(STATS));
+
+    One_wire_bus_stats stats = temp_sensor->get_bus_stats();
+
+    UNSIGNED_LONGS_EQUAL(STATS.resets, stats.resets);
+    UNSIGNED_LONGS_EQUAL(STATS.crc_failures, stats.crc_failures);
+    UNSIGNED_LONGS_EQUAL(STATS.critical_section_max_us, stats.critical_section_max_us);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf, clear_bus_stats)
+{
+    mock().expectOneCall("onewire_clear_stats");
+
+    temp_sensor->clear_bus_stats();
+}
+
+TEST(One_wire_temperature_sensor_esp_idf, set_trace)
+{
+    uint8_t buffer[32];
+    One_wire_trace trace(buffer, sizeof(buffer));
+    mock().expectOneCall("onewire_set_trace_hook")
+          .withBoolParameter("has_hook", true)
+          .withPointerParameter("context", &trace);
+    mock().expectOneCall("onewire_set_trace_hook")
+          .withBoolParameter("has_hook", false)
+          .withPointerParameter("context", (void*)nullptr);
+
+    temp_sensor->set_trace(&trace);
+    temp_sensor->set_trace(nullptr);
+}
+
+class Read_latency_listener_spy : public Read_latency_listener {
+public:
+    uint8_t latencies_received = 0;
+    uint32_t last_request_to_data_us = 0;
+    uint32_t last_scratchpad_read_us = 0;
+    void on_read_latency(const Device_address address, uint32_t request_to_data_us, uint32_t scratchpad_read_us) override {
+        ++latencies_received;
+        last_request_to_data_us = request_to_data_us;
+        last_scratchpad_read_us = scratchpad_read_us;
+    }
+};
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_temperatures_were_requested_WHEN_get_temperature_in_celsius_THEN_read_latencies_are_reported)
+{
+    Read_latency_listener_spy listener;
+    temp_sensor->set_read_latency_listener(&listener);
+    expect_conversion_start_on_every_device();
+    mock().expectOneCall("esp_timer_get_time").andReturnValue((long long)1000);
+    temp_sensor->request_temperatures();
+
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    mock().expectOneCall("esp_timer_get_time").andReturnValue((long long)751000);
+    expect_scratchpad_read(0, scratchpad);
+    mock().expectOneCall("esp_timer_get_time").andReturnValue((long long)757000);
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(1, listener.latencies_received);
+    UNSIGNED_LONGS_EQUAL(756000, listener.last_request_to_data_us);
+    UNSIGNED_LONGS_EQUAL(6000, listener.last_scratchpad_read_us);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_temperatures_were_not_requested_WHEN_get_temperature_in_celsius_THEN_request_to_data_latency_is_unknown)
+{
+    Read_latency_listener_spy listener;
+    temp_sensor->set_read_latency_listener(&listener);
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    mock().expectNCalls(2, "esp_timer_get_time");
+    expect_scratchpad_read(0, scratchpad);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    UNSIGNED_LONGS_EQUAL(READ_LATENCY_UNKNOWN, listener.last_request_to_data_us);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_read_latency_listener_is_set_WHEN_read_fails_THEN_listener_is_not_called)
+{
+    Read_latency_listener_spy listener;
+    temp_sensor->set_read_latency_listener(&listener);
+    mock().expectOneCall("esp_timer_get_time");
+    expect_presence(false);
+
+    temp_sensor->get_temperature_in_celsius(ROMS[0]);
+
+    CHECK_EQUAL(0, listener.latencies_received);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+WHEN_read_fails_THEN_get_temperature_in_celsius_returns_temperature_not_available)
+{
+    expect_presence(false);
+
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, temp_sensor->get_temperature_in_celsius(ROMS[0]), 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_retry_policy_WHEN_reads_fail_THEN_device_is_read_again_with_bounded_backoff_and_slow_timing_on_last_attempt)
+{
+    Read_retry_policy policy = {3, 10, 15, true};
+    temp_sensor->set_read_retry_policy(policy);
+    float TEMPERATURE_IN_CELSIUS = 24.5;
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(TEMPERATURE_IN_CELSIUS, 0x7F, scratchpad);
+    uint8_t corrupted_scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    memcpy(corrupted_scratchpad, scratchpad, sizeof(scratchpad));
+    corrupted_scratchpad[0] ^= 0x01;
+    expect_scratchpad_read(1, corrupted_scratchpad);
+    mock().expectOneCall("onewire_stats_count_crc_failure");
+    mock().expectOneCall("vTaskDelay").withUnsignedIntParameter("xTicksToDelay", 2);
+    expect_presence(false);
+    mock().expectOneCall("vTaskDelay").withUnsignedIntParameter("xTicksToDelay", 3);
+    mock().expectOneCall("onewire_get_timing")
+          .withOutputParameterReturning("timing", &ONEWIRE_STANDARD_TIMING, sizeof(ONEWIRE_STANDARD_TIMING));
+    mock().expectOneCall("onewire_set_timing")
+          .withUnsignedIntParameter("write_slot_us", ONEWIRE_SLOW_TIMING.write_slot_us)
+          .withUnsignedIntParameter("recovery_us", ONEWIRE_SLOW_TIMING.recovery_us);
+    expect_scratchpad_read(1, scratchpad);
+    mock().expectOneCall("onewire_set_timing")
+          .withUnsignedIntParameter("write_slot_us", ONEWIRE_STANDARD_TIMING.write_slot_us)
+          .withUnsignedIntParameter("recovery_us", ONEWIRE_STANDARD_TIMING.recovery_us);
+
+    float temperature = 0;
+    CHECK_TRUE(temp_sensor->read_temperature_in_celsius(ROMS[1], &temperature));
+    DOUBLES_EQUAL(TEMPERATURE_IN_CELSIUS, temperature, 0.000001f);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_backoff_shorter_than_a_tick_WHEN_read_fails_THEN_next_attempt_still_waits)
+{
+    Read_retry_policy policy = {2, 1, 1, false};
+    temp_sensor->set_read_retry_policy(policy);
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+    expect_presence(false);
+    mock().expectOneCall("vTaskDelay").withUnsignedIntParameter("xTicksToDelay", 2);
+    expect_scratchpad_read(0, scratchpad);
+
+    float temperature;
+    CHECK_TRUE(temp_sensor->read_temperature_in_celsius(ROMS[0], &temperature));
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_retry_policy_WHEN_every_attempt_fails_THEN_read_temperature_in_celsius_returns_false)
+{
+    Read_retry_policy policy = {2, 0, 0, false};
+    temp_sensor->set_read_retry_policy(policy);
+    mock().expectNCalls(2, "onewire_reset")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .andReturnValue(false);
+    mock().expectNoCall("vTaskDelay");
+
+    float temperature;
+    CHECK_FALSE(temp_sensor->read_temperature_in_celsius(ROMS[0], &temperature));
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+WHEN_devices_of_a_family_are_scanned_THEN_only_its_devices_are_found)
+{
+    const uint8_t DS2408_FAMILY_ID = 0x29;
+    static const Device_address ds2408_rom = {DS2408_FAMILY_ID, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14};
+    expect_search_of(ds2408_rom);
+
+    Device_address addresses[2];
+    UNSIGNED_LONGS_EQUAL(1, temp_sensor->scan_devices_of_family(DS2408_FAMILY_ID, addresses, 2));
+
+    MEMCMP_EQUAL(ds2408_rom, addresses[0], sizeof(Device_address));
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+WHEN_no_device_of_the_family_is_on_the_bus_THEN_scan_devices_of_family_returns_0)
+{
+    expect_no_device_on_search();
+
+    Device_address addresses[2];
+    UNSIGNED_LONGS_EQUAL(0, temp_sensor->scan_devices_of_family(0x26, addresses, 2));
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+WHEN_slot_timing_is_calibrated_THEN_every_device_is_read_with_the_calibrated_timing)
+{
+    const One_wire_bus_measurement MEASUREMENT = {1, 20, 100};
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x7F, scratchpad);
+
+    mock().expectOneCall("onewire_get_timing")
+          .withOutputParameterReturning("timing", &ONEWIRE_STANDARD_TIMING, sizeof(ONEWIRE_STANDARD_TIMING));
+    mock().expectOneCall("onewire_measure")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .withOutputParameterReturning("measurement", &MEASUREMENT, sizeof(MEASUREMENT))
+          .andReturnValue(true);
+    mock().expectOneCall("onewire_set_timing")
+          .withUnsignedIntParameter("write_slot_us", 60)
+          .withUnsignedIntParameter("recovery_us", ONEWIRE_STANDARD_TIMING.recovery_us);
+    for (size_t i = 0; i < DEVICE_COUNT; ++i)
+        expect_scratchpad_read(i, scratchpad);
+
+    CHECK_TRUE(temp_sensor->calibrate_slot_timing(1));
+}
+
+TEST(One_wire_temperature_sensor_esp_idf,
+GIVEN_bus_rises_too_slowly_WHEN_slot_timing_is_calibrated_THEN_timing_is_not_changed)
+{
+    const One_wire_bus_measurement MEASUREMENT = {8, 20, 100};
+
+    mock().expectOneCall("onewire_get_timing")
+          .withOutputParameterReturning("timing", &ONEWIRE_STANDARD_TIMING, sizeof(ONEWIRE_STANDARD_TIMING));
+    mock().expectOneCall("onewire_measure")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+          .withOutputParameterReturning("measurement", &MEASUREMENT, sizeof(MEASUREMENT))
+          .andReturnValue(true);
+
+    CHECK_FALSE(temp_sensor->calibrate_slot_timing());
+}
+
+TEST_GROUP(One_wire_temperature_sensor_esp_idf_search)
+{
+    void setup()
+    {
+        make_select_commands();
+    }
+    void teardown()
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+TEST(One_wire_temperature_sensor_esp_idf_search,
+WHEN_sensor_is_instanced_THEN_bus_is_searched_and_power_supply_and_resolution_are_read)
+{
+    expect_search_of_first_device();
+
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN);
+
+    UNSIGNED_LONGS_EQUAL(12, sensor.get_resolution());
+    CHECK_FALSE(sensor.is_parasite_powered());
+    Device_address address;
+    sensor.get_device_address_on_index(address, 0);
+    MEMCMP_EQUAL(ROMS[0], address, sizeof(Device_address));
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.get_device_count());
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_search,
+GIVEN_sensor_was_instanced_WHEN_rescan_devices_THEN_bus_is_searched_again)
+{
+    expect_search_of_first_device();
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN);
+
+    expect_search_of_first_device();
+    sensor.rescan_devices();
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.get_device_count());
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_search,
+GIVEN_a_device_pulls_the_power_supply_read_low_WHEN_sensor_is_instanced_THEN_parasite_power_is_detected)
+{
+    const bool IS_PARASITE_POWERED = true;
+    uint8_t scratchpad[DS18X20_SCRATCHPAD_SIZE];
+    make_scratchpad(24.5, 0x1F, scratchpad);
+    expect_scan_of(ROMS[0]);
+    expect_power_supply_read(&IS_PARASITE_POWERED);
+    expect_power_supply_read_of(0, &IS_PARASITE_POWERED);
+    expect_scratchpad_read(0, scratchpad);
+
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN);
+
+    CHECK_TRUE(sensor.is_parasite_powered());
+    UNSIGNED_LONGS_EQUAL(9, sensor.get_resolution());
+}
+
+TEST_GROUP(One_wire_temperature_sensor_esp_idf_parasite)
+{
+    One_wire_temp_sensor* parasite_sensor;
+
+    void setup()
+    {
+        make_select_commands();
+        static constexpr Known_bus PARASITE_BUS(ROMS, 12, true);
+        expect_presence(true);
+        parasite_sensor = new One_wire_temp_sensor(TEMPERATURE_SENSOR_PIN, PARASITE_BUS);
+        mock().checkExpectations();
+        mock().clear();
+    }
+    void teardown()
+    {
+        mock().checkExpectations();
+        mock().clear();
+        delete parasite_sensor;
+    }
+
+    void expect_conversion_start_with_strong_pullup()
+    {
+        expect_presence(true);
+        expect_write(SKIP_ROM, sizeof(SKIP_ROM));
+        mock().expectOneCall("onewire_write_power")
+              .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN)
+              .withUnsignedIntParameter("v", DS18X20_CONVERT_T);
+    }
+};
+
+TEST(One_wire_temperature_sensor_esp_idf_parasite, GIVEN_parasite_powered_bus_THEN_is_parasite_powered)
+{
+    CHECK_TRUE(parasite_sensor->is_parasite_powered());
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_parasite,
+WHEN_conversion_time_is_over_THEN_strong_pullup_is_released_and_sample_is_available)
+{
+    expect_conversion_start_with_strong_pullup();
+    mock().expectOneCall("esp_timer_get_time")
+          .andReturnValue((int64_t)0);
+    parasite_sensor->request_temperatures();
+
+    int64_t USECS_TO_WAIT = 1000*(int64_t)parasite_sensor->get_millis_to_wait_for_conversion(parasite_sensor->get_resolution());
+    mock().expectOneCall("esp_timer_get_time")
+          .andReturnValue(USECS_TO_WAIT - 1);
+    mock().expectNoCall("onewire_read_bit");
+    CHECK_FALSE(parasite_sensor->is_sample_available());
+
+    mock().expectOneCall("esp_timer_get_time")
+          .andReturnValue(USECS_TO_WAIT);
+    mock().expectOneCall("onewire_depower")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+    CHECK_TRUE(parasite_sensor->is_sample_available());
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_parasite,
+WHEN_request_temperature_BLOCKING_THEN_strong_pullup_lasts_the_conversion_time_of_the_resolution)
+{
+    set_resolution_of_every_device(parasite_sensor, 9);
+
+    expect_conversion_start_with_strong_pullup();
+    mock().expectOneCall("vTaskDelay")
+          .withUnsignedIntParameter("xTicksToDelay", 11);
+    mock().expectOneCall("onewire_depower")
+          .withUnsignedIntParameter("pin", TEMPERATURE_SENSOR_PIN);
+
+    parasite_sensor->request_temperature_BLOCKING();
+}
+
+class Memory_snapshot_store : public Bus_snapshot_store {
+public:
+    bool has_snapshot = false;
+    Bus_snapshot snapshot = {};
+    unsigned saves = 0;
+
+    bool load(Bus_snapshot* snapshot_to_load) override {
+        if (has_snapshot)
+            *snapshot_to_load = snapshot;
+        return has_snapshot;
+    }
+    bool save(const Bus_snapshot& snapshot_to_save) override {
+        snapshot = snapshot_to_save;
+        has_snapshot = true;
+        ++saves;
+        return true;
+    }
+};
+
+TEST_GROUP(One_wire_temperature_sensor_esp_idf_warm_start)
+{
+    Memory_snapshot_store store;
+
+    void setup()
+    {
+        make_select_commands();
+        store.has_snapshot = true;
+        store.snapshot.resolution = 10;
+        store.snapshot.has_parasite_devices = false;
+        store.snapshot.device_count = 1;
+        memcpy(store.snapshot.addresses[0], ROMS[0], sizeof(Device_address));
+    }
+    void teardown()
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+TEST(One_wire_temperature_sensor_esp_idf_warm_start,
+     GIVEN_stored_snapshot_and_devices_present_WHEN_sensor_is_instanced_THEN_bus_is_not_searched)
+{
+    expect_presence(true);
+
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN, &store);
+
+    CHECK_TRUE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(10, sensor.get_resolution());
+    Device_address address;
+    sensor.get_device_address_on_index(address, 0);
+    MEMCMP_EQUAL(store.snapshot.addresses[0], address, sizeof(Device_address));
+    UNSIGNED_LONGS_EQUAL(0, store.saves);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_warm_start,
+     GIVEN_stored_snapshot_and_no_presence_WHEN_sensor_is_instanced_THEN_bus_is_searched_and_snapshot_is_saved)
+{
+    expect_presence(false);
+    expect_no_device_on_search();
+
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN, &store);
+
+    CHECK_FALSE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(1, store.saves);
+    UNSIGNED_LONGS_EQUAL(0, store.snapshot.device_count);
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_warm_start,
+     GIVEN_warm_start_WHEN_deferred_search_is_completed_THEN_snapshot_is_saved_only_if_bus_changed)
+{
+    store.snapshot.resolution = 12;
+    expect_presence(true);
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN, &store);
+
+    expect_search_of_first_device();
+    CHECK_FALSE(sensor.complete_deferred_search());
+    CHECK_FALSE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(0, store.saves);
+
+    expect_no_device_on_search();
+    CHECK_TRUE(sensor.complete_deferred_search());
+    UNSIGNED_LONGS_EQUAL(1, store.saves);
+}
+
+static constexpr Device_address KNOWN_ROMS[] = {
+    {0x28, 0xFF, 0x4C, 0x6B, 0x71, 0x16, 0x05, 0xB9},
+    {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2},
+};
+static constexpr Known_bus KNOWN_BUS(KNOWN_ROMS, 11, false);
+
+TEST_GROUP(One_wire_temperature_sensor_esp_idf_known_bus)
+{
+    void teardown()
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+TEST(One_wire_temperature_sensor_esp_idf_known_bus,
+     GIVEN_known_bus_and_devices_present_WHEN_sensor_is_instanced_THEN_bus_is_never_searched)
+{
+    expect_presence(true);
+
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN, KNOWN_BUS);
+
+    CHECK_FALSE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(11, sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(2, sensor.get_device_count());
+    Device_address address;
+    sensor.get_device_address_on_index(address, 1);
+    MEMCMP_EQUAL(KNOWN_ROMS[1], address, sizeof(Device_address));
+}
+
+TEST(One_wire_temperature_sensor_esp_idf_known_bus,
+     GIVEN_known_bus_and_no_presence_WHEN_sensor_is_instanced_THEN_bus_is_searched)
+{
+    expect_presence(false);
+    expect_no_device_on_search();
+
+    One_wire_temp_sensor sensor(TEMPERATURE_SENSOR_PIN, KNOWN_BUS);
+
+    UNSIGNED_LONGS_EQUAL(12, sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(0, sensor.get_device_count());
+}
@@ -0,0 +1,31 @@
+#pragma once
+// Generated by tools/generate_rom_channel_map.py, do not edit
+#include "../../implementation/common/Rom_channel_map.h"
+
+#define TEST_CHANNELS_ZONE3 0
+#define TEST_CHANNELS_OUTDOOR 1
+#define TEST_CHANNELS_BOILER_IN 2
+#define TEST_CHANNELS_ATTIC 3
+
+static constexpr Device_address TEST_CHANNELS_ROMS[] = {
+    {0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29},
+    {0x28, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF5},
+    {0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1E},
+    {0x28, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE6}
+};
+
+static constexpr const char* TEST_CHANNELS_NAMES[] = {
+    "zone3", "outdoor", "boiler_in", "attic"
+};
+
+static constexpr uint16_t TEST_CHANNELS_SEEDS[] = {
+    3, 2
+};
+
+static constexpr uint16_t TEST_CHANNELS_SLOT_CHANNELS[] = {
+    0, 3, 2, 1
+};
+
+static constexpr Rom_channel_map TEST_CHANNELS = {
+    TEST_CHANNELS_ROMS, TEST_CHANNELS_NAMES, 4, TEST_CHANNELS_SEEDS, 2, TEST_CHANNELS_SLOT_CHANNELS
+};
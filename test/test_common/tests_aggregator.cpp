@@ -0,0 +1,205 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Temperature_aggregator.h"
+
+TEST_GROUP(Tumbling_window_aggregator)
+{
+};
+
+TEST(Tumbling_window_aggregator, WHEN_window_is_not_complete_THEN_add_returns_false)
+{
+    Tumbling_window_aggregator aggregator(3);
+
+    CHECK_FALSE(aggregator.add(20.0f));
+    CHECK_FALSE(aggregator.add(21.0f));
+}
+
+TEST(Tumbling_window_aggregator, WHEN_window_is_complete_THEN_summary_has_min_max_and_average)
+{
+    Tumbling_window_aggregator aggregator(3);
+    aggregator.add(20.0f);
+    aggregator.add(23.5f);
+
+    CHECK_TRUE(aggregator.add(21.25f));
+
+    Temperature_summary summary = aggregator.get_summary();
+    CHECK_EQUAL(2000, summary.min_centi_celsius);
+    CHECK_EQUAL(2350, summary.max_centi_celsius);
+    CHECK_EQUAL(2158, summary.avg_centi_celsius);
+    CHECK_EQUAL(3, summary.sample_count);
+}
+
+TEST(Tumbling_window_aggregator, WHEN_window_is_complete_THEN_next_window_starts_empty)
+{
+    Tumbling_window_aggregator aggregator(2);
+    aggregator.add(-10.0f);
+    aggregator.add(-20.0f);
+
+    aggregator.add(5.0f);
+    CHECK_TRUE(aggregator.add(6.0f));
+
+    Temperature_summary summary = aggregator.get_summary();
+    CHECK_EQUAL(500, summary.min_centi_celsius);
+    CHECK_EQUAL(600, summary.max_centi_celsius);
+    CHECK_EQUAL(550, summary.avg_centi_celsius);
+}
+
+TEST_GROUP(Sliding_window_aggregator)
+{
+};
+
+TEST(Sliding_window_aggregator, WHEN_bucket_is_complete_THEN_add_returns_true)
+{
+    Sliding_window_aggregator aggregator(2*Sliding_window_aggregator::BUCKETS);
+
+    CHECK_FALSE(aggregator.add(20.0f));
+    CHECK_TRUE(aggregator.add(20.0f));
+}
+
+TEST(Sliding_window_aggregator, WHEN_samples_are_older_than_the_window_THEN_they_are_dropped)
+{
+    Sliding_window_aggregator aggregator(Sliding_window_aggregator::BUCKETS);
+    aggregator.add(-40.0f);
+    for (uint8_t i = 0; i < Sliding_window_aggregator::BUCKETS; ++i)
+        aggregator.add(10.0f);
+
+    Temperature_summary summary = aggregator.get_summary();
+    CHECK_EQUAL(1000, summary.min_centi_celsius);
+    CHECK_EQUAL(1000, summary.max_centi_celsius);
+    CHECK_EQUAL(1000, summary.avg_centi_celsius);
+}
+
+TEST(Sliding_window_aggregator, summary_covers_every_sample_inside_the_window)
+{
+    Sliding_window_aggregator aggregator(Sliding_window_aggregator::BUCKETS);
+    aggregator.add(10.0f);
+    aggregator.add(30.0f);
+    aggregator.add(20.0f);
+
+    Temperature_summary summary = aggregator.get_summary();
+    CHECK_EQUAL(1000, summary.min_centi_celsius);
+    CHECK_EQUAL(3000, summary.max_centi_celsius);
+    CHECK_EQUAL(2000, summary.avg_centi_celsius);
+    CHECK_EQUAL(3, summary.sample_count);
+}
+
+TEST(Sliding_window_aggregator, WHEN_window_is_full_THEN_summary_counts_every_sample_of_the_window)
+{
+    const uint16_t WINDOW_LENGTH = 60;
+    Sliding_window_aggregator aggregator(WINDOW_LENGTH);
+    bool is_bucket_closed = false;
+    for (uint16_t i = 0; i < WINDOW_LENGTH; ++i)
+        is_bucket_closed = aggregator.add(20.0f);
+
+    CHECK_TRUE(is_bucket_closed);
+    CHECK_EQUAL(WINDOW_LENGTH, aggregator.get_summary().sample_count);
+
+    for (uint16_t i = 0; i < 3*WINDOW_LENGTH; ++i)
+        is_bucket_closed = aggregator.add(20.0f);
+
+    CHECK_TRUE(is_bucket_closed);
+    CHECK_EQUAL(WINDOW_LENGTH, aggregator.get_summary().sample_count);
+}
+
+TEST_GROUP(Ema_aggregator)
+{
+};
+
+TEST(Ema_aggregator, WHEN_first_sample_is_added_THEN_average_is_the_sample)
+{
+    Ema_aggregator aggregator(0.5f, 1);
+    aggregator.add(20.0f);
+
+    DOUBLES_EQUAL(20.0f, aggregator.get_average_in_celsius(), 0.0001f);
+}
+
+TEST(Ema_aggregator, WHEN_sample_is_added_THEN_average_moves_by_alpha)
+{
+    Ema_aggregator aggregator(0.25f, 1);
+    aggregator.add(20.0f);
+    aggregator.add(24.0f);
+
+    DOUBLES_EQUAL(21.0f, aggregator.get_average_in_celsius(), 0.0001f);
+}
+
+TEST(Ema_aggregator, summary_is_emitted_every_samples_per_summary)
+{
+    Ema_aggregator aggregator(0.5f, 2);
+
+    CHECK_FALSE(aggregator.add(20.0f));
+    CHECK_TRUE(aggregator.add(22.0f));
+    CHECK_FALSE(aggregator.add(22.0f));
+    CHECK_TRUE(aggregator.add(22.0f));
+}
+
+TEST(Ema_aggregator, summary_min_and_max_are_the_ones_of_its_samples)
+{
+    Ema_aggregator aggregator(0.5f, 2);
+    aggregator.add(-10.0f);
+    aggregator.add(40.0f);
+
+    aggregator.add(20.0f);
+    CHECK_TRUE(aggregator.add(22.0f));
+
+    Temperature_summary summary = aggregator.get_summary();
+    CHECK_EQUAL(2000, summary.min_centi_celsius);
+    CHECK_EQUAL(2200, summary.max_centi_celsius);
+    CHECK_EQUAL(2, summary.sample_count);
+}
+
+static uint8_t summaries_received = 0;
+static Temperature_summary last_summary_received;
+
+static void summary_handler(const Device_address address, const Temperature_summary& summary)
+{
+    ++summaries_received;
+    last_summary_received = summary;
+}
+
+TEST_GROUP(Aggregator_bank)
+{
+    void setup()
+    {
+        summaries_received = 0;
+    }
+};
+
+TEST(Aggregator_bank, WHEN_window_of_a_sensor_is_complete_THEN_handler_receives_its_summary)
+{
+    Aggregator_bank<Tumbling_window_aggregator, 2> bank(Tumbling_window_aggregator(2), summary_handler);
+    Device_address address = {0x28, 1, 2, 3, 4, 5, 6, 7};
+
+    bank.on_reading(address, 20.0f);
+    CHECK_EQUAL(0, summaries_received);
+
+    bank.on_reading(address, 22.0f);
+    CHECK_EQUAL(1, summaries_received);
+    CHECK_EQUAL(2100, last_summary_received.avg_centi_celsius);
+}
+
+TEST(Aggregator_bank, readings_of_different_sensors_are_aggregated_separately)
+{
+    Aggregator_bank<Tumbling_window_aggregator, 2> bank(Tumbling_window_aggregator(2), summary_handler);
+    Device_address first_address = {0x28, 1, 2, 3, 4, 5, 6, 7};
+    Device_address second_address = {0x28, 7, 6, 5, 4, 3, 2, 1};
+
+    bank.on_reading(first_address, 20.0f);
+    bank.on_reading(second_address, 30.0f);
+    CHECK_EQUAL(0, summaries_received);
+
+    bank.on_reading(second_address, 32.0f);
+    CHECK_EQUAL(1, summaries_received);
+    CHECK_EQUAL(3100, last_summary_received.avg_centi_celsius);
+}
+
+TEST(Aggregator_bank, WHEN_table_is_full_THEN_readings_of_new_sensors_are_ignored)
+{
+    Aggregator_bank<Tumbling_window_aggregator, 1> bank(Tumbling_window_aggregator(1), summary_handler);
+    Device_address first_address = {0x28, 1, 2, 3, 4, 5, 6, 7};
+    Device_address second_address = {0x28, 7, 6, 5, 4, 3, 2, 1};
+
+    bank.on_reading(first_address, 20.0f);
+    bank.on_reading(second_address, 30.0f);
+
+    CHECK_EQUAL(1, summaries_received);
+    POINTERS_EQUAL(nullptr, bank.get_aggregator(second_address));
+}
\ No newline at end of file
@@ -0,0 +1,374 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Basic_one_wire_temp_sensor.h"
+#include "rom_channels_for_tests.h"
+#include <string.h>
+
+// Bus on a virtual clock, it counts what the sensor asks the backend to do
+struct Fake_bus {
+    bool has_parasite_devices = false;
+    uint32_t now_us = 0;
+    uint32_t request_us = 0;
+    uint32_t conversion_us = 750000;
+    bool is_done_early = false;
+    unsigned polls = 0;
+    unsigned depowers = 0;
+    uint32_t poll_us = 100;
+    uint8_t device_count = 2;
+    uint32_t device_conversion_us[2] = {500000, 600000};
+    uint8_t converting_device = 0;
+    unsigned device_conversions = 0;
+    One_wire_bus_measurement measurement = {3, 30, 120};
+    One_wire_slot_timing timing = {480, 70, 410, 10, 65, 65, 2, 11, 61, 1};
+    unsigned reads = 0;
+    unsigned failing_read = 0;              // 0 if no read fails
+};
+
+static Fake_bus bus;
+
+class Fake_backend {
+public:
+    typedef uint8_t Bus;
+
+    Fake_backend(uint8_t pin, Bus_snapshot_store* snapshot_store) {}
+
+    bool is_search_deferred() const { return false; }
+    void search_devices() {}
+    void rescan_devices() {}
+    bool get_snapshot(Bus_snapshot* snapshot) const {
+        snapshot->device_count = bus.device_count < BUS_SNAPSHOT_MAX_DEVICES ? bus.device_count : BUS_SNAPSHOT_MAX_DEVICES;
+        for (uint8_t i = 0; i < snapshot->device_count; ++i)
+            get_device_address_on_index(snapshot->addresses[i], i);
+        return snapshot->device_count == bus.device_count;
+    }
+
+    uint8_t get_device_count() const { return bus.device_count; }
+    void get_device_address_on_index(Device_address address_to_get, uint8_t index) const {
+        Device_address address = {DS18B20_FAMILY_ID, index, 0, 0, 0, 0, 0, 0};
+        address[7] = one_wire_crc8(address, 7);
+        memcpy(address_to_get, address, sizeof(Device_address));
+    }
+    uint8_t scan_devices_of_family(uint8_t family_id, Device_address* addresses_found, uint8_t max_addresses) { return 0; }
+    uint8_t get_resolution() const { return 12; }
+    bool set_resolution(uint8_t new_resolution) { return true; }
+    uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const { return get_max_conversion_millis(DS18B20_FAMILY_ID, resolution); }
+    bool is_parasite_powered() const { return bus.has_parasite_devices; }
+    void start_conversion() { bus.request_us = bus.now_us; }
+    bool start_conversion_of(const Device_address address) {
+        if (bus.has_parasite_devices)
+            return false;
+        bus.request_us = bus.now_us;
+        bus.converting_device = address[1];
+        bus.is_done_early = false;
+        ++bus.device_conversions;
+        return true;
+    }
+    void convert_BLOCKING(uint16_t millis_to_wait) { bus.request_us = 0; bus.now_us += 1000*millis_to_wait; }
+    bool is_conversion_time_over(uint16_t millis_to_wait) { return bus.now_us - bus.request_us >= 1000*(uint32_t)millis_to_wait; }
+    bool poll_conversion() {
+        ++bus.polls;
+        bus.now_us += bus.poll_us;
+        return bus.is_done_early || bus.now_us - bus.request_us >= bus.device_conversion_us[bus.converting_device];
+    }
+    void depower() { ++bus.depowers; }
+    bool read_celsius(const Device_address address, float* temperature_in_celsius, const Read_retry_policy& policy) const {
+        if (++bus.reads == bus.failing_read)
+            return false;
+        *temperature_in_celsius = 21.5f;
+        return true;
+    }
+    bool measure_bus(One_wire_bus_measurement* measurement) {
+        *measurement = bus.measurement;
+        return bus.measurement.presence_low_us != 0;
+    }
+    One_wire_slot_timing get_slot_timing() const { return bus.timing; }
+    void set_slot_timing(const One_wire_slot_timing& timing) { bus.timing = timing; }
+    uint32_t get_micros() const { return bus.now_us; }
+    uint32_t get_micros_at_conversion_request() const { return bus.request_us; }
+};
+
+// Sleeps on the virtual clock of the bus, woken up early_wakeup_us before the time asked on the first sleep
+class Fake_sleeper : public Light_sleeper {
+public:
+    unsigned sleeps = 0;
+    uint32_t slept_us = 0;
+    uint32_t early_wakeup_us = 0;
+    void sleep_us(uint32_t microseconds) override {
+        uint32_t sleep_us = sleeps++ == 0 ? microseconds - early_wakeup_us : microseconds;
+        slept_us += sleep_us;
+        bus.now_us += sleep_us;
+    }
+};
+
+class Latency_spy : public Read_latency_listener {
+public:
+    uint32_t last_request_to_data_us = 0;
+    void on_read_latency(const Device_address address, uint32_t request_to_data_us, uint32_t scratchpad_read_us) override {
+        last_request_to_data_us = request_to_data_us;
+    }
+};
+
+class Counting_snapshot_store : public Bus_snapshot_store {
+public:
+    unsigned saves = 0;
+
+    bool load(Bus_snapshot* snapshot) override { return false; }
+    bool save(const Bus_snapshot& snapshot) override {
+        ++saves;
+        return true;
+    }
+};
+
+TEST_GROUP(Basic_one_wire_temp_sensor)
+{
+    void setup()
+    {
+        bus = Fake_bus();
+    }
+};
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_parasite_bus_WHEN_conversion_time_is_not_over_THEN_bus_is_not_polled_nor_released)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    bus.has_parasite_devices = true;
+    bus.is_done_early = true;
+    bus.now_us = 1000;
+
+    sensor.request_temperatures();
+    bus.now_us += bus.conversion_us - 1;
+    CHECK_FALSE(sensor.is_sample_available());
+    UNSIGNED_LONGS_EQUAL(0, bus.polls);
+    UNSIGNED_LONGS_EQUAL(0, bus.depowers);
+
+    bus.now_us += 1;
+    CHECK_TRUE(sensor.is_sample_available());
+    UNSIGNED_LONGS_EQUAL(1, bus.depowers);
+    CHECK_TRUE(sensor.is_sample_available());
+    UNSIGNED_LONGS_EQUAL(1, bus.depowers);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_externally_powered_bus_WHEN_devices_finish_early_THEN_sample_is_available_without_depower)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+
+    sensor.request_temperatures();
+    bus.now_us += 100000;
+    CHECK_FALSE(sensor.is_sample_available());
+    bus.is_done_early = true;
+    CHECK_TRUE(sensor.is_sample_available());
+    UNSIGNED_LONGS_EQUAL(2, bus.polls);
+    UNSIGNED_LONGS_EQUAL(0, bus.depowers);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_blocking_request_WHEN_read_THEN_request_to_data_latency_is_unknown)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    Latency_spy spy;
+    sensor.set_read_latency_listener(&spy);
+    Device_address address = {0x28, 1, 2, 3, 4, 5, 6, 0};
+    float temperature = 0;
+
+    sensor.request_temperature_BLOCKING();
+    CHECK_TRUE(sensor.is_sample_available());
+    CHECK_TRUE(sensor.read_temperature_in_celsius(address, &temperature));
+    DOUBLES_EQUAL(21.5f, temperature, 0.0001f);
+    UNSIGNED_LONGS_EQUAL(READ_LATENCY_UNKNOWN, spy.last_request_to_data_us);
+}
+TEST(Basic_one_wire_temp_sensor, GIVEN_rom_channel_map_WHEN_channel_on_index_is_asked_THEN_the_channel_of_the_device_is_returned)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    UNSIGNED_LONGS_EQUAL(ROM_CHANNEL_NONE, sensor.get_channel_on_index(0));
+
+    sensor.set_rom_channel_map(&TEST_CHANNELS);
+
+    UNSIGNED_LONGS_EQUAL(TEST_CHANNELS_BOILER_IN, sensor.get_channel_on_index(0));
+    UNSIGNED_LONGS_EQUAL(TEST_CHANNELS_ZONE3, sensor.get_channel_on_index(1));
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_rom_channel_map_WHEN_temperatures_are_read_by_channel_THEN_only_the_channels_on_the_bus_are_written)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    sensor.set_rom_channel_map(&TEST_CHANNELS);
+    bus.device_count = 3;
+    float temperatures[3] = {0, 0, 0};
+
+    UNSIGNED_LONGS_EQUAL(2, sensor.read_temperatures_by_channel(temperatures, 3));
+
+    UNSIGNED_LONGS_EQUAL(2, bus.reads);
+    DOUBLES_EQUAL(21.5f, temperatures[TEST_CHANNELS_BOILER_IN], 0.0001f);
+    DOUBLES_EQUAL(21.5f, temperatures[TEST_CHANNELS_ZONE3], 0.0001f);
+    DOUBLES_EQUAL(0, temperatures[TEST_CHANNELS_OUTDOOR], 0.0001f);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_more_devices_than_a_snapshot_holds_WHEN_temperatures_are_read_by_channel_THEN_every_device_is_read)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    sensor.set_rom_channel_map(&TEST_CHANNELS);
+    bus.device_count = BUS_SNAPSHOT_MAX_DEVICES + 2;
+    float temperatures[4] = {0, 0, 0, 0};
+
+    UNSIGNED_LONGS_EQUAL(4, sensor.read_temperatures_by_channel(temperatures, 4));
+
+    DOUBLES_EQUAL(21.5f, temperatures[TEST_CHANNELS_ATTIC], 0.0001f);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_rom_channel_map_WHEN_a_channel_is_read_THEN_its_device_is_read)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    float temperature = 0;
+    CHECK_FALSE(sensor.read_temperature_of_channel(TEST_CHANNELS_ZONE3, &temperature));
+    sensor.set_rom_channel_map(&TEST_CHANNELS);
+
+    CHECK_TRUE(sensor.read_temperature_of_channel(TEST_CHANNELS_ZONE3, &temperature));
+    CHECK_FALSE(sensor.read_temperature_of_channel(TEST_CHANNELS.channel_count, &temperature));
+    DOUBLES_EQUAL(21.5f, temperature, 0.0001f);
+    UNSIGNED_LONGS_EQUAL(1, bus.reads);
+}
+
+TEST(Basic_one_wire_temp_sensor, WHEN_temperatures_are_acquired_THEN_the_conversion_is_slept_through_in_one_sleep)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    Fake_sleeper sleeper;
+    const Device_address GROUP[2] = {{DS18B20_FAMILY_ID, 0, 0, 0, 0, 0, 0, 0}, {DS18B20_FAMILY_ID, 1, 0, 0, 0, 0, 0, 0}};
+    float temperatures[2] = {0, 0};
+
+    UNSIGNED_LONGS_EQUAL(2, sensor.acquire_temperatures(GROUP, 2, temperatures, sleeper));
+
+    UNSIGNED_LONGS_EQUAL(1, sleeper.sleeps);
+    UNSIGNED_LONGS_EQUAL(bus.conversion_us, sleeper.slept_us);
+    UNSIGNED_LONGS_EQUAL(0, bus.polls);
+    UNSIGNED_LONGS_EQUAL(2, bus.reads);
+    DOUBLES_EQUAL(21.5f, temperatures[0], 0.0001f);
+    DOUBLES_EQUAL(21.5f, temperatures[1], 0.0001f);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_parasite_bus_and_early_wakeup_WHEN_temperatures_are_acquired_THEN_it_sleeps_until_conversion_time_is_over)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    bus.has_parasite_devices = true;
+    Fake_sleeper sleeper;
+    sleeper.early_wakeup_us = 2500;
+    const Device_address GROUP[1] = {{DS18B20_FAMILY_ID, 0, 0, 0, 0, 0, 0, 0}};
+    float temperature = 0;
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.acquire_temperatures(GROUP, 1, &temperature, sleeper));
+
+    UNSIGNED_LONGS_EQUAL(1 + 3, sleeper.sleeps);
+    UNSIGNED_LONGS_EQUAL(bus.conversion_us + 500, sleeper.slept_us);
+    UNSIGNED_LONGS_EQUAL(0, bus.polls);
+    UNSIGNED_LONGS_EQUAL(1, bus.depowers);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_a_read_fails_WHEN_temperatures_are_acquired_THEN_its_temperature_is_not_available)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    bus.failing_read = 1;
+    Fake_sleeper sleeper;
+    const Device_address GROUP[2] = {{DS18B20_FAMILY_ID, 0, 0, 0, 0, 0, 0, 0}, {DS18B20_FAMILY_ID, 1, 0, 0, 0, 0, 0, 0}};
+    float temperatures[2] = {0, 0};
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.acquire_temperatures(GROUP, 2, temperatures, sleeper));
+
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, temperatures[0], 0.0001f);
+    DOUBLES_EQUAL(21.5f, temperatures[1], 0.0001f);
+}
+
+TEST(Basic_one_wire_temp_sensor, WHEN_temperatures_of_a_group_are_requested_THEN_each_device_converts_alone)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    const Device_address GROUP[2] = {{DS18B20_FAMILY_ID, 0, 0, 0, 0, 0, 0, 0}, {DS18B20_FAMILY_ID, 1, 0, 0, 0, 0, 0, 0}};
+
+    CHECK_TRUE(sensor.request_temperatures_of(GROUP, 2));
+
+    UNSIGNED_LONGS_EQUAL(2, bus.device_conversions);
+    UNSIGNED_LONGS_EQUAL(1, bus.converting_device);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_parasite_bus_WHEN_temperatures_of_a_group_are_requested_THEN_nothing_converts)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    bus.has_parasite_devices = true;
+    const Device_address GROUP[1] = {{DS18B20_FAMILY_ID, 0, 0, 0, 0, 0, 0, 0}};
+
+    CHECK_FALSE(sensor.request_temperatures_of(GROUP, 1));
+    UNSIGNED_LONGS_EQUAL(0, bus.device_conversions);
+}
+
+TEST(Basic_one_wire_temp_sensor, WHEN_conversion_time_is_calibrated_THEN_slowest_device_plus_margin_is_waited_at_that_resolution)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    Conversion_time_table table(10);
+
+    CHECK_TRUE(sensor.calibrate_conversion_time(&table));
+
+    UNSIGNED_LONGS_EQUAL(2, table.get_device_count());
+    UNSIGNED_LONGS_EQUAL(660, sensor.get_millis_to_wait_for_conversion(12));
+    UNSIGNED_LONGS_EQUAL(375, sensor.get_millis_to_wait_for_conversion(11));
+
+    bus.device_conversion_us[0] = bus.device_conversion_us[1] = 900000;
+    sensor.request_temperatures();
+    bus.now_us += 659000;
+    CHECK_FALSE(sensor.is_sample_available());
+    bus.now_us += 1000;
+    CHECK_TRUE(sensor.is_sample_available());
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_parasite_bus_WHEN_conversion_time_is_calibrated_THEN_datasheet_time_is_kept)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    Conversion_time_table table;
+    bus.has_parasite_devices = true;
+
+    CHECK_FALSE(sensor.calibrate_conversion_time(&table));
+
+    UNSIGNED_LONGS_EQUAL(0, bus.polls);
+    UNSIGNED_LONGS_EQUAL(750, sensor.get_millis_to_wait_for_conversion(12));
+}
+
+TEST(Basic_one_wire_temp_sensor, WHEN_slot_timing_is_calibrated_THEN_every_device_is_read_with_the_calibrated_timing)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+
+    CHECK_TRUE(sensor.calibrate_slot_timing(3));
+
+    UNSIGNED_LONGS_EQUAL(6, bus.reads);
+    UNSIGNED_LONGS_EQUAL(1, bus.timing.recovery_us);
+    UNSIGNED_LONGS_EQUAL(5, bus.timing.read_sample_us);
+    UNSIGNED_LONGS_EQUAL(60, bus.timing.write_slot_us);
+    UNSIGNED_LONGS_EQUAL(90, bus.timing.presence_sample_us);
+    UNSIGNED_LONGS_EQUAL(390, bus.timing.reset_recovery_us);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_verify_read_fails_WHEN_slot_timing_is_calibrated_THEN_previous_timing_is_kept)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    bus.failing_read = 4;
+
+    CHECK_FALSE(sensor.calibrate_slot_timing(3));
+
+    UNSIGNED_LONGS_EQUAL(4, bus.reads);
+    UNSIGNED_LONGS_EQUAL(1, bus.timing.recovery_us);
+    UNSIGNED_LONGS_EQUAL(70, bus.timing.presence_sample_us);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_no_presence_pulse_WHEN_slot_timing_is_calibrated_THEN_no_device_is_read)
+{
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4);
+    bus.measurement.presence_low_us = 0;
+
+    CHECK_FALSE(sensor.calibrate_slot_timing());
+
+    UNSIGNED_LONGS_EQUAL(0, bus.reads);
+    UNSIGNED_LONGS_EQUAL(11, bus.timing.read_sample_us);
+}
+
+TEST(Basic_one_wire_temp_sensor, GIVEN_more_devices_than_a_snapshot_holds_WHEN_sensor_is_instanced_THEN_no_snapshot_is_saved)
+{
+    Counting_snapshot_store store;
+    bus.device_count = BUS_SNAPSHOT_MAX_DEVICES + 1;
+    Basic_one_wire_temp_sensor<Fake_backend> truncated_sensor(4, &store);
+    UNSIGNED_LONGS_EQUAL(0, store.saves);
+
+    bus.device_count = BUS_SNAPSHOT_MAX_DEVICES;
+    Basic_one_wire_temp_sensor<Fake_backend> sensor(4, &store);
+    UNSIGNED_LONGS_EQUAL(1, store.saves);
+}
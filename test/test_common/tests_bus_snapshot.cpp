@@ -0,0 +1,93 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Bus_snapshot.h"
+#include "../../implementation/common/File_bus_snapshot_store.h"
+#include <stdio.h>
+
+#define SNAPSHOT_FILE "build/bus_snapshot.bin"
+
+static Bus_snapshot make_snapshot() {
+    Bus_snapshot snapshot = {11, true, 2, {}};
+    Device_address first = {0x28, 0x61, 0x64, 0x12, 0x3C, 0x7C, 0x2F, 0x00};
+    Device_address second = {0x10, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00};
+    first[7] = one_wire_crc8(first, 7);
+    second[7] = one_wire_crc8(second, 7);
+    memcpy(snapshot.addresses[0], first, sizeof(Device_address));
+    memcpy(snapshot.addresses[1], second, sizeof(Device_address));
+    return snapshot;
+}
+
+TEST_GROUP(Bus_snapshot)
+{
+    uint8_t buffer[BUS_SNAPSHOT_MAX_SIZE];
+    Bus_snapshot decoded;
+
+    void teardown()
+    {
+        remove(SNAPSHOT_FILE);
+    }
+};
+
+TEST(Bus_snapshot, WHEN_crc16_of_check_string_THEN_it_is_the_dallas_crc16)
+{
+    const uint8_t CHECK_STRING[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    UNSIGNED_LONGS_EQUAL(0xBB3D, one_wire_crc16(CHECK_STRING, sizeof(CHECK_STRING)));
+}
+
+TEST(Bus_snapshot, WHEN_snapshot_is_encoded_and_decoded_THEN_it_is_the_same)
+{
+    Bus_snapshot snapshot = make_snapshot();
+
+    size_t length = encode_bus_snapshot(snapshot, buffer, sizeof(buffer));
+
+    UNSIGNED_LONGS_EQUAL(BUS_SNAPSHOT_SIZE(2), length);
+    CHECK_TRUE(decode_bus_snapshot(buffer, length, &decoded));
+    CHECK_TRUE(decoded == snapshot);
+}
+
+TEST(Bus_snapshot, GIVEN_small_buffer_WHEN_encoding_THEN_nothing_is_encoded)
+{
+    UNSIGNED_LONGS_EQUAL(0, encode_bus_snapshot(make_snapshot(), buffer, BUS_SNAPSHOT_SIZE(2) - 1));
+}
+
+TEST(Bus_snapshot, GIVEN_corrupted_byte_WHEN_decoding_THEN_snapshot_is_rejected)
+{
+    size_t length = encode_bus_snapshot(make_snapshot(), buffer, sizeof(buffer));
+    buffer[1] = 12;
+
+    CHECK_FALSE(decode_bus_snapshot(buffer, length, &decoded));
+}
+
+TEST(Bus_snapshot, GIVEN_truncated_snapshot_WHEN_decoding_THEN_snapshot_is_rejected)
+{
+    size_t length = encode_bus_snapshot(make_snapshot(), buffer, sizeof(buffer));
+
+    CHECK_FALSE(decode_bus_snapshot(buffer, length - 1, &decoded));
+}
+
+TEST(Bus_snapshot, GIVEN_rom_code_with_wrong_crc8_WHEN_decoding_THEN_snapshot_is_rejected)
+{
+    Bus_snapshot snapshot = make_snapshot();
+    snapshot.addresses[1][7] ^= 0xFF;
+    size_t length = encode_bus_snapshot(snapshot, buffer, sizeof(buffer));
+
+    CHECK_FALSE(decode_bus_snapshot(buffer, length, &decoded));
+}
+
+TEST(Bus_snapshot, GIVEN_no_file_WHEN_loading_THEN_there_is_no_snapshot)
+{
+    File_bus_snapshot_store store(SNAPSHOT_FILE);
+
+    CHECK_FALSE(store.load(&decoded));
+}
+
+TEST(Bus_snapshot, WHEN_snapshot_is_saved_to_file_THEN_it_is_loaded_back)
+{
+    File_bus_snapshot_store store(SNAPSHOT_FILE);
+    Bus_snapshot snapshot = make_snapshot();
+
+    CHECK_TRUE(store.save(snapshot));
+
+    CHECK_TRUE(store.load(&decoded));
+    CHECK_TRUE(decoded == snapshot);
+}
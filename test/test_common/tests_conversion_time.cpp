@@ -0,0 +1,58 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Conversion_time.h"
+
+static const Device_address DS18B20_ADDRESS = {DS18B20_FAMILY_ID, 1, 2, 3, 4, 5, 6, 0};
+static const Device_address DS18S20_ADDRESS = {DS18S20_FAMILY_ID, 1, 2, 3, 4, 5, 6, 0};
+
+TEST_GROUP(Conversion_time)
+{
+};
+
+TEST(Conversion_time, max_conversion_millis_by_family_and_resolution)
+{
+    UNSIGNED_LONGS_EQUAL(94, get_max_conversion_millis(DS18B20_FAMILY_ID, 9));
+    UNSIGNED_LONGS_EQUAL(188, get_max_conversion_millis(DS1822_FAMILY_ID, 10));
+    UNSIGNED_LONGS_EQUAL(375, get_max_conversion_millis(DS28EA00_FAMILY_ID, 11));
+    UNSIGNED_LONGS_EQUAL(750, get_max_conversion_millis(DS18B20_FAMILY_ID, 12));
+    UNSIGNED_LONGS_EQUAL(750, get_max_conversion_millis(DS18S20_FAMILY_ID, 9));
+    UNSIGNED_LONGS_EQUAL(750, get_max_conversion_millis(DS18B20_FAMILY_ID, 14));
+}
+
+TEST(Conversion_time, GIVEN_device_not_learned_WHEN_get_millis_to_wait_THEN_datasheet_time_is_returned)
+{
+    Conversion_time_table table;
+    table.record(DS18B20_ADDRESS, 12, 500000);
+
+    UNSIGNED_LONGS_EQUAL(750, table.get_millis_to_wait(DS18S20_ADDRESS, 12));
+    UNSIGNED_LONGS_EQUAL(94, table.get_millis_to_wait(DS18B20_ADDRESS, 9));
+}
+
+TEST(Conversion_time, WHEN_device_is_learned_THEN_slowest_time_plus_margin_is_returned_up_to_datasheet_time)
+{
+    Conversion_time_table table(20);
+    table.record(DS18B20_ADDRESS, 12, 500000);
+    table.record(DS18B20_ADDRESS, 12, 450000);
+    UNSIGNED_LONGS_EQUAL(600, table.get_millis_to_wait(DS18B20_ADDRESS, 12));
+
+    table.record(DS18B20_ADDRESS, 12, 700000);
+    UNSIGNED_LONGS_EQUAL(750, table.get_millis_to_wait(DS18B20_ADDRESS, 12));
+
+    table.record(DS18B20_ADDRESS, 9, 60000);
+    UNSIGNED_LONGS_EQUAL(72, table.get_millis_to_wait(DS18B20_ADDRESS, 9));
+    UNSIGNED_LONGS_EQUAL(750, table.get_millis_to_wait(DS18B20_ADDRESS, 12));
+    UNSIGNED_LONGS_EQUAL(1, table.get_device_count());
+}
+
+TEST(Conversion_time, GIVEN_table_is_full_WHEN_new_device_is_recorded_THEN_it_is_refused)
+{
+    Conversion_time_table table;
+    for (uint8_t i = 0; i < Conversion_time_table::MAX_DEVICES; ++i) {
+        Device_address address = {DS18B20_FAMILY_ID, i, 0, 0, 0, 0, 0, 0};
+        CHECK_TRUE(table.record(address, 12, 500000));
+    }
+    CHECK_FALSE(table.record(DS18S20_ADDRESS, 12, 500000));
+    CHECK_FALSE(table.record(DS18B20_ADDRESS, 12, 500000));
+
+    table.clear();
+    CHECK_TRUE(table.record(DS18S20_ADDRESS, 12, 500000));
+}
\ No newline at end of file
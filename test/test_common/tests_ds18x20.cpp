@@ -0,0 +1,193 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Ds18x20.h"
+#include "../../implementation/common/Simulated_transport.h"
+#include <string.h>
+
+static void make_rom(uint8_t family_id, uint8_t serial, Device_address rom) {
+    memset(rom, 0, sizeof(Device_address));
+    rom[0] = family_id;
+    rom[1] = serial;
+    rom[7] = one_wire_crc8(rom, 7);
+}
+
+TEST_GROUP(Ds18x20)
+{
+    Simulated_transport bus;
+    Ds18x20<Simulated_transport>* sensor;
+    Device_address first_rom;
+    Device_address second_rom;
+
+    void setup()
+    {
+        make_rom(DS18B20_FAMILY_ID, 0xA5, first_rom);
+        make_rom(DS18B20_FAMILY_ID, 0x5A, second_rom);
+        sensor = new Ds18x20<Simulated_transport>(bus);
+    }
+
+    void teardown()
+    {
+        delete sensor;
+    }
+};
+
+TEST(Ds18x20, WHEN_bus_is_scanned_THEN_every_device_is_found)
+{
+    Device_address third_rom;
+    make_rom(DS18S20_FAMILY_ID, 0xA5, third_rom);
+    bus.add_device(first_rom, 20.0f);
+    bus.add_device(second_rom, 20.0f);
+    bus.add_device(third_rom, 20.0f);
+
+    Device_address found[Simulated_transport::MAX_DEVICES];
+    size_t found_count = sensor->scan_devices(found, Simulated_transport::MAX_DEVICES);
+
+    UNSIGNED_LONGS_EQUAL(3, found_count);
+    const uint8_t* roms[] = {first_rom, second_rom, third_rom};
+    for (const uint8_t* rom : roms) {
+        bool is_found = false;
+        for (size_t i = 0; i < found_count; ++i)
+            is_found |= memcmp(found[i], rom, sizeof(Device_address)) == 0;
+        CHECK_TRUE(is_found);
+    }
+}
+
+TEST(Ds18x20, WHEN_there_are_more_devices_than_room_THEN_scan_stops_at_the_limit)
+{
+    bus.add_device(first_rom, 20.0f);
+    bus.add_device(second_rom, 20.0f);
+
+    Device_address found[1];
+
+    UNSIGNED_LONGS_EQUAL(1, sensor->scan_devices(found, 1));
+}
+
+TEST(Ds18x20, WHEN_temperature_is_measured_THEN_each_device_reports_its_own)
+{
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(second_rom, -10.125f);
+
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->measure(nullptr, false));
+    float first_temperature, second_temperature;
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->read_temperature(first_rom, &first_temperature));
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->read_temperature(second_rom, &second_temperature));
+
+    DOUBLES_EQUAL(21.5f, first_temperature, 0.0001f);
+    DOUBLES_EQUAL(-10.125f, second_temperature, 0.0001f);
+}
+
+TEST(Ds18x20, WHEN_a_DS18S20_is_read_THEN_the_extended_resolution_is_used)
+{
+    Device_address rom;
+    make_rom(DS18S20_FAMILY_ID, 0x01, rom);
+    bus.add_device(rom, 25.0625f);
+
+    sensor->measure(rom, false);
+    float temperature;
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->read_temperature(rom, &temperature));
+
+    DOUBLES_EQUAL(25.0625f, temperature, 0.0001f);
+}
+
+TEST(Ds18x20, WHEN_measure_is_requested_with_strong_pullup_THEN_bus_is_held_high_until_depower)
+{
+    bus.add_device(first_rom, 20.0f, true);
+
+    sensor->measure(first_rom, true);
+    CHECK_TRUE(bus.is_strong_pullup_enabled());
+
+    sensor->depower();
+    CHECK_FALSE(bus.is_strong_pullup_enabled());
+}
+
+TEST(Ds18x20, WHEN_measure_is_requested_without_strong_pullup_THEN_conversion_can_be_polled)
+{
+    bus.add_device(first_rom, 20.0f);
+
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->measure(first_rom, false));
+    CHECK_FALSE(bus.is_strong_pullup_enabled());
+
+    bool is_done = false;
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->poll_measure(&is_done));
+    CHECK_TRUE(is_done);
+}
+
+TEST(Ds18x20, WHEN_power_supply_is_read_THEN_any_parasite_powered_device_is_reported)
+{
+    bus.add_device(first_rom, 20.0f);
+    bool is_parasite_powered = true;
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->read_power_supply(nullptr, &is_parasite_powered));
+    CHECK_FALSE(is_parasite_powered);
+
+    bus.add_device(second_rom, 20.0f, true);
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->read_power_supply(nullptr, &is_parasite_powered));
+    CHECK_TRUE(is_parasite_powered);
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->read_power_supply(first_rom, &is_parasite_powered));
+    CHECK_FALSE(is_parasite_powered);
+}
+
+TEST(Ds18x20, WHEN_devices_of_a_family_are_scanned_THEN_other_families_are_not_found)
+{
+    Device_address ds18s20_rom, ds2408_rom;
+    make_rom(DS18S20_FAMILY_ID, 0x33, ds18s20_rom);
+    make_rom(0x29, 0x44, ds2408_rom);
+    bus.add_device(first_rom, 20.0f);
+    bus.add_device(ds18s20_rom, 20.0f);
+    bus.add_device(ds2408_rom, 20.0f);
+    bus.add_device(second_rom, 20.0f);
+
+    Device_address found[Simulated_transport::MAX_DEVICES];
+    UNSIGNED_LONGS_EQUAL(2, sensor->scan_devices_of_family(DS18B20_FAMILY_ID, found, Simulated_transport::MAX_DEVICES));
+    CHECK_EQUAL(DS18B20_FAMILY_ID, found[0][0]);
+    CHECK_EQUAL(DS18B20_FAMILY_ID, found[1][0]);
+
+    UNSIGNED_LONGS_EQUAL(1, sensor->scan_devices_of_family(0x29, found, Simulated_transport::MAX_DEVICES));
+    MEMCMP_EQUAL(ds2408_rom, found[0], sizeof(Device_address));
+
+    UNSIGNED_LONGS_EQUAL(0, sensor->scan_devices_of_family(0x26, found, Simulated_transport::MAX_DEVICES));
+}
+
+TEST(Ds18x20, WHEN_bus_is_scanned_THEN_only_ds18x20_devices_are_found_grouped_by_family)
+{
+    Device_address ds18s20_rom, ds2408_rom;
+    make_rom(DS18S20_FAMILY_ID, 0x33, ds18s20_rom);
+    make_rom(0x29, 0x44, ds2408_rom);
+    bus.add_device(ds18s20_rom, 20.0f);
+    bus.add_device(ds2408_rom, 20.0f);
+    bus.add_device(first_rom, 20.0f);
+
+    Device_address found[Simulated_transport::MAX_DEVICES];
+    UNSIGNED_LONGS_EQUAL(2, sensor->scan_devices(found, Simulated_transport::MAX_DEVICES));
+    MEMCMP_EQUAL(first_rom, found[0], sizeof(Device_address));
+    MEMCMP_EQUAL(ds18s20_rom, found[1], sizeof(Device_address));
+}
+
+TEST(Ds18x20, WHEN_scratchpad_is_corrupted_THEN_read_fails_with_crc_error)
+{
+    bus.add_device(first_rom, 20.0f);
+    sensor->measure(first_rom, false);
+    bus.get_scratchpad(0)[0] ^= 0x01;
+
+    float temperature;
+    CHECK_EQUAL(ONE_WIRE_CRC_ERROR, sensor->read_temperature(first_rom, &temperature));
+}
+
+TEST(Ds18x20, WHEN_resolution_is_written_THEN_conversion_uses_it)
+{
+    bus.add_device(first_rom, 21.5625f);
+    const uint8_t nine_bits_config[3] = {0x4B, 0x46, 0x1F};
+
+    CHECK_EQUAL(ONE_WIRE_OK, sensor->write_scratchpad(first_rom, nine_bits_config));
+    sensor->measure(first_rom, false);
+    float temperature;
+    sensor->read_temperature(first_rom, &temperature);
+
+    DOUBLES_EQUAL(21.5f, temperature, 0.0001f);
+}
+
+TEST(Ds18x20, WHEN_no_device_answers_THEN_status_is_no_presence)
+{
+    float temperature;
+
+    CHECK_EQUAL(ONE_WIRE_NO_PRESENCE, sensor->measure(nullptr, false));
+    CHECK_EQUAL(ONE_WIRE_NO_PRESENCE, sensor->read_temperature(first_rom, &temperature));
+}
\ No newline at end of file
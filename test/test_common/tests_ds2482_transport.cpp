@@ -0,0 +1,153 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Ds2482_transport.h"
+#include "../../implementation/common/Ds18x20.h"
+#include "../../implementation/common/Simulated_transport.h"
+#include <string.h>
+
+// DS2482-100 answering on I2C, with its 1-Wire side on a simulated bus
+class Fake_ds2482 : public I2c_port {
+public:
+    Simulated_transport& bus;
+    uint8_t status = 0;
+    uint8_t data = 0;
+    bool is_read_pointer_on_data = false;
+    uint8_t busy_polls_left = 0;
+    uint8_t busy_polls_per_command = 1;
+    bool is_stuck_busy = false;
+    unsigned triplet_commands = 0;
+    unsigned single_bit_commands = 0;
+
+    explicit Fake_ds2482(Simulated_transport& bus) : bus(bus) {
+    }
+
+    bool write(const uint8_t* bytes, size_t length) override {
+        is_read_pointer_on_data = false;
+        busy_polls_left = busy_polls_per_command;
+        switch (bytes[0]) {
+            case DS2482_ONE_WIRE_RESET:
+                status = bus.reset() ? DS2482_STATUS_PRESENCE : 0;
+                break;
+            case DS2482_ONE_WIRE_WRITE_BYTE:
+                bus.write_bytes(&bytes[1], 1);
+                break;
+            case DS2482_ONE_WIRE_READ_BYTE:
+                bus.read_bytes(&data, 1);
+                break;
+            case DS2482_ONE_WIRE_SINGLE_BIT: {
+                ++single_bit_commands;
+                bool bit = bytes[1] & 0x80;
+                if (bit)
+                    bus.read_bit(&bit);
+                else
+                    bus.write_bit(false);
+                status = bit ? DS2482_STATUS_SINGLE_BIT : 0;
+                break;
+            }
+            case DS2482_ONE_WIRE_TRIPLET: {
+                ++triplet_commands;
+                bool id_bit, complement_bit, direction = bytes[1] & 0x80;
+                bus.One_wire_transport<Simulated_transport>::triplet(&id_bit, &complement_bit, &direction);
+                status = (id_bit ? DS2482_STATUS_SINGLE_BIT : 0) | (complement_bit ? DS2482_STATUS_TRIPLET_SECOND_BIT : 0)
+                       | (direction ? DS2482_STATUS_DIRECTION : 0);
+                break;
+            }
+            case DS2482_SET_READ_POINTER:
+                is_read_pointer_on_data = bytes[1] == DS2482_DATA_REGISTER;
+                busy_polls_left = 0;
+                break;
+            default:
+                busy_polls_left = 0;
+                break;
+        }
+        return true;
+    }
+
+    bool read(uint8_t* bytes, size_t length) override {
+        if (is_read_pointer_on_data) {
+            bytes[0] = data;
+            return true;
+        }
+        bytes[0] = status;
+        if (is_stuck_busy || busy_polls_left > 0) {
+            bytes[0] |= DS2482_STATUS_BUSY;
+            if (busy_polls_left > 0)
+                --busy_polls_left;
+        }
+        return true;
+    }
+};
+
+static void make_rom(uint8_t family_id, uint8_t serial, Device_address rom) {
+    memset(rom, 0, sizeof(Device_address));
+    rom[0] = family_id;
+    rom[1] = serial;
+    rom[7] = one_wire_crc8(rom, 7);
+}
+
+TEST_GROUP(Ds2482_transport)
+{
+    Simulated_transport bus;
+    Fake_ds2482* bridge;
+    Ds2482_transport* transport;
+    Device_address first_rom;
+    Device_address second_rom;
+
+    void setup()
+    {
+        make_rom(DS18B20_FAMILY_ID, 0x0F, first_rom);
+        make_rom(DS18B20_FAMILY_ID, 0xF0, second_rom);
+        bridge = new Fake_ds2482(bus);
+        transport = new Ds2482_transport(*bridge);
+    }
+
+    void teardown()
+    {
+        delete transport;
+        delete bridge;
+    }
+};
+
+TEST(Ds2482_transport, WHEN_bus_is_searched_THEN_each_ROM_bit_is_one_triplet_command)
+{
+    bus.add_device(first_rom, 20.0f);
+    bus.add_device(second_rom, 20.0f);
+
+    Ds18x20<Ds2482_transport> sensor(*transport);
+    Device_address found[2];
+
+    UNSIGNED_LONGS_EQUAL(2, sensor.scan_devices(found, 2));
+    UNSIGNED_LONGS_EQUAL(2*64, bridge->triplet_commands);
+    UNSIGNED_LONGS_EQUAL(0, bridge->single_bit_commands);
+}
+
+TEST(Ds2482_transport, WHEN_temperature_is_read_through_the_bridge_THEN_it_is_the_device_one)
+{
+    bus.add_device(first_rom, 23.75f);
+    Ds18x20<Ds2482_transport> sensor(*transport);
+
+    sensor.measure(first_rom, false);
+    float temperature;
+    CHECK_EQUAL(ONE_WIRE_OK, sensor.read_temperature(first_rom, &temperature));
+
+    DOUBLES_EQUAL(23.75f, temperature, 0.0001f);
+}
+
+TEST(Ds2482_transport, WHEN_no_device_is_on_the_bus_THEN_reset_has_no_presence)
+{
+    CHECK_FALSE(transport->reset());
+}
+
+TEST(Ds2482_transport, WHEN_bridge_stays_busy_THEN_operation_fails)
+{
+    bus.add_device(first_rom, 20.0f);
+    bridge->is_stuck_busy = true;
+
+    CHECK_FALSE(transport->reset());
+    CHECK_FALSE(transport->write_byte(0x44));
+}
+
+TEST(Ds2482_transport, WHEN_strong_pullup_is_requested_THEN_it_is_not_supported)
+{
+    CHECK_FALSE(transport->strong_pullup(true));
+    CHECK_TRUE(transport->strong_pullup(false));
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Known_bus.h"
+#include <string.h>
+
+static constexpr Device_address KNOWN_ROMS[] = {
+    {0x28, 0xFF, 0x4C, 0x6B, 0x71, 0x16, 0x05, 0xB9},
+    {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2},
+};
+static constexpr Known_bus KNOWN_BUS(KNOWN_ROMS, 10, true);
+
+static_assert(KNOWN_BUS.is_valid && KNOWN_BUS.device_count == 2, "The ROM codes are checked at compile time");
+
+TEST_GROUP(Known_bus)
+{
+};
+
+TEST(Known_bus, WHEN_crc8_is_evaluated_at_compile_time_THEN_it_matches_the_run_time_one)
+{
+    uint8_t data[32];
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)(i*37 + 11);
+
+    for (size_t length = 0; length <= sizeof(data); ++length)
+        UNSIGNED_LONGS_EQUAL(one_wire_crc8(data, length), constexpr_one_wire_crc8(data, length));
+}
+
+TEST(Known_bus, GIVEN_a_constexpr_known_bus_THEN_it_points_to_the_table)
+{
+    POINTERS_EQUAL(KNOWN_ROMS, KNOWN_BUS.addresses);
+    UNSIGNED_LONGS_EQUAL(10, KNOWN_BUS.resolution);
+    CHECK_TRUE(KNOWN_BUS.has_parasite_devices);
+}
+
+TEST(Known_bus, GIVEN_a_ROM_code_with_a_wrong_crc_THEN_it_is_not_valid)
+{
+    Device_address roms[2];
+    memcpy(roms, KNOWN_ROMS, sizeof(roms));
+    CHECK_TRUE(are_known_roms_valid(roms, 2));
+
+    roms[1][7] ^= 0x01;
+
+    CHECK_FALSE(are_known_roms_valid(roms, 2));
+    CHECK_TRUE(are_known_roms_valid(roms, 1));
+    CHECK_FALSE(Known_bus(roms, 10, true).is_valid);
+}
+
+TEST(Known_bus, GIVEN_a_resolution_out_of_9_to_12_bits_THEN_it_is_not_valid)
+{
+    static_assert(!Known_bus(KNOWN_ROMS, 8, false).is_valid, "Below 9 bits");
+    static_assert(!Known_bus(KNOWN_ROMS, 13, false).is_valid, "Above 12 bits");
+}
+
+TEST(Known_bus, GIVEN_more_devices_than_the_sensor_holds_THEN_it_is_not_valid)
+{
+    static Device_address roms[ONE_WIRE_MAX_DEVICES + 1];
+    for (uint8_t i = 0; i < ONE_WIRE_MAX_DEVICES + 1; ++i) {
+        memset(roms[i], 0, sizeof(Device_address));
+        roms[i][0] = 0x28;
+        roms[i][1] = i;
+        roms[i][7] = one_wire_crc8(roms[i], 7);
+    }
+    const Device_address (&every_rom_it_holds)[ONE_WIRE_MAX_DEVICES] =
+        reinterpret_cast<const Device_address (&)[ONE_WIRE_MAX_DEVICES]>(roms);
+
+    CHECK_TRUE(Known_bus(every_rom_it_holds, 12, false).is_valid);
+    CHECK_FALSE(Known_bus(roms, 12, false).is_valid);
+}
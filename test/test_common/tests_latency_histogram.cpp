@@ -0,0 +1,98 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Latency_histogram.h"
+
+TEST_GROUP(Latency_histogram)
+{
+    Latency_histogram histogram;
+};
+
+TEST(Latency_histogram, WHEN_latency_is_added_THEN_it_is_counted_on_its_power_of_two_bucket)
+{
+    CHECK_EQUAL(0, Latency_histogram::get_bucket_FROM_latency(0));
+    CHECK_EQUAL(0, Latency_histogram::get_bucket_FROM_latency(1));
+    CHECK_EQUAL(1, Latency_histogram::get_bucket_FROM_latency(3));
+    CHECK_EQUAL(9, Latency_histogram::get_bucket_FROM_latency(1000));
+    CHECK_EQUAL(19, Latency_histogram::get_bucket_FROM_latency(750000));
+
+    histogram.add(1000);
+    histogram.add(1023);
+
+    CHECK_EQUAL(2, histogram.get_count(9));
+    UNSIGNED_LONGS_EQUAL(512, Latency_histogram::get_bucket_lower_bound_us(9));
+}
+
+TEST(Latency_histogram, WHEN_latency_is_above_the_last_bucket_THEN_it_is_counted_on_the_last_bucket)
+{
+    histogram.add(UINT32_MAX);
+
+    CHECK_EQUAL(1, histogram.get_count(Latency_histogram::BUCKETS - 1));
+}
+
+TEST(Latency_histogram, WHEN_reset_THEN_there_are_no_samples)
+{
+    histogram.add(10);
+    histogram.add(100000);
+    UNSIGNED_LONGS_EQUAL(2, histogram.get_sample_count());
+
+    histogram.reset();
+
+    UNSIGNED_LONGS_EQUAL(0, histogram.get_sample_count());
+}
+
+TEST_GROUP(Latency_histogram_table)
+{
+    Latency_histogram_table<2> table;
+    Device_address first = {0x28, 1, 0, 0, 0, 0, 0, 0};
+    Device_address second = {0x28, 2, 0, 0, 0, 0, 0, 0};
+    Device_address third = {0x28, 3, 0, 0, 0, 0, 0, 0};
+};
+
+TEST(Latency_histogram_table, WHEN_sensors_are_read_THEN_each_one_has_its_own_histograms)
+{
+    table.on_read_latency(first, 751000, 6000);
+    table.on_read_latency(second, READ_LATENCY_UNKNOWN, 40000);
+
+    Read_latency_histograms snapshot;
+    CHECK_TRUE(table.get_snapshot(first, &snapshot));
+    CHECK_EQUAL(1, snapshot.request_to_data.get_count(19));
+    CHECK_EQUAL(1, snapshot.scratchpad_read.get_count(12));
+
+    CHECK_TRUE(table.get_snapshot(second, &snapshot));
+    UNSIGNED_LONGS_EQUAL(0, snapshot.request_to_data.get_sample_count());
+    CHECK_EQUAL(1, snapshot.scratchpad_read.get_count(15));
+}
+
+TEST(Latency_histogram_table, WHEN_table_is_full_THEN_new_sensors_are_not_recorded)
+{
+    Read_latency_histograms snapshot;
+    table.on_read_latency(first, 1000, 1000);
+    table.on_read_latency(second, 1000, 1000);
+    table.on_read_latency(third, 1000, 1000);
+
+    CHECK_FALSE(table.get_snapshot(third, &snapshot));
+}
+
+TEST(Latency_histogram_table, WHEN_table_is_reset_THEN_no_sensor_has_histograms)
+{
+    Read_latency_histograms snapshot;
+    table.on_read_latency(first, 1000, 1000);
+
+    table.reset();
+
+    CHECK_FALSE(table.get_snapshot(first, &snapshot));
+}
+TEST(Latency_histogram_table, WHEN_table_has_more_than_127_sensors_THEN_every_sensor_keeps_its_own_histograms)
+{
+    static Latency_histogram_table<200> large_table;
+    Device_address address = {0x28, 0, 0, 0, 0, 0, 0, 0};
+    for (uint8_t i = 0; i < 150; ++i) {
+        address[1] = i;
+        large_table.on_read_latency(address, 1000, 1u << (i % Latency_histogram::BUCKETS));
+    }
+
+    Read_latency_histograms snapshot;
+    address[1] = 140;
+    CHECK_TRUE(large_table.get_snapshot(address, &snapshot));
+    UNSIGNED_LONGS_EQUAL(1, snapshot.scratchpad_read.get_sample_count());
+    CHECK_EQUAL(1, snapshot.scratchpad_read.get_count(140 % Latency_histogram::BUCKETS));
+}
@@ -0,0 +1,90 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Latest_readings.h"
+#include <thread>
+
+static uint32_t clock_us = 0;
+
+static uint32_t get_clock_us() {
+    return clock_us;
+}
+
+static Device_address FIRST = {0x28, 1, 0, 0, 0, 0, 0, 0xAA};
+static Device_address SECOND = {0x28, 2, 0, 0, 0, 0, 0, 0xBB};
+
+TEST_GROUP(Latest_readings)
+{
+    void setup()
+    {
+        clock_us = 1000;
+    }
+};
+
+TEST(Latest_readings, GIVEN_no_reading_WHEN_getting_THEN_it_is_not_available)
+{
+    Latest_readings readings;
+    Latest_reading reading;
+
+    CHECK_FALSE(readings.get(FIRST, &reading));
+    CHECK_FALSE(readings.get_on_index(0, &reading));
+    UNSIGNED_LONGS_EQUAL(0, readings.get_device_count());
+}
+
+TEST(Latest_readings, WHEN_readings_are_published_THEN_the_latest_of_every_device_is_got)
+{
+    Latest_readings readings(get_clock_us);
+    readings.on_reading(FIRST, 21.5f);
+    readings.on_reading(SECOND, 30.0f);
+    clock_us = 2000;
+    readings.on_reading(FIRST, 22.0f);
+
+    Latest_reading reading;
+    CHECK_TRUE(readings.get(FIRST, &reading));
+    MEMCMP_EQUAL(FIRST, reading.address, sizeof(Device_address));
+    DOUBLES_EQUAL(22.0, reading.temperature_in_celsius, 0.001);
+    UNSIGNED_LONGS_EQUAL(2000, reading.micros_at_reading);
+    UNSIGNED_LONGS_EQUAL(2, reading.reading_count);
+
+    CHECK_TRUE(readings.get_on_index(1, &reading));
+    MEMCMP_EQUAL(SECOND, reading.address, sizeof(Device_address));
+    DOUBLES_EQUAL(30.0, reading.temperature_in_celsius, 0.001);
+    UNSIGNED_LONGS_EQUAL(1000, reading.micros_at_reading);
+    UNSIGNED_LONGS_EQUAL(2, readings.get_device_count());
+}
+
+TEST(Latest_readings, GIVEN_table_is_full_WHEN_another_device_is_read_THEN_it_is_not_published)
+{
+    Latest_readings readings;
+    Device_address address = {0x28, 0, 0, 0, 0, 0, 0, 0};
+    for (uint8_t i = 0; i <= Latest_readings::MAX_DEVICES; ++i) {
+        address[1] = i;
+        readings.on_reading(address, i);
+    }
+
+    Latest_reading reading;
+    UNSIGNED_LONGS_EQUAL(Latest_readings::MAX_DEVICES, readings.get_device_count());
+    CHECK_FALSE(readings.get(address, &reading));
+}
+
+TEST(Latest_readings, GIVEN_owner_publishing_on_another_thread_WHEN_reading_THEN_every_snapshot_is_consistent)
+{
+    Latest_readings readings;
+    const uint32_t READINGS = 200000;
+    std::thread owner([&readings, READINGS]() {
+        for (uint32_t i = 1; i <= READINGS; ++i)
+            readings.on_reading(FIRST, (float)i);
+    });
+
+    uint32_t inconsistent = 0;
+    uint32_t last_count = 0;
+    while (last_count < READINGS) {
+        Latest_reading reading;
+        if (!readings.get(FIRST, &reading))
+            continue;
+        if (reading.temperature_in_celsius != (float)reading.reading_count || reading.reading_count < last_count)
+            ++inconsistent;
+        last_count = reading.reading_count;
+    }
+    owner.join();
+
+    UNSIGNED_LONGS_EQUAL(0, inconsistent);
+}
@@ -0,0 +1,185 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/One_wire_coroutines.h"
+
+static uint32_t clock_us = 0;
+
+static uint32_t get_clock_us() {
+    return clock_us;
+}
+
+// Sensor on the virtual clock, the sample is available conversion_ms after the request
+class Fake_coroutine_sensor {
+public:
+    uint8_t device_count = 2;
+    uint8_t id = 0;
+    uint16_t conversion_ms = 188;
+    uint32_t request_us = 0;
+    unsigned requests = 0;
+    unsigned reads = 0;
+    bool is_read_failing = false;
+
+    uint8_t get_device_count() { return device_count; }
+    void get_device_address_on_index(Device_address address_to_get, uint8_t index) const {
+        address_to_get[0] = id;
+        address_to_get[1] = index;
+    }
+    uint8_t get_resolution() const { return 10; }
+    uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const { return conversion_ms; }
+    void request_temperatures() {
+        request_us = clock_us;
+        ++requests;
+    }
+    bool is_sample_available() { return clock_us - request_us >= 1000*(uint32_t)conversion_ms; }
+    bool read_temperature_in_celsius(const Device_address address, float* temperature_in_celsius) {
+        ++reads;
+        if (is_read_failing)
+            return false;
+        *temperature_in_celsius = 20.0f + address[0] + address[1]/10.0f;
+        return true;
+    }
+};
+
+typedef Async_one_wire_temp_sensor<Fake_coroutine_sensor> Async_sensor;
+
+static One_wire_task sample_once(Async_sensor& sensor, float* temperatures, uint8_t* read, uint32_t* end_us) {
+    uint8_t found = co_await sensor.search();
+    co_await sensor.convert();
+    *read = co_await sensor.read_all(temperatures);
+    *end_us = clock_us;
+    (void)found;
+}
+
+static One_wire_task sample_forever(Async_sensor& sensor, float* temperatures, unsigned* cycles) {
+    co_await sensor.search();
+    for (;;) {
+        co_await sensor.convert();
+        co_await sensor.read_all(temperatures);
+        ++*cycles;
+    }
+}
+
+TEST_GROUP(One_wire_coroutines)
+{
+    Fake_coroutine_sensor sensor;
+    One_wire_executor* executor;
+
+    void setup()
+    {
+        clock_us = 0;
+        executor = new One_wire_executor(get_clock_us);
+    }
+
+    void teardown()
+    {
+        delete executor;
+    }
+
+    void run_until_done()
+    {
+        uint32_t wait_us;
+        while ((wait_us = executor->run_once()) != NOTHING_TO_RUN)
+            clock_us += wait_us;
+    }
+};
+
+TEST(One_wire_coroutines, WHEN_sampling_THEN_devices_are_read_after_the_conversion_time)
+{
+    Async_sensor async_sensor(sensor, *executor);
+    float temperatures[2];
+    uint8_t read = 0;
+    uint32_t end_us = 0;
+    CHECK_TRUE(executor->spawn(sample_once(async_sensor, temperatures, &read, &end_us)));
+
+    run_until_done();
+
+    UNSIGNED_LONGS_EQUAL(2, async_sensor.get_device_count());
+    UNSIGNED_LONGS_EQUAL(1, sensor.requests);
+    UNSIGNED_LONGS_EQUAL(2, read);
+    DOUBLES_EQUAL(20.0, temperatures[0], 0.001);
+    DOUBLES_EQUAL(20.1, temperatures[1], 0.001);
+    UNSIGNED_LONGS_EQUAL(188000, end_us);
+    UNSIGNED_LONGS_EQUAL(0, executor->get_task_count());
+}
+
+TEST(One_wire_coroutines, WHEN_conversion_is_running_THEN_executor_waits_the_conversion_time)
+{
+    Async_sensor async_sensor(sensor, *executor);
+    float temperatures[2];
+    uint8_t read = 0;
+    uint32_t end_us = 0;
+    executor->spawn(sample_once(async_sensor, temperatures, &read, &end_us));
+
+    UNSIGNED_LONGS_EQUAL(0, executor->run_once());
+    UNSIGNED_LONGS_EQUAL(0, executor->run_once());
+    UNSIGNED_LONGS_EQUAL(188000, executor->run_once());
+    UNSIGNED_LONGS_EQUAL(0, sensor.reads);
+}
+
+TEST(One_wire_coroutines, WHEN_reading_all_THEN_one_device_is_read_per_run)
+{
+    Async_sensor async_sensor(sensor, *executor);
+    float temperatures[2];
+    uint8_t read = 0;
+    uint32_t end_us = 0;
+    executor->spawn(sample_once(async_sensor, temperatures, &read, &end_us));
+    while (sensor.requests == 0)
+        executor->run_once();
+    clock_us += 188000;
+
+    executor->run_once();
+    UNSIGNED_LONGS_EQUAL(0, sensor.reads);
+    executor->run_once();
+    UNSIGNED_LONGS_EQUAL(1, sensor.reads);
+    executor->run_once();
+    UNSIGNED_LONGS_EQUAL(2, sensor.reads);
+}
+
+TEST(One_wire_coroutines, GIVEN_reads_fail_WHEN_reading_all_THEN_temperatures_are_not_available)
+{
+    Async_sensor async_sensor(sensor, *executor);
+    sensor.is_read_failing = true;
+    float temperatures[2];
+    uint8_t read = 1;
+    uint32_t end_us = 0;
+    executor->spawn(sample_once(async_sensor, temperatures, &read, &end_us));
+
+    run_until_done();
+
+    UNSIGNED_LONGS_EQUAL(0, read);
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, temperatures[0], 0.001);
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, temperatures[1], 0.001);
+}
+
+TEST(One_wire_coroutines, GIVEN_two_buses_WHEN_running_THEN_both_are_sampled_in_one_executor)
+{
+    Fake_coroutine_sensor other_sensor;
+    other_sensor.id = 1;
+    other_sensor.conversion_ms = 94;
+    Async_sensor async_sensor(sensor, *executor);
+    Async_sensor other_async_sensor(other_sensor, *executor);
+    float temperatures[2];
+    float other_temperatures[2];
+    unsigned cycles = 0;
+    unsigned other_cycles = 0;
+    executor->spawn(sample_forever(async_sensor, temperatures, &cycles));
+    executor->spawn(sample_forever(other_async_sensor, other_temperatures, &other_cycles));
+
+    while (clock_us < 1000000)
+        clock_us += executor->run_once();
+
+    UNSIGNED_LONGS_EQUAL(5, cycles);
+    UNSIGNED_LONGS_EQUAL(10, other_cycles);
+    DOUBLES_EQUAL(21.1, other_temperatures[1], 0.001);
+    UNSIGNED_LONGS_EQUAL(2, executor->get_task_count());
+}
+
+TEST(One_wire_coroutines, GIVEN_executor_is_full_WHEN_spawning_THEN_task_is_refused)
+{
+    Async_sensor async_sensor(sensor, *executor);
+    float temperatures[2];
+    unsigned cycles = 0;
+    for (uint8_t i = 0; i < One_wire_executor::MAX_TASKS; ++i)
+        CHECK_TRUE(executor->spawn(sample_forever(async_sensor, temperatures, &cycles)));
+
+    CHECK_FALSE(executor->spawn(sample_forever(async_sensor, temperatures, &cycles)));
+}
@@ -0,0 +1,252 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/One_wire_trace.h"
+#include "../../implementation/common/Traced_transport.h"
+#include "../../implementation/common/Replay_transport.h"
+#include "../../implementation/common/Ds18x20.h"
+#include "../../implementation/common/Simulated_transport.h"
+#include "../../implementation/common/Basic_one_wire_temp_sensor.h"
+#include "../../implementation/common/Transport_backend.h"
+#include <string.h>
+
+static uint32_t fake_micros_now = 0;
+
+static uint32_t get_fake_micros() {
+    return fake_micros_now;
+}
+
+// Time of the sensor facade while it is recorded, the delays move it forward
+struct Trace_test_clock {
+    static uint32_t get_micros() {
+        return fake_micros_now;
+    }
+
+    static void delay_ms(uint32_t millis) {
+        fake_micros_now += 1000*millis;
+    }
+};
+
+static void make_trace_rom(uint8_t serial, Device_address rom, uint8_t family_id = DS18B20_FAMILY_ID) {
+    memset(rom, 0, sizeof(Device_address));
+    rom[0] = family_id;
+    rom[1] = serial;
+    rom[7] = one_wire_crc8(rom, 7);
+}
+
+TEST_GROUP(One_wire_trace)
+{
+    void setup()
+    {
+        fake_micros_now = 0;
+    }
+};
+
+TEST(One_wire_trace, GIVEN_a_clock_WHEN_events_are_recorded_THEN_they_are_read_back_with_the_elapsed_time)
+{
+    uint8_t buffer[32];
+    One_wire_trace trace(buffer, sizeof(buffer), get_fake_micros);
+
+    fake_micros_now = 1000;
+    trace.record(ONE_WIRE_TRACE_RESET, ONE_WIRE_TRACE_VALUE);
+    fake_micros_now += 100;
+    trace.record(ONE_WIRE_TRACE_WRITE_BYTE, 0, 0xCC);
+    fake_micros_now += 750000;
+    trace.record(ONE_WIRE_TRACE_READ_BIT, ONE_WIRE_TRACE_FAILED);
+
+    UNSIGNED_LONGS_EQUAL(2 + 3 + 4, trace.get_length());
+    uint8_t copied[32];
+    UNSIGNED_LONGS_EQUAL(trace.get_length(), trace.copy(copied, sizeof(copied)));
+
+    One_wire_trace_reader reader(copied, trace.get_length());
+    One_wire_trace_record record;
+    CHECK_TRUE(reader.next(&record));
+    UNSIGNED_LONGS_EQUAL(ONE_WIRE_TRACE_RESET, record.event);
+    UNSIGNED_LONGS_EQUAL(ONE_WIRE_TRACE_VALUE, record.flags);
+    UNSIGNED_LONGS_EQUAL(0, record.elapsed_us);
+    CHECK_TRUE(reader.next(&record));
+    UNSIGNED_LONGS_EQUAL(ONE_WIRE_TRACE_WRITE_BYTE, record.event);
+    UNSIGNED_LONGS_EQUAL(0xCC, record.data);
+    UNSIGNED_LONGS_EQUAL(100, record.elapsed_us);
+    CHECK_TRUE(reader.next(&record));
+    UNSIGNED_LONGS_EQUAL(ONE_WIRE_TRACE_READ_BIT, record.event);
+    UNSIGNED_LONGS_EQUAL(ONE_WIRE_TRACE_FAILED, record.flags);
+    UNSIGNED_LONGS_EQUAL(750000, record.elapsed_us);
+    CHECK_FALSE(reader.next(&record));
+    CHECK_TRUE(reader.is_at_end());
+}
+
+TEST(One_wire_trace, GIVEN_a_full_trace_WHEN_an_event_is_recorded_THEN_the_oldest_ones_are_dropped)
+{
+    uint8_t buffer[8];
+    One_wire_trace trace(buffer, sizeof(buffer));
+
+    for (uint8_t data = 0; data < 5; ++data)
+        trace.record(ONE_WIRE_TRACE_WRITE_BYTE, 0, data);
+
+    UNSIGNED_LONGS_EQUAL(6, trace.get_length());
+    UNSIGNED_LONGS_EQUAL(3, trace.get_dropped_record_count());
+    uint8_t copied[8];
+    UNSIGNED_LONGS_EQUAL(6, trace.copy(copied, sizeof(copied)));
+    One_wire_trace_reader reader(copied, 6);
+    One_wire_trace_record record;
+    CHECK_TRUE(reader.next(&record));
+    UNSIGNED_LONGS_EQUAL(3, record.data);
+    CHECK_TRUE(reader.next(&record));
+    UNSIGNED_LONGS_EQUAL(4, record.data);
+    CHECK_FALSE(reader.next(&record));
+}
+
+TEST(One_wire_trace, GIVEN_a_destination_too_small_WHEN_copy_THEN_nothing_is_copied)
+{
+    uint8_t buffer[16];
+    One_wire_trace trace(buffer, sizeof(buffer));
+    trace.record(ONE_WIRE_TRACE_WRITE_BYTE, 0, 0x44);
+
+    uint8_t copied[2];
+
+    UNSIGNED_LONGS_EQUAL(0, trace.copy(copied, sizeof(copied)));
+}
+
+TEST_GROUP(Replay_transport)
+{
+    Simulated_transport simulated_bus;
+    uint8_t buffer[2048];
+    uint8_t recorded[2048];
+    size_t recorded_length = 0;
+    Device_address first_rom;
+    Device_address second_rom;
+
+    void setup()
+    {
+        fake_micros_now = 0;
+        make_trace_rom(0x11, first_rom);
+        make_trace_rom(0x22, second_rom);
+        simulated_bus.add_device(first_rom, 23.5f);
+        simulated_bus.add_device(second_rom, -4.25f);
+    }
+
+    // Scans the simulated bus and reads both devices, advancing the clock 10 us per event
+    void record_field_traffic()
+    {
+        One_wire_trace trace(buffer, sizeof(buffer), advance_fake_micros);
+        Traced_transport<Simulated_transport> traced_bus(simulated_bus, trace);
+        Ds18x20<Traced_transport<Simulated_transport>> sensor(traced_bus);
+        Device_address found[2];
+        sensor.scan_devices(found, 2);
+        sensor.measure(nullptr, true);
+        float temperature;
+        sensor.read_temperature(first_rom, &temperature);
+        sensor.read_temperature(second_rom, &temperature);
+        UNSIGNED_LONGS_EQUAL(0, trace.get_dropped_record_count());
+        recorded_length = trace.copy(recorded, sizeof(recorded));
+    }
+
+    static uint32_t advance_fake_micros()
+    {
+        fake_micros_now += 10;
+        return fake_micros_now;
+    }
+};
+
+TEST(Replay_transport, GIVEN_a_recorded_trace_WHEN_it_is_replayed_THEN_the_device_logic_sees_the_same_bus)
+{
+    record_field_traffic();
+    Replay_transport replay_bus(recorded, recorded_length);
+    Ds18x20<Replay_transport> sensor(replay_bus);
+
+    Device_address found[2];
+    UNSIGNED_LONGS_EQUAL(2, sensor.scan_devices(found, 2));
+    CHECK_EQUAL(ONE_WIRE_OK, sensor.measure(nullptr, true));
+    float first_temperature, second_temperature;
+    CHECK_EQUAL(ONE_WIRE_OK, sensor.read_temperature(first_rom, &first_temperature));
+    CHECK_EQUAL(ONE_WIRE_OK, sensor.read_temperature(second_rom, &second_temperature));
+
+    CHECK_TRUE(memcmp(found[0], first_rom, sizeof(Device_address)) == 0 ||
+               memcmp(found[1], first_rom, sizeof(Device_address)) == 0);
+    CHECK_TRUE(memcmp(found[0], second_rom, sizeof(Device_address)) == 0 ||
+               memcmp(found[1], second_rom, sizeof(Device_address)) == 0);
+    DOUBLES_EQUAL(23.5f, first_temperature, 0.0001f);
+    DOUBLES_EQUAL(-4.25f, second_temperature, 0.0001f);
+    UNSIGNED_LONGS_EQUAL(0, replay_bus.get_divergence_count());
+    CHECK_TRUE(replay_bus.is_finished());
+    UNSIGNED_LONGS_EQUAL(fake_micros_now - 10, replay_bus.get_micros());
+}
+
+TEST(Replay_transport, GIVEN_a_recorded_trace_WHEN_a_different_byte_is_written_THEN_it_is_a_divergence)
+{
+    record_field_traffic();
+    Replay_transport replay_bus(recorded, recorded_length);
+    Ds18x20<Replay_transport> sensor(replay_bus);
+    Device_address found[2];
+    sensor.scan_devices(found, 2);
+    sensor.measure(nullptr, true);
+
+    float temperature;
+    CHECK_TRUE(ONE_WIRE_OK != sensor.read_temperature(second_rom, &temperature));
+
+    CHECK_TRUE(replay_bus.get_divergence_count() > 0);
+    CHECK_FALSE(replay_bus.is_finished());
+}
+
+TEST(Replay_transport, GIVEN_a_replay_WHEN_rewind_THEN_it_is_replayed_again_from_the_start)
+{
+    record_field_traffic();
+    Replay_transport replay_bus(recorded, recorded_length);
+
+    CHECK_TRUE(replay_bus.reset());
+    replay_bus.rewind();
+
+    UNSIGNED_LONGS_EQUAL(0, replay_bus.get_micros());
+    CHECK_TRUE(replay_bus.reset());
+    UNSIGNED_LONGS_EQUAL(0, replay_bus.get_divergence_count());
+}
+
+TEST(Replay_transport, GIVEN_a_trace_recorded_from_the_sensor_WHEN_it_is_replayed_through_the_sensor_THEN_it_sees_the_same_bus)
+{
+    const uint8_t DS2408_FAMILY_ID = 0x29;
+    Device_address ds2408_rom;
+    make_trace_rom(0x33, ds2408_rom, DS2408_FAMILY_ID);
+    simulated_bus.add_device(ds2408_rom, 0.0f);
+    {
+        One_wire_trace trace(buffer, sizeof(buffer), advance_fake_micros);
+        Traced_transport<Simulated_transport> traced_bus(simulated_bus, trace);
+        Basic_one_wire_temp_sensor<Transport_backend<Traced_transport<Simulated_transport>, Trace_test_clock>> sensor(traced_bus);
+        Device_address found[2];
+        UNSIGNED_LONGS_EQUAL(1, sensor.scan_devices_of_family(DS2408_FAMILY_ID, found, 2));
+        sensor.request_temperatures();
+        fake_micros_now += 1000;
+        CHECK_TRUE(sensor.is_sample_available());
+        DOUBLES_EQUAL(23.5f, sensor.get_temperature_in_celsius(first_rom), 0.0001f);
+        DOUBLES_EQUAL(-4.25f, sensor.get_temperature_in_celsius(second_rom), 0.0001f);
+        UNSIGNED_LONGS_EQUAL(0, trace.get_dropped_record_count());
+        recorded_length = trace.copy(recorded, sizeof(recorded));
+    }
+    Replay_transport replay_bus(recorded, recorded_length);
+    Replay_clock::replay = &replay_bus;
+
+    // The search, the power supply and the resolution read at construction, a family search, then
+    // a conversion polled without the strong pullup
+    Basic_one_wire_temp_sensor<Transport_backend<Replay_transport, Replay_clock>> sensor(replay_bus);
+    Device_address found[2];
+    UNSIGNED_LONGS_EQUAL(1, sensor.scan_devices_of_family(DS2408_FAMILY_ID, found, 2));
+    sensor.request_temperatures();
+    CHECK_TRUE(sensor.is_sample_available());
+    DOUBLES_EQUAL(23.5f, sensor.get_temperature_in_celsius(first_rom), 0.0001f);
+    DOUBLES_EQUAL(-4.25f, sensor.get_temperature_in_celsius(second_rom), 0.0001f);
+
+    CHECK_FALSE(sensor.is_parasite_powered());
+    MEMCMP_EQUAL(ds2408_rom, found[0], sizeof(Device_address));
+    UNSIGNED_LONGS_EQUAL(0, replay_bus.get_divergence_count());
+    CHECK_TRUE(replay_bus.is_finished());
+}
+
+TEST(Replay_transport, GIVEN_a_replay_WHEN_the_clock_is_read_THEN_it_is_the_time_of_the_next_event)
+{
+    record_field_traffic();
+    Replay_transport replay_bus(recorded, recorded_length);
+    Replay_clock::replay = &replay_bus;
+
+    UNSIGNED_LONGS_EQUAL(0, Replay_clock::get_micros());
+    CHECK_TRUE(replay_bus.reset());
+    UNSIGNED_LONGS_EQUAL(10, Replay_clock::get_micros());
+    UNSIGNED_LONGS_EQUAL(0, replay_bus.get_micros());
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Pipelined_sampler.h"
+#include <string.h>
+
+static uint32_t pipeline_clock_us = 0;
+
+static uint32_t get_pipeline_clock_us() {
+    return pipeline_clock_us;
+}
+
+#define DEVICES 8
+#define CONVERSION_US 188000
+#define CONVERT_COMMAND_US 1000
+#define READ_US 12000
+
+// Sensor on the virtual clock, device i has serial i. It counts the reads done before the conversion was over
+class Pipelined_fake_sensor {
+public:
+    bool has_parasite_devices = false;
+    uint32_t request_us[DEVICES] = {};
+    bool is_requested[DEVICES] = {};
+    unsigned reads[DEVICES] = {};
+    uint32_t read_us[DEVICES] = {};
+    uint32_t read_period_us[DEVICES] = {};
+    unsigned early_reads = 0;
+
+    uint8_t get_resolution() const { return 10; }
+    uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const { return CONVERSION_US/1000; }
+    bool is_parasite_powered() const { return has_parasite_devices; }
+    bool request_temperatures_of(const Device_address* addresses, uint8_t device_count) {
+        for (uint8_t i = 0; i < device_count; ++i) {
+            pipeline_clock_us += CONVERT_COMMAND_US;
+            request_us[addresses[i][1]] = pipeline_clock_us;
+            is_requested[addresses[i][1]] = true;
+        }
+        return true;
+    }
+    bool read_temperature_in_celsius(const Device_address address, float* temperature_in_celsius) {
+        uint8_t device = address[1];
+        if (!is_requested[device] || pipeline_clock_us - request_us[device] < CONVERSION_US)
+            ++early_reads;
+        is_requested[device] = false;
+        ++reads[device];
+        read_period_us[device] = pipeline_clock_us - read_us[device];
+        read_us[device] = pipeline_clock_us;
+        pipeline_clock_us += READ_US;
+        *temperature_in_celsius = 21.5f;
+        return true;
+    }
+};
+
+TEST_GROUP(Pipelined_sampler)
+{
+    Pipelined_fake_sensor sensor;
+    Device_address addresses[DEVICES];
+
+    void setup()
+    {
+        pipeline_clock_us = 0;
+        for (uint8_t i = 0; i < DEVICES; ++i) {
+            Device_address address = {0x28, i, 0, 0, 0, 0, 0, 0};
+            memcpy(addresses[i], address, sizeof(Device_address));
+        }
+    }
+
+    void run_until(Pipelined_sampler<Pipelined_fake_sensor>& sampler, uint32_t end_us)
+    {
+        while (pipeline_clock_us < end_us)
+            pipeline_clock_us += sampler.run();
+    }
+};
+
+TEST(Pipelined_sampler, GIVEN_two_groups_WHEN_running_THEN_every_device_is_read_after_its_conversion)
+{
+    Pipelined_sampler<Pipelined_fake_sensor> sampler(sensor, addresses, DEVICES, 2, get_pipeline_clock_us);
+    CHECK_TRUE(sampler.start());
+
+    run_until(sampler, 2000000);
+
+    UNSIGNED_LONGS_EQUAL(0, sensor.early_reads);
+    for (uint8_t i = 1; i < DEVICES; ++i)
+        CHECK_TRUE(sensor.reads[i] + 1 >= sensor.reads[0] && sensor.reads[i] <= sensor.reads[0]);
+    UNSIGNED_LONGS_EQUAL(sampler.get_cycles(0), sensor.reads[0]);
+    UNSIGNED_LONGS_EQUAL(sampler.get_cycles(1), sensor.reads[DEVICES - 1]);
+}
+
+TEST(Pipelined_sampler, GIVEN_two_groups_WHEN_running_THEN_devices_are_read_more_often_than_with_one)
+{
+    Pipelined_sampler<Pipelined_fake_sensor> serialized(sensor, addresses, DEVICES, 1, get_pipeline_clock_us);
+    serialized.start();
+    run_until(serialized, 2000000);
+
+    pipeline_clock_us = 0;
+    Pipelined_fake_sensor pipelined_sensor;
+    Pipelined_sampler<Pipelined_fake_sensor> pipelined(pipelined_sensor, addresses, DEVICES, 2, get_pipeline_clock_us);
+    pipelined.start();
+    run_until(pipelined, 2000000);
+
+    // A cycle is the conversion plus the commands and reads of its group, the other group is read meanwhile
+    UNSIGNED_LONGS_EQUAL(CONVERSION_US + DEVICES*(CONVERT_COMMAND_US + READ_US), sensor.read_period_us[0]);
+    UNSIGNED_LONGS_EQUAL(CONVERSION_US + DEVICES/2*(CONVERT_COMMAND_US + READ_US), pipelined_sensor.read_period_us[0]);
+    UNSIGNED_LONGS_EQUAL(CONVERSION_US + DEVICES/2*(CONVERT_COMMAND_US + READ_US), pipelined_sensor.read_period_us[DEVICES - 1]);
+    UNSIGNED_LONGS_EQUAL(0, pipelined_sensor.early_reads);
+}
+
+TEST(Pipelined_sampler, GIVEN_parasite_powered_bus_WHEN_started_THEN_nothing_is_converted)
+{
+    sensor.has_parasite_devices = true;
+    Pipelined_sampler<Pipelined_fake_sensor> sampler(sensor, addresses, DEVICES, 2, get_pipeline_clock_us);
+
+    CHECK_FALSE(sampler.start());
+    UNSIGNED_LONGS_EQUAL(0, sampler.run());
+    UNSIGNED_LONGS_EQUAL(0, pipeline_clock_us);
+}
+
+TEST(Pipelined_sampler, GIVEN_more_groups_than_devices_THEN_every_group_has_a_device)
+{
+    Pipelined_sampler<Pipelined_fake_sensor> sampler(sensor, addresses, 2, 4, get_pipeline_clock_us);
+
+    UNSIGNED_LONGS_EQUAL(2, sampler.get_group_count());
+}
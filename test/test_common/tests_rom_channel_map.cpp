@@ -0,0 +1,51 @@
+#include "CppUTest/TestHarness.h"
+#include "rom_channels_for_tests.h"
+#include "../../implementation/common/One_wire_crc.h"
+#include <string.h>
+
+TEST_GROUP(Rom_channel_map)
+{
+};
+
+TEST(Rom_channel_map, WHEN_a_rom_of_the_map_is_looked_up_THEN_its_channel_is_returned)
+{
+    for (uint16_t channel = 0; channel < TEST_CHANNELS.channel_count; ++channel)
+        UNSIGNED_LONGS_EQUAL(channel, get_rom_channel(TEST_CHANNELS, TEST_CHANNELS_ROMS[channel]));
+    STRCMP_EQUAL("outdoor", TEST_CHANNELS.names[TEST_CHANNELS_OUTDOOR]);
+}
+
+TEST(Rom_channel_map, WHEN_a_rom_out_of_the_map_is_looked_up_THEN_there_is_no_channel)
+{
+    for (uint8_t serial = 0; serial < 255; ++serial) {
+        Device_address rom = {DS18S20_FAMILY_ID, serial, 0, 0, 0, 0, 0, 0};
+        rom[7] = one_wire_crc8(rom, 7);
+        UNSIGNED_LONGS_EQUAL(ROM_CHANNEL_NONE, get_rom_channel(TEST_CHANNELS, rom));
+    }
+}
+
+TEST(Rom_channel_map, GIVEN_an_empty_map_WHEN_a_rom_is_looked_up_THEN_there_is_no_channel)
+{
+    const Rom_channel_map EMPTY_MAP = {nullptr, nullptr, 0, nullptr, 0, nullptr};
+
+    UNSIGNED_LONGS_EQUAL(ROM_CHANNEL_NONE, get_rom_channel(EMPTY_MAP, TEST_CHANNELS_ROMS[0]));
+}
+
+TEST(Rom_channel_map, GIVEN_a_map_without_buckets_WHEN_a_rom_is_looked_up_THEN_there_is_no_channel)
+{
+    const Rom_channel_map MAP_WITHOUT_BUCKETS = {TEST_CHANNELS_ROMS, TEST_CHANNELS_NAMES, 4, nullptr, 0,
+                                                 TEST_CHANNELS_SLOT_CHANNELS};
+
+    UNSIGNED_LONGS_EQUAL(ROM_CHANNEL_NONE, get_rom_channel(MAP_WITHOUT_BUCKETS, TEST_CHANNELS_ROMS[0]));
+}
+
+TEST(Rom_channel_map, GIVEN_roms_differing_in_the_high_bits_of_a_byte_THEN_their_slots_can_differ_modulo_a_power_of_two)
+{
+    const Device_address ROM = {DS18B20_FAMILY_ID, 0x01, 0, 0, 0, 0, 0, 0x29};
+    const Device_address ROM_WITH_HIGH_BITS = {DS18B20_FAMILY_ID, 0xF1, 0, 0, 0, 0, 0, 0x29};
+
+    bool is_any_slot_different = false;
+    for (uint32_t seed = 1; seed <= 16; ++seed)
+        is_any_slot_different |= rom_channel_hash(ROM, seed) % 4 != rom_channel_hash(ROM_WITH_HIGH_BITS, seed) % 4;
+
+    CHECK_TRUE(is_any_slot_different);
+}
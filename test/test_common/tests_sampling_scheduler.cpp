@@ -0,0 +1,132 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Sampling_scheduler.h"
+
+static uint32_t clock_us = 0;
+
+static uint32_t get_clock_us() {
+    return clock_us;
+}
+
+// Sensor on the virtual clock, every read takes read_us
+class Fake_sensor {
+public:
+    static const uint8_t MAX_REQUESTS = 16;
+    uint32_t request_us[MAX_REQUESTS];
+    uint8_t requests = 0;
+    unsigned reads = 0;
+    uint32_t read_us = 5000;
+
+    uint8_t get_resolution() const { return 10; }
+    uint16_t get_millis_to_wait_for_conversion(uint8_t resolution) const { return 188; }
+    void request_temperatures() {
+        if (requests < MAX_REQUESTS)
+            request_us[requests] = clock_us;
+        ++requests;
+    }
+    bool is_sample_available() { return true; }
+    bool read_temperature_in_celsius(const Device_address address, float* temperature_in_celsius) {
+        ++reads;
+        clock_us += read_us;
+        *temperature_in_celsius = 21.5f;
+        return true;
+    }
+};
+
+class Deadline_spy : public Deadline_listener {
+public:
+    unsigned missed = 0;
+    uint32_t last_deadline_us = 0;
+    uint32_t last_late_us = 0;
+    void on_deadline_missed(uint32_t deadline_us, uint32_t late_us) override {
+        ++missed;
+        last_deadline_us = deadline_us;
+        last_late_us = late_us;
+    }
+};
+
+static const Device_address GROUP[2] = {{0x28, 1, 0, 0, 0, 0, 0, 0}, {0x28, 2, 0, 0, 0, 0, 0, 0}};
+#define PERIOD_US 250000
+#define FIRST_DEADLINE_US 1000000
+
+TEST_GROUP(Sampling_scheduler)
+{
+    Fake_sensor sensor;
+    Deadline_spy spy;
+
+    void setup()
+    {
+        clock_us = 0;
+    }
+
+    void run_until(Sampling_scheduler<Fake_sensor>& scheduler, uint32_t end_us)
+    {
+        while (clock_us < end_us)
+            clock_us += scheduler.run();
+    }
+};
+
+TEST(Sampling_scheduler, WHEN_running_THEN_conversions_start_one_period_apart_before_each_deadline)
+{
+    Sampling_scheduler<Fake_sensor> scheduler(sensor, GROUP, 2, PERIOD_US, get_clock_us);
+    scheduler.set_deadline_listener(&spy);
+    scheduler.start(FIRST_DEADLINE_US);
+
+    run_until(scheduler, FIRST_DEADLINE_US + 4*PERIOD_US);
+
+    UNSIGNED_LONGS_EQUAL(FIRST_DEADLINE_US - 188000 - 2*DEFAULT_READ_BUDGET_US_PER_DEVICE, sensor.request_us[0]);
+    for (uint8_t i = 1; i < 5; ++i)
+        UNSIGNED_LONGS_EQUAL(PERIOD_US, sensor.request_us[i] - sensor.request_us[i - 1]);
+    UNSIGNED_LONGS_EQUAL(10, sensor.reads);
+    UNSIGNED_LONGS_EQUAL(0, scheduler.get_missed_deadlines());
+    UNSIGNED_LONGS_EQUAL(0, spy.missed);
+}
+
+TEST(Sampling_scheduler, GIVEN_reads_end_late_WHEN_running_THEN_deadline_is_missed_and_next_deadlines_keep_their_place)
+{
+    Sampling_scheduler<Fake_sensor> scheduler(sensor, GROUP, 2, PERIOD_US, get_clock_us);
+    scheduler.set_deadline_listener(&spy);
+    scheduler.start(FIRST_DEADLINE_US);
+    sensor.read_us = 20000;
+
+    run_until(scheduler, FIRST_DEADLINE_US + 1);
+
+    UNSIGNED_LONGS_EQUAL(1, spy.missed);
+    UNSIGNED_LONGS_EQUAL(FIRST_DEADLINE_US, spy.last_deadline_us);
+    UNSIGNED_LONGS_EQUAL(16000, spy.last_late_us);
+    UNSIGNED_LONGS_EQUAL(40000, scheduler.get_read_budget_us());
+    UNSIGNED_LONGS_EQUAL(FIRST_DEADLINE_US + PERIOD_US, scheduler.get_next_deadline_us());
+
+    run_until(scheduler, FIRST_DEADLINE_US + 3*PERIOD_US);
+
+    UNSIGNED_LONGS_EQUAL(1, scheduler.get_missed_deadlines());
+    UNSIGNED_LONGS_EQUAL(FIRST_DEADLINE_US + 2*PERIOD_US - 188000 - 40000, sensor.request_us[2]);
+}
+
+TEST(Sampling_scheduler, GIVEN_period_as_long_as_conversion_and_reads_WHEN_reads_end_THEN_next_conversion_starts_right_after)
+{
+    const uint32_t TIGHT_PERIOD_US = 188000 + 2*DEFAULT_READ_BUDGET_US_PER_DEVICE;
+    Sampling_scheduler<Fake_sensor> scheduler(sensor, GROUP, 2, TIGHT_PERIOD_US, get_clock_us);
+    scheduler.start(FIRST_DEADLINE_US);
+    sensor.read_us = DEFAULT_READ_BUDGET_US_PER_DEVICE;
+
+    run_until(scheduler, FIRST_DEADLINE_US);
+    UNSIGNED_LONGS_EQUAL(2, sensor.requests);
+    UNSIGNED_LONGS_EQUAL(FIRST_DEADLINE_US, sensor.request_us[1]);
+    UNSIGNED_LONGS_EQUAL(0, scheduler.get_missed_deadlines());
+}
+
+TEST(Sampling_scheduler, GIVEN_loop_stalled_for_periods_WHEN_running_THEN_missed_cycles_are_skipped_not_burst)
+{
+    Sampling_scheduler<Fake_sensor> scheduler(sensor, GROUP, 2, PERIOD_US, get_clock_us);
+    scheduler.set_deadline_listener(&spy);
+    scheduler.start(FIRST_DEADLINE_US);
+    run_until(scheduler, FIRST_DEADLINE_US - 100000);
+    UNSIGNED_LONGS_EQUAL(1, sensor.requests);
+
+    clock_us += 3*PERIOD_US;
+    scheduler.run();
+
+    UNSIGNED_LONGS_EQUAL(3, spy.missed);
+    UNSIGNED_LONGS_EQUAL(2, sensor.requests);
+    UNSIGNED_LONGS_EQUAL(FIRST_DEADLINE_US + 3*PERIOD_US, scheduler.get_next_deadline_us());
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Slot_timing_calibration.h"
+
+static const One_wire_slot_timing STANDARD = {480, 70, 410, 10, 65, 65, 2, 11, 61, 1};
+
+TEST_GROUP(Slot_timing_calibration)
+{
+    One_wire_slot_timing calibrated;
+};
+
+static const One_wire_slot_timing ARDUINO_STANDARD = {480, 70, 410, 10, 65, 65, 3, 10, 66, 5};
+
+// Reset, Match ROM and Read Scratchpad, the transaction of a temperature read
+static uint32_t get_read_transaction_us(const One_wire_slot_timing& timing) {
+    const uint32_t BITS_WRITTEN = 8*(1 + 8 + 1);
+    const uint32_t BITS_READ = 8*9;
+    return timing.reset_low_us + timing.presence_sample_us + timing.reset_recovery_us +
+           BITS_WRITTEN*(timing.write_slot_us + timing.recovery_us) + BITS_READ*(timing.read_slot_us + timing.recovery_us);
+}
+
+TEST(Slot_timing_calibration, GIVEN_short_bus_WHEN_calibrating_THEN_slots_are_cut_to_the_spec_and_samples_follow_the_bus)
+{
+    One_wire_bus_measurement measurement = {1, 20, 100};
+
+    CHECK_TRUE(calibrate_slot_timing(measurement, STANDARD, &calibrated));
+
+    UNSIGNED_LONGS_EQUAL(STANDARD.recovery_us, calibrated.recovery_us);
+    UNSIGNED_LONGS_EQUAL(3, calibrated.read_sample_us);
+    UNSIGNED_LONGS_EQUAL(70, calibrated.presence_sample_us);
+    UNSIGNED_LONGS_EQUAL(410, calibrated.reset_recovery_us);
+    UNSIGNED_LONGS_EQUAL(SLOT_TIMING_MIN_WRITE_0_LOW_US, calibrated.write_0_low_us);
+    UNSIGNED_LONGS_EQUAL(SLOT_TIMING_MIN_SLOT_US, calibrated.write_slot_us);
+    UNSIGNED_LONGS_EQUAL(SLOT_TIMING_MIN_SLOT_US, calibrated.read_slot_us);
+    UNSIGNED_LONGS_EQUAL(STANDARD.reset_low_us, calibrated.reset_low_us);
+    UNSIGNED_LONGS_EQUAL(STANDARD.write_1_low_us, calibrated.write_1_low_us);
+    UNSIGNED_LONGS_EQUAL(STANDARD.read_low_us, calibrated.read_low_us);
+}
+
+TEST(Slot_timing_calibration, GIVEN_fast_bus_WHEN_calibrating_THEN_recovery_is_the_rise_time)
+{
+    One_wire_bus_measurement measurement = {1, 20, 100};
+
+    CHECK_TRUE(calibrate_slot_timing(measurement, ARDUINO_STANDARD, &calibrated));
+
+    UNSIGNED_LONGS_EQUAL(3, calibrated.recovery_us);
+}
+
+TEST(Slot_timing_calibration, WHEN_calibrating_THEN_a_read_takes_less_time_than_with_the_standard_timing)
+{
+    One_wire_bus_measurement measurement = {3, 35, 150};
+    const One_wire_slot_timing* STANDARDS[] = {&STANDARD, &ARDUINO_STANDARD};
+
+    for (const One_wire_slot_timing* standard : STANDARDS) {
+        CHECK_TRUE(calibrate_slot_timing(measurement, *standard, &calibrated));
+        CHECK_TRUE(get_read_transaction_us(calibrated) < get_read_transaction_us(*standard));
+    }
+}
+
+TEST(Slot_timing_calibration, GIVEN_bus_rising_slower_than_the_recovery_WHEN_calibrating_THEN_no_time_is_lengthened)
+{
+    One_wire_bus_measurement measurement = {2, 35, 150};
+
+    CHECK_TRUE(calibrate_slot_timing(measurement, STANDARD, &calibrated));
+
+    UNSIGNED_LONGS_EQUAL(STANDARD.recovery_us, calibrated.recovery_us);
+    CHECK_TRUE(calibrated.write_slot_us <= STANDARD.write_slot_us);
+    CHECK_TRUE(calibrated.read_slot_us <= STANDARD.read_slot_us);
+    UNSIGNED_LONGS_EQUAL(STANDARD.presence_sample_us + STANDARD.reset_recovery_us, calibrated.presence_sample_us + calibrated.reset_recovery_us);
+}
+
+TEST(Slot_timing_calibration, GIVEN_calibrated_timing_WHEN_calibrating_again_THEN_timing_is_the_same)
+{
+    One_wire_bus_measurement measurement = {3, 35, 150};
+    One_wire_slot_timing calibrated_again;
+
+    CHECK_TRUE(calibrate_slot_timing(measurement, STANDARD, &calibrated));
+    CHECK_TRUE(calibrate_slot_timing(measurement, calibrated, &calibrated_again));
+
+    MEMCMP_EQUAL(&calibrated, &calibrated_again, sizeof(One_wire_slot_timing));
+}
+
+TEST(Slot_timing_calibration, GIVEN_bus_rising_after_the_device_sample_WHEN_calibrating_THEN_it_fails)
+{
+    One_wire_bus_measurement measurement = {4, 20, 100};
+
+    CHECK_FALSE(calibrate_slot_timing(measurement, STANDARD, &calibrated));
+}
+
+TEST(Slot_timing_calibration, GIVEN_presence_pulse_out_of_spec_WHEN_calibrating_THEN_it_fails)
+{
+    One_wire_bus_measurement late = {1, 80, 100};
+    One_wire_bus_measurement short_pulse = {1, 20, 40};
+    One_wire_bus_measurement long_pulse = {1, 20, 300};
+
+    CHECK_FALSE(calibrate_slot_timing(late, STANDARD, &calibrated));
+    CHECK_FALSE(calibrate_slot_timing(short_pulse, STANDARD, &calibrated));
+    CHECK_FALSE(calibrate_slot_timing(long_pulse, STANDARD, &calibrated));
+}
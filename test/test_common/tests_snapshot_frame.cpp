@@ -0,0 +1,131 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Snapshot_frame.h"
+#include <string.h>
+
+#define BUS_ID 3
+#define TIMESTAMP 0x12345678
+
+TEST_GROUP(Snapshot_frame)
+{
+    uint8_t buffer[SNAPSHOT_FRAME_SIZE(64)];
+};
+
+TEST(Snapshot_frame, WHEN_frame_has_64_readings_THEN_it_fits_in_less_than_200_bytes)
+{
+    Snapshot_frame_encoder encoder(buffer, sizeof(buffer));
+    encoder.begin(BUS_ID, TIMESTAMP);
+    for (uint8_t i = 0; i < 64; ++i)
+        CHECK_TRUE(encoder.add_reading(i, i*16));
+
+    size_t frame_length = encoder.finish();
+
+    UNSIGNED_LONGS_EQUAL(199, frame_length);
+}
+
+TEST(Snapshot_frame, WHEN_frame_is_decoded_THEN_header_and_readings_are_the_encoded_ones)
+{
+    Snapshot_frame_encoder encoder(buffer, sizeof(buffer));
+    encoder.begin(BUS_ID, TIMESTAMP);
+    encoder.add_reading(0, 392);
+    encoder.add_reading_in_celsius(7, -10.125f);
+    size_t frame_length = encoder.finish();
+
+    Snapshot_frame_decoder decoder(buffer, frame_length);
+
+    CHECK_TRUE(decoder.is_valid());
+    CHECK_EQUAL(SNAPSHOT_FRAME_VERSION, decoder.get_version());
+    CHECK_EQUAL(BUS_ID, decoder.get_bus_id());
+    CHECK_EQUAL((uint32_t)TIMESTAMP, decoder.get_timestamp());
+    CHECK_EQUAL(2, decoder.get_reading_count());
+
+    uint8_t rom_index;
+    int16_t raw_temperature;
+    CHECK_TRUE(decoder.get_reading(1, &rom_index, &raw_temperature));
+    CHECK_EQUAL(7, rom_index);
+    CHECK_EQUAL(-162, raw_temperature);
+    DOUBLES_EQUAL(-10.125f, get_celsius_FROM_raw_temperature(raw_temperature), 0.0001f);
+}
+
+TEST(Snapshot_frame, WHEN_a_byte_is_corrupted_THEN_frame_is_invalid)
+{
+    Snapshot_frame_encoder encoder(buffer, sizeof(buffer));
+    encoder.begin(BUS_ID, TIMESTAMP);
+    encoder.add_reading(0, 392);
+    size_t frame_length = encoder.finish();
+
+    buffer[SNAPSHOT_FRAME_HEADER_SIZE + 1] ^= 0x01;
+    Snapshot_frame_decoder decoder(buffer, frame_length);
+
+    CHECK_FALSE(decoder.is_valid());
+    CHECK_EQUAL(0, decoder.get_reading_count());
+}
+
+TEST(Snapshot_frame, WHEN_frame_is_truncated_THEN_frame_is_invalid)
+{
+    Snapshot_frame_encoder encoder(buffer, sizeof(buffer));
+    encoder.begin(BUS_ID, TIMESTAMP);
+    encoder.add_reading(0, 392);
+    size_t frame_length = encoder.finish();
+
+    Snapshot_frame_decoder decoder(buffer, frame_length - 1);
+
+    CHECK_FALSE(decoder.is_valid());
+}
+
+TEST(Snapshot_frame, WHEN_buffer_is_full_THEN_add_reading_fails)
+{
+    Snapshot_frame_encoder encoder(buffer, SNAPSHOT_FRAME_SIZE(1));
+    encoder.begin(BUS_ID, TIMESTAMP);
+
+    CHECK_TRUE(encoder.add_reading(0, 392));
+    CHECK_FALSE(encoder.add_reading(1, 392));
+    UNSIGNED_LONGS_EQUAL(SNAPSHOT_FRAME_SIZE(1), encoder.finish());
+}
+
+TEST(Snapshot_frame, WHEN_bus_id_does_not_fit_in_the_header_THEN_begin_fails)
+{
+    Snapshot_frame_encoder encoder(buffer, sizeof(buffer));
+
+    CHECK_FALSE(encoder.begin(SNAPSHOT_FRAME_MAX_BUS_ID + 1, TIMESTAMP));
+    CHECK_FALSE(encoder.add_reading(0, 392));
+    UNSIGNED_LONGS_EQUAL(0, encoder.finish());
+}
+
+TEST(Snapshot_frame, WHEN_version_is_unknown_THEN_frame_is_invalid)
+{
+    Snapshot_frame_encoder encoder(buffer, sizeof(buffer));
+    encoder.begin(BUS_ID, TIMESTAMP);
+    size_t frame_length = encoder.finish();
+
+    buffer[0] = (SNAPSHOT_FRAME_VERSION + 1) << 5 | BUS_ID;
+    Snapshot_frame_decoder decoder(buffer, frame_length);
+
+    CHECK_FALSE(decoder.is_valid());
+}
+TEST(Snapshot_frame, WHEN_frame_has_the_max_reading_count_THEN_no_reading_is_added_and_count_fits)
+{
+    static uint8_t big_buffer[SNAPSHOT_FRAME_SIZE(SNAPSHOT_FRAME_MAX_READINGS + 1)];
+    Snapshot_frame_encoder encoder(big_buffer, sizeof(big_buffer));
+    encoder.begin(BUS_ID, TIMESTAMP);
+    for (unsigned i = 0; i < SNAPSHOT_FRAME_MAX_READINGS; ++i)
+        CHECK_TRUE(encoder.add_reading((uint8_t)i, 392));
+
+    CHECK_FALSE(encoder.add_reading(0, 392));
+    size_t frame_length = encoder.finish();
+
+    Snapshot_frame_decoder decoder(big_buffer, frame_length);
+    CHECK_TRUE(decoder.is_valid());
+    UNSIGNED_LONGS_EQUAL(SNAPSHOT_FRAME_MAX_READINGS, decoder.get_reading_count());
+}
+
+TEST(Snapshot_frame, WHEN_frame_is_shorter_than_the_header_THEN_header_fields_are_not_read)
+{
+    const uint8_t SHORT_FRAME[] = {(SNAPSHOT_FRAME_VERSION << 5) | BUS_ID, 0x78};
+
+    Snapshot_frame_decoder decoder(SHORT_FRAME, sizeof(SHORT_FRAME));
+
+    CHECK_FALSE(decoder.is_valid());
+    UNSIGNED_LONGS_EQUAL(0, decoder.get_version());
+    UNSIGNED_LONGS_EQUAL(0, decoder.get_bus_id());
+    UNSIGNED_LONGS_EQUAL(0, decoder.get_timestamp());
+}
\ No newline at end of file
@@ -0,0 +1,451 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Basic_one_wire_temp_sensor.h"
+#include "../../implementation/common/Transport_backend.h"
+#include "../../implementation/common/Simulated_transport.h"
+#include "rom_channels_for_tests.h"
+#include <string.h>
+
+#define MAX_DELAYS 8
+
+static uint32_t backend_clock_us = 0;
+static uint32_t delays_ms[MAX_DELAYS];
+static uint8_t delay_count = 0;
+
+// Virtual time, the delays only move it forward
+struct Backend_test_clock {
+    static uint32_t get_micros() {
+        return backend_clock_us;
+    }
+
+    static void delay_ms(uint32_t millis) {
+        if (delay_count < MAX_DELAYS)
+            delays_ms[delay_count++] = millis;
+        backend_clock_us += 1000*millis;
+    }
+};
+
+// Corrupts the next scratchpad reads, and records the slot timing and the CRC failures
+class Flaky_transport : public Simulated_transport {
+public:
+    uint8_t scratchpad_reads_to_corrupt = 0;
+    uint8_t crc_failures = 0;
+    One_wire_slot_timing timing = {480, 70, 410, 10, 65, 65, 2, 11, 61, 1};
+    uint16_t recoveries_used_us[MAX_DELAYS];
+    uint8_t scratchpad_reads = 0;
+
+    bool read_bytes(uint8_t* bytes, size_t count) {
+        if (!Simulated_transport::read_bytes(bytes, count))
+            return false;
+        if (count == DS18X20_SCRATCHPAD_SIZE) {
+            if (scratchpad_reads < MAX_DELAYS)
+                recoveries_used_us[scratchpad_reads++] = timing.recovery_us;
+            if (scratchpad_reads_to_corrupt > 0) {
+                bytes[0] ^= 0x01;
+                --scratchpad_reads_to_corrupt;
+            }
+        }
+        return true;
+    }
+
+    One_wire_slot_timing get_slot_timing() {
+        return timing;
+    }
+
+    One_wire_slot_timing get_slow_slot_timing() {
+        One_wire_slot_timing slow_timing = timing;
+        slow_timing.recovery_us = 30;
+        return slow_timing;
+    }
+
+    void set_slot_timing(const One_wire_slot_timing& new_timing) {
+        timing = new_timing;
+    }
+
+    void count_crc_failure() {
+        ++crc_failures;
+    }
+};
+
+typedef Basic_one_wire_temp_sensor<Transport_backend<Flaky_transport, Backend_test_clock>> Transport_sensor;
+
+class Transport_snapshot_store : public Bus_snapshot_store {
+public:
+    bool has_snapshot = false;
+    Bus_snapshot snapshot = {};
+    unsigned saves = 0;
+
+    bool load(Bus_snapshot* snapshot_to_load) override {
+        if (has_snapshot)
+            *snapshot_to_load = snapshot;
+        return has_snapshot;
+    }
+    bool save(const Bus_snapshot& snapshot_to_save) override {
+        snapshot = snapshot_to_save;
+        has_snapshot = true;
+        ++saves;
+        return true;
+    }
+};
+
+class Transport_reading_listener_spy : public Reading_listener {
+public:
+    uint8_t readings_received = 0;
+    void on_reading(const Device_address address, float temperature_in_celsius) override {
+        ++readings_received;
+    }
+};
+
+class Transport_latency_listener_spy : public Read_latency_listener {
+public:
+    uint32_t last_request_to_data_us = 0;
+    void on_read_latency(const Device_address address, uint32_t request_to_data_us, uint32_t scratchpad_read_us) override {
+        last_request_to_data_us = request_to_data_us;
+    }
+};
+
+static void make_backend_rom(uint8_t family_id, uint8_t serial, Device_address rom) {
+    memset(rom, 0, sizeof(Device_address));
+    rom[0] = family_id;
+    rom[1] = serial;
+    rom[7] = one_wire_crc8(rom, 7);
+}
+
+TEST_GROUP(Transport_backend)
+{
+    Flaky_transport bus;
+    Device_address first_rom;
+    Device_address second_rom;
+
+    void setup()
+    {
+        backend_clock_us = 0;
+        delay_count = 0;
+        make_backend_rom(DS18B20_FAMILY_ID, 0xA5, first_rom);
+        make_backend_rom(DS18B20_FAMILY_ID, 0x5A, second_rom);
+    }
+};
+
+TEST(Transport_backend, WHEN_sensor_is_instanced_THEN_the_devices_power_mode_and_resolution_are_found)
+{
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(second_rom, 22.0f, true);
+
+    Transport_sensor sensor(bus);
+
+    UNSIGNED_LONGS_EQUAL(2, sensor.get_device_count());
+    CHECK_TRUE(sensor.is_parasite_powered());
+    UNSIGNED_LONGS_EQUAL(12, sensor.get_resolution());
+    Device_address address;
+    sensor.get_device_address_on_index(address, 1);
+    CHECK_TRUE(memcmp(address, first_rom, sizeof(Device_address)) == 0 || memcmp(address, second_rom, sizeof(Device_address)) == 0);
+}
+
+TEST(Transport_backend, GIVEN_resolution_was_set_WHEN_sensor_is_instanced_again_THEN_it_is_read_from_the_devices)
+{
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(second_rom, 22.0f);
+    {
+        Transport_sensor sensor(bus);
+        sensor.set_resolution(10);
+
+        // The EEPROM write holds the bus high, then it is released
+        UNSIGNED_LONGS_EQUAL(2, delay_count);
+        UNSIGNED_LONGS_EQUAL(DS18X20_COPY_SCRATCHPAD_MS, delays_ms[0]);
+        CHECK_FALSE(bus.is_strong_pullup_enabled());
+    }
+
+    Transport_sensor sensor(bus);
+
+    UNSIGNED_LONGS_EQUAL(10, sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(188, sensor.get_millis_to_wait_for_conversion(sensor.get_resolution()));
+}
+
+TEST(Transport_backend, WHEN_invalid_resolution_is_set_THEN_set_resolution_has_no_effect)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_sensor sensor(bus);
+
+    sensor.set_resolution(8);
+    sensor.set_resolution(13);
+
+    UNSIGNED_LONGS_EQUAL(12, sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(0, delay_count);
+}
+
+TEST(Transport_backend, GIVEN_a_device_was_added_WHEN_rescan_devices_THEN_it_is_counted)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_sensor sensor(bus);
+
+    bus.add_device(second_rom, 22.0f, true);
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.get_device_count());
+    sensor.rescan_devices();
+    UNSIGNED_LONGS_EQUAL(2, sensor.get_device_count());
+    CHECK_TRUE(sensor.is_parasite_powered());
+}
+
+TEST(Transport_backend, GIVEN_a_device_was_added_WHEN_temperatures_are_read_by_channel_THEN_only_the_devices_found_are_read)
+{
+    bus.add_device(TEST_CHANNELS_ROMS[TEST_CHANNELS_OUTDOOR], 21.5f);
+    Transport_sensor sensor(bus);
+    sensor.set_rom_channel_map(&TEST_CHANNELS);
+    bus.add_device(TEST_CHANNELS_ROMS[TEST_CHANNELS_ZONE3], 22.0f);
+    float temperatures[4] = {-99.0f, -99.0f, -99.0f, -99.0f};
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.read_temperatures_by_channel(temperatures, 4));
+
+    DOUBLES_EQUAL(-99.0f, temperatures[TEST_CHANNELS_ZONE3], 0.0001f);
+    sensor.rescan_devices();
+    sensor.request_temperatures();
+    UNSIGNED_LONGS_EQUAL(2, sensor.read_temperatures_by_channel(temperatures, 4));
+    DOUBLES_EQUAL(22.0f, temperatures[TEST_CHANNELS_ZONE3], 0.0001f);
+}
+
+TEST(Transport_backend, GIVEN_a_DS18S20_on_the_bus_WHEN_get_millis_to_wait_for_conversion_THEN_its_fixed_750_ms_is_waited_at_any_resolution)
+{
+    Device_address ds18s20_rom;
+    make_backend_rom(DS18S20_FAMILY_ID, 0x01, ds18s20_rom);
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(ds18s20_rom, 22.0f);
+
+    Transport_sensor sensor(bus);
+
+    UNSIGNED_LONGS_EQUAL(750, sensor.get_millis_to_wait_for_conversion(9));
+}
+
+TEST(Transport_backend, GIVEN_devices_of_mixed_resolutions_WHEN_get_millis_to_wait_for_conversion_THEN_each_converts_at_its_own)
+{
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(second_rom, 22.0f);
+    const uint8_t CONFIGS[2] = {0x1F, 0x3F};
+    for (uint8_t i = 0; i < 2; ++i) {
+        uint8_t* scratchpad = bus.get_scratchpad(i);
+        scratchpad[DS18X20_SCRATCHPAD_CONFIG] = CONFIGS[i];
+        scratchpad[DS18X20_SCRATCHPAD_CRC] = one_wire_crc8(scratchpad, DS18X20_SCRATCHPAD_CRC);
+    }
+
+    Transport_sensor sensor(bus);
+
+    UNSIGNED_LONGS_EQUAL(10, sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(188, sensor.get_millis_to_wait_for_conversion(12));
+    UNSIGNED_LONGS_EQUAL(94, sensor.get_millis_to_wait_for_conversion(9));
+}
+
+TEST(Transport_backend, GIVEN_one_device_is_parasite_powered_WHEN_temperatures_of_a_group_are_requested_THEN_only_the_others_convert)
+{
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(second_rom, 22.0f, true);
+    Transport_sensor sensor(bus);
+
+    CHECK_TRUE(sensor.is_parasite_powered());
+    CHECK_TRUE(sensor.request_temperatures_of(&first_rom, 1));
+    CHECK_FALSE(sensor.request_temperatures_of(&second_rom, 1));
+    CHECK_FALSE(bus.is_strong_pullup_enabled());
+}
+
+TEST(Transport_backend, GIVEN_alarm_thresholds_WHEN_resolution_is_set_THEN_they_are_kept)
+{
+    bus.add_device(first_rom, 21.5f);
+    uint8_t* scratchpad = bus.get_scratchpad(0);
+    scratchpad[DS18X20_SCRATCHPAD_TH] = 0x4B;
+    scratchpad[DS18X20_SCRATCHPAD_TL] = 0x46;
+    scratchpad[DS18X20_SCRATCHPAD_CRC] = one_wire_crc8(scratchpad, DS18X20_SCRATCHPAD_CRC);
+    Transport_sensor sensor(bus);
+
+    CHECK_TRUE(sensor.set_resolution(9));
+
+    UNSIGNED_LONGS_EQUAL(0x4B, scratchpad[DS18X20_SCRATCHPAD_TH]);
+    UNSIGNED_LONGS_EQUAL(0x46, scratchpad[DS18X20_SCRATCHPAD_TL]);
+    UNSIGNED_LONGS_EQUAL(0x1F, scratchpad[DS18X20_SCRATCHPAD_CONFIG]);
+    UNSIGNED_LONGS_EQUAL(94, sensor.get_millis_to_wait_for_conversion(12));
+}
+
+TEST(Transport_backend, GIVEN_externally_powered_bus_WHEN_request_temperatures_THEN_the_conversion_is_polled)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_sensor sensor(bus);
+
+    sensor.request_temperatures();
+
+    CHECK_FALSE(bus.is_strong_pullup_enabled());
+    CHECK_TRUE(sensor.is_sample_available());
+    DOUBLES_EQUAL(21.5f, sensor.get_temperature_in_celsius(first_rom), 0.000001f);
+}
+
+TEST(Transport_backend, GIVEN_parasite_powered_bus_WHEN_conversion_time_is_over_THEN_strong_pullup_is_released_and_sample_is_available)
+{
+    bus.add_device(first_rom, 21.5f, true);
+    Transport_sensor sensor(bus);
+    backend_clock_us = 1000;
+
+    sensor.request_temperatures();
+    CHECK_TRUE(bus.is_strong_pullup_enabled());
+
+    backend_clock_us += 750000 - 1;
+    CHECK_FALSE(sensor.is_sample_available());
+    CHECK_TRUE(bus.is_strong_pullup_enabled());
+
+    backend_clock_us += 1;
+    CHECK_TRUE(sensor.is_sample_available());
+    CHECK_FALSE(bus.is_strong_pullup_enabled());
+}
+
+TEST(Transport_backend, GIVEN_parasite_powered_bus_WHEN_request_temperature_BLOCKING_THEN_strong_pullup_lasts_the_conversion_time_of_the_resolution)
+{
+    bus.add_device(first_rom, 21.5f, true);
+    Transport_sensor sensor(bus);
+    sensor.set_resolution(9);
+    delay_count = 0;
+
+    sensor.request_temperature_BLOCKING();
+
+    UNSIGNED_LONGS_EQUAL(1, delay_count);
+    UNSIGNED_LONGS_EQUAL(94, delays_ms[0]);
+    CHECK_FALSE(bus.is_strong_pullup_enabled());
+    CHECK_TRUE(sensor.is_sample_available());
+}
+
+TEST(Transport_backend, GIVEN_retry_policy_WHEN_reads_fail_THEN_device_is_read_again_with_bounded_backoff_and_slow_timing_on_last_attempt)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_sensor sensor(bus);
+    sensor.request_temperature_BLOCKING();
+    Read_retry_policy policy = {3, 10, 15, true};
+    sensor.set_read_retry_policy(policy);
+    bus.scratchpad_reads_to_corrupt = 2;
+    bus.scratchpad_reads = 0;
+    delay_count = 0;
+
+    float temperature = 0;
+    CHECK_TRUE(sensor.read_temperature_in_celsius(first_rom, &temperature));
+
+    DOUBLES_EQUAL(21.5f, temperature, 0.000001f);
+    UNSIGNED_LONGS_EQUAL(2, bus.crc_failures);
+    UNSIGNED_LONGS_EQUAL(2, delay_count);
+    UNSIGNED_LONGS_EQUAL(10, delays_ms[0]);
+    UNSIGNED_LONGS_EQUAL(15, delays_ms[1]);
+    UNSIGNED_LONGS_EQUAL(3, bus.scratchpad_reads);
+    UNSIGNED_LONGS_EQUAL(1, bus.recoveries_used_us[1]);
+    UNSIGNED_LONGS_EQUAL(30, bus.recoveries_used_us[2]);
+    UNSIGNED_LONGS_EQUAL(1, bus.timing.recovery_us);
+}
+
+TEST(Transport_backend, GIVEN_retry_policy_WHEN_every_attempt_fails_THEN_read_temperature_in_celsius_returns_false)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_sensor sensor(bus);
+    Transport_reading_listener_spy listener;
+    sensor.set_reading_listener(&listener);
+    Read_retry_policy policy = {2, 0, 0, false};
+    sensor.set_read_retry_policy(policy);
+    bus.scratchpad_reads_to_corrupt = 2;
+
+    float temperature = 0;
+    CHECK_FALSE(sensor.read_temperature_in_celsius(first_rom, &temperature));
+
+    UNSIGNED_LONGS_EQUAL(2, bus.crc_failures);
+    UNSIGNED_LONGS_EQUAL(0, listener.readings_received);
+    DOUBLES_EQUAL(TEMPERATURE_NOT_AVAILABLE_IN_CELSIUS, sensor.get_temperature_in_celsius(second_rom), 0.000001f);
+}
+
+TEST(Transport_backend, GIVEN_temperatures_were_requested_WHEN_a_device_is_read_THEN_request_to_data_latency_is_reported)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_sensor sensor(bus);
+    Transport_latency_listener_spy listener;
+    sensor.set_read_latency_listener(&listener);
+    backend_clock_us = 1000;
+    sensor.request_temperatures();
+
+    backend_clock_us = 751000;
+    sensor.get_temperature_in_celsius(first_rom);
+
+    UNSIGNED_LONGS_EQUAL(750000, listener.last_request_to_data_us);
+}
+
+TEST(Transport_backend, WHEN_devices_of_a_family_are_scanned_THEN_other_families_are_not_found)
+{
+    Device_address ds2408_rom;
+    make_backend_rom(0x29, 0x01, ds2408_rom);
+    bus.add_device(first_rom, 21.5f);
+    bus.add_device(ds2408_rom, 0.0f);
+    Transport_sensor sensor(bus);
+
+    Device_address found[2];
+    UNSIGNED_LONGS_EQUAL(1, sensor.scan_devices_of_family(0x29, found, 2));
+    MEMCMP_EQUAL(ds2408_rom, found[0], sizeof(Device_address));
+}
+
+TEST(Transport_backend, GIVEN_stored_snapshot_and_devices_present_WHEN_sensor_is_instanced_THEN_bus_is_not_searched)
+{
+    bus.add_device(first_rom, 21.5f);
+    Transport_snapshot_store store;
+    store.has_snapshot = true;
+    store.snapshot.resolution = 10;
+    store.snapshot.device_count = 2;
+    memcpy(store.snapshot.addresses[0], first_rom, sizeof(Device_address));
+    memcpy(store.snapshot.addresses[1], second_rom, sizeof(Device_address));
+
+    Transport_sensor sensor(bus, &store);
+
+    CHECK_TRUE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(10, sensor.get_resolution());
+    Device_address address;
+    sensor.get_device_address_on_index(address, 1);
+    MEMCMP_EQUAL(second_rom, address, sizeof(Device_address));
+    UNSIGNED_LONGS_EQUAL(0, store.saves);
+
+    CHECK_TRUE(sensor.complete_deferred_search());
+    CHECK_FALSE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(1, store.saves);
+    UNSIGNED_LONGS_EQUAL(1, store.snapshot.device_count);
+    CHECK_FALSE(sensor.complete_deferred_search());
+}
+
+TEST(Transport_backend, GIVEN_stored_snapshot_and_no_presence_WHEN_sensor_is_instanced_THEN_snapshot_of_the_search_is_saved)
+{
+    Transport_snapshot_store store;
+    store.has_snapshot = true;
+    store.snapshot.device_count = 1;
+    memcpy(store.snapshot.addresses[0], first_rom, sizeof(Device_address));
+
+    Transport_sensor sensor(bus, &store);
+
+    CHECK_FALSE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(1, store.saves);
+    UNSIGNED_LONGS_EQUAL(0, store.snapshot.device_count);
+}
+
+TEST(Transport_backend, GIVEN_known_bus_and_devices_present_WHEN_sensor_is_instanced_THEN_bus_is_never_searched)
+{
+    static constexpr Device_address KNOWN_ROMS[] = {
+        {0x28, 0xFF, 0x4C, 0x6B, 0x71, 0x16, 0x05, 0xB9},
+        {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2},
+    };
+    static constexpr Known_bus KNOWN_BUS(KNOWN_ROMS, 11, false);
+    bus.add_device(first_rom, 21.5f);
+
+    Transport_sensor sensor(bus, KNOWN_BUS);
+
+    CHECK_FALSE(sensor.is_search_deferred());
+    UNSIGNED_LONGS_EQUAL(11, sensor.get_resolution());
+    UNSIGNED_LONGS_EQUAL(2, sensor.get_device_count());
+    Device_address address;
+    sensor.get_device_address_on_index(address, 1);
+    MEMCMP_EQUAL(KNOWN_ROMS[1], address, sizeof(Device_address));
+}
+
+TEST(Transport_backend, GIVEN_known_bus_with_a_wrong_rom_code_WHEN_sensor_is_instanced_THEN_bus_is_searched)
+{
+    static Device_address known_roms[2];
+    memcpy(known_roms[0], first_rom, sizeof(Device_address));
+    memcpy(known_roms[1], first_rom, sizeof(Device_address));
+    known_roms[1][7] ^= 0x01;
+    bus.add_device(first_rom, 21.5f);
+
+    Transport_sensor sensor(bus, Known_bus(known_roms, 11, false));
+
+    UNSIGNED_LONGS_EQUAL(1, sensor.get_device_count());
+    UNSIGNED_LONGS_EQUAL(12, sensor.get_resolution());
+}
@@ -0,0 +1,136 @@
+#include "CppUTest/TestHarness.h"
+#include "../../implementation/common/Uart_transport.h"
+#include <string.h>
+
+// Echoes every byte written, as a UART with TX and RX tied to an idle bus.
+// A device can answer a reset and pull down the read slots of the bits it sends.
+class Loopback_uart_port : public Uart_port {
+public:
+    uint32_t baud_rate = 0;
+    bool is_device_present = true;
+    bool is_echo_lost = false;
+    uint8_t bits_to_send[128];
+    uint8_t bits_to_send_count = 0;
+    uint8_t bits_sent_count = 0;
+    uint8_t slots_written[64];
+    uint8_t slots_written_count = 0;
+
+    void set_baud_rate(uint32_t new_baud_rate) override {
+        baud_rate = new_baud_rate;
+    }
+
+    bool transfer(const uint8_t* to_write, uint8_t* echo, size_t length) override {
+        if (is_echo_lost)
+            return false;
+        for (size_t i = 0; i < length; ++i) {
+            echo[i] = to_write[i];
+            if (baud_rate == UART_TRANSPORT_RESET_BAUD_RATE && is_device_present)
+                echo[i] &= 0xE0;
+            else if (baud_rate == UART_TRANSPORT_DATA_BAUD_RATE && to_write[i] == UART_TRANSPORT_BIT_1 && bits_sent_count < bits_to_send_count) {
+                if (!bits_to_send[bits_sent_count++])
+                    echo[i] = 0xFC;
+            }
+            else if (baud_rate == UART_TRANSPORT_DATA_BAUD_RATE && slots_written_count < sizeof(slots_written))
+                slots_written[slots_written_count++] = to_write[i];
+        }
+        return true;
+    }
+
+    void send_byte(uint8_t byte) {
+        for (uint8_t i = 0; i < 8; ++i)
+            bits_to_send[bits_to_send_count++] = (byte >> i) & 0x01;
+    }
+};
+
+TEST_GROUP(Uart_transport)
+{
+    Loopback_uart_port port;
+    Uart_transport* transport;
+
+    void setup()
+    {
+        transport = new Uart_transport(port);
+    }
+    void teardown()
+    {
+        delete transport;
+    }
+};
+
+TEST(Uart_transport, WHEN_byte_is_encoded_THEN_each_bit_is_a_slot_lsb_first)
+{
+    uint8_t slots[UART_TRANSPORT_SLOTS_PER_BYTE];
+
+    get_uart_slots_FROM_byte(0x44, slots);
+
+    const uint8_t EXPECTED_SLOTS[UART_TRANSPORT_SLOTS_PER_BYTE] = {0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00};
+    CHECK_EQUAL(0, memcmp(EXPECTED_SLOTS, slots, sizeof(slots)));
+    CHECK_EQUAL(0x44, get_byte_FROM_uart_slots(slots));
+}
+
+TEST(Uart_transport, GIVEN_device_is_present_WHEN_reset_THEN_presence_is_detected_and_data_baud_rate_is_restored)
+{
+    CHECK_TRUE(transport->reset());
+    UNSIGNED_LONGS_EQUAL(UART_TRANSPORT_DATA_BAUD_RATE, port.baud_rate);
+}
+
+TEST(Uart_transport, GIVEN_no_device_WHEN_reset_THEN_presence_is_not_detected)
+{
+    port.is_device_present = false;
+
+    CHECK_FALSE(transport->reset());
+}
+
+TEST(Uart_transport, GIVEN_echo_is_lost_WHEN_reset_THEN_presence_is_not_detected)
+{
+    port.is_echo_lost = true;
+
+    CHECK_FALSE(transport->reset());
+}
+
+TEST(Uart_transport, WHEN_bytes_are_written_THEN_their_slots_reach_the_bus)
+{
+    const uint8_t CONVERT_T[] = {0xCC, 0x44};
+    transport->reset();
+
+    CHECK_TRUE(transport->write_bytes(CONVERT_T, sizeof(CONVERT_T)));
+
+    CHECK_EQUAL(16, port.slots_written_count);
+    CHECK_EQUAL(0xCC, get_byte_FROM_uart_slots(&port.slots_written[0]));
+    CHECK_EQUAL(0x44, get_byte_FROM_uart_slots(&port.slots_written[8]));
+}
+
+TEST(Uart_transport, WHEN_scratchpad_is_read_THEN_bytes_are_decoded_from_the_echo)
+{
+    const uint8_t SCRATCHPAD[9] = {0x88, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x08, 0x10, 0x5A};
+    for (uint8_t i = 0; i < sizeof(SCRATCHPAD); ++i)
+        port.send_byte(SCRATCHPAD[i]);
+    transport->reset();
+
+    uint8_t scratchpad[9];
+    CHECK_TRUE(transport->read_bytes(scratchpad, sizeof(scratchpad)));
+
+    CHECK_EQUAL(0, memcmp(SCRATCHPAD, scratchpad, sizeof(SCRATCHPAD)));
+}
+
+TEST(Uart_transport, WHEN_bits_are_read_THEN_a_pulled_down_slot_is_a_zero)
+{
+    port.bits_to_send[0] = 0;
+    port.bits_to_send[1] = 1;
+    port.bits_to_send_count = 2;
+    transport->reset();
+
+    bool bit;
+    CHECK_TRUE(transport->read_bit(&bit));
+    CHECK_FALSE(bit);
+    CHECK_TRUE(transport->read_bit(&bit));
+    CHECK_TRUE(bit);
+}
+
+TEST(Uart_transport, WHEN_a_device_pulls_down_a_written_one_THEN_write_fails)
+{
+    port.send_byte(0x00);
+    transport->reset();
+
+    CHECK_FALSE(transport->write_bit(true));
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Generates a header with a Rom_channel_map: a minimal perfect hash from the ROM
+codes of an installation to their logical channels, kept in flash.
+
+The input has one device per line, its ROM code as printed by the sensor (16 hex
+digits, family code first, separators allowed) and the name of its channel:
+
+    28FF4C6B711605B9  boiler_in
+    28-FF-1A-22-71-16-04-9D  zone3
+
+Blank lines and lines starting with # are ignored. Channels are numbered in the
+order of the file. Every ROM code must pass its CRC8 and appear once.
+
+    generate_rom_channel_map.py rom_channels.txt rom_channels.h [--name ROM_CHANNELS] [--include PATH]
+
+The hash is hash and displace: a ROM goes to a bucket by rom_channel_hash(rom, 0),
+and every bucket has the seed that sends its ROMs to free slots with
+rom_channel_hash(rom, seed). Must match implementation/common/Rom_channel_map.h.
+"""
+
+import argparse
+import re
+import sys
+
+MAX_SEED = 0xFFFF
+MAX_CHANNELS = 0xFFFE
+ROMS_PER_BUCKET = 2
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        for _ in range(8):
+            mix = (crc ^ byte) & 0x01
+            crc >>= 1
+            if mix:
+                crc ^= 0x8C
+            byte >>= 1
+    return crc
+
+
+def rom_channel_hash(rom, seed):
+    hash = 2166136261 ^ seed
+    for byte in rom[:7]:
+        hash = ((hash ^ byte) * 16777619) & 0xFFFFFFFF
+    hash = ((hash ^ (hash >> 16)) * 0x85EBCA6B) & 0xFFFFFFFF
+    hash = ((hash ^ (hash >> 13)) * 0xC2B2AE35) & 0xFFFFFFFF
+    return hash ^ (hash >> 16)
+
+
+def parse(path):
+    roms = []
+    names = []
+    with open(path) as lines:
+        for line_number, line in enumerate(lines, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            fields = line.split(None, 1)
+            digits = re.sub(r'[^0-9A-Fa-f]', '', fields[0])
+            if len(digits) != 16 or len(fields) != 2:
+                sys.exit('%s:%d: expected a ROM code of 16 hex digits and a channel name' % (path, line_number))
+            rom = bytes.fromhex(digits)
+            if crc8(rom[:7]) != rom[7]:
+                sys.exit('%s:%d: wrong CRC8 in ROM code %s' % (path, line_number, digits))
+            if rom in roms:
+                sys.exit('%s:%d: ROM code %s repeated' % (path, line_number, digits))
+            name = fields[1].strip()
+            if not re.match(r'^[A-Za-z_][A-Za-z0-9_]*$', name) or name in names:
+                sys.exit('%s:%d: channel name %s is not a unique identifier' % (path, line_number, name))
+            roms.append(rom)
+            names.append(name)
+    if not roms or len(roms) > MAX_CHANNELS:
+        sys.exit('%s: expected 1 to %d devices' % (path, MAX_CHANNELS))
+    return roms, names
+
+
+def find_seeds(roms):
+    channel_count = len(roms)
+    bucket_count = (channel_count + ROMS_PER_BUCKET - 1) // ROMS_PER_BUCKET
+    buckets = [[] for _ in range(bucket_count)]
+    for channel, rom in enumerate(roms):
+        buckets[rom_channel_hash(rom, 0) % bucket_count].append(channel)
+
+    seeds = [1]*bucket_count
+    slot_channels = [None]*channel_count
+    for bucket in sorted(range(bucket_count), key=lambda bucket: -len(buckets[bucket])):
+        if not buckets[bucket]:
+            break
+        for seed in range(1, MAX_SEED + 1):
+            slots = [rom_channel_hash(roms[channel], seed) % channel_count for channel in buckets[bucket]]
+            if len(set(slots)) == len(slots) and all(slot_channels[slot] is None for slot in slots):
+                break
+        else:
+            sys.exit('no seed found for bucket %d, try again with other ROMS_PER_BUCKET' % bucket)
+        seeds[bucket] = seed
+        for slot, channel in zip(slots, buckets[bucket]):
+            slot_channels[slot] = channel
+    return seeds, slot_channels
+
+
+def write_header(path, name, include, roms, names, seeds, slot_channels):
+    def rows(values, per_row):
+        return ',\n'.join('    ' + ', '.join(values[i:i + per_row]) for i in range(0, len(values), per_row))
+
+    with open(path, 'w') as header:
+        header.write('#pragma once\n')
+        header.write('// Generated by tools/generate_rom_channel_map.py, do not edit\n')
+        header.write('#include "%s"\n\n' % include)
+        for channel, channel_name in enumerate(names):
+            header.write('#define %s_%s %d\n' % (name, channel_name.upper(), channel))
+        header.write('\nstatic constexpr Device_address %s_ROMS[] = {\n' % name)
+        header.write(',\n'.join('    {%s}' % ', '.join('0x%02X' % byte for byte in rom) for rom in roms))
+        header.write('\n};\n\nstatic constexpr const char* %s_NAMES[] = {\n' % name)
+        header.write(rows(['"%s"' % channel_name for channel_name in names], 4))
+        header.write('\n};\n\nstatic constexpr uint16_t %s_SEEDS[] = {\n' % name)
+        header.write(rows(['%d' % seed for seed in seeds], 12))
+        header.write('\n};\n\nstatic constexpr uint16_t %s_SLOT_CHANNELS[] = {\n' % name)
+        header.write(rows(['%d' % channel for channel in slot_channels], 12))
+        header.write('\n};\n\nstatic constexpr Rom_channel_map %s = {\n' % name)
+        header.write('    %s_ROMS, %s_NAMES, %d, %s_SEEDS, %d, %s_SLOT_CHANNELS\n};\n'
+                     % (name, name, len(roms), name, len(seeds), name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generates the ROM to channel map of an installation')
+    parser.add_argument('input')
+    parser.add_argument('output')
+    parser.add_argument('--name', default='ROM_CHANNELS', help='prefix of the generated names')
+    parser.add_argument('--include', default='implementation/common/Rom_channel_map.h',
+                        help='path of Rom_channel_map.h as the generated header includes it')
+    arguments = parser.parse_args()
+
+    roms, names = parse(arguments.input)
+    seeds, slot_channels = find_seeds(roms)
+    write_header(arguments.output, arguments.name, arguments.include, roms, names, seeds, slot_channels)
+
+
+if __name__ == '__main__':
+    main()